@@ -0,0 +1,225 @@
+#!/usr/bin/env python
+"""
+  function: run the LIGGGHTS granular benchmarks, record per-section
+            timings into JSON and compare them against a stored baseline
+  usage: bench_granular.py [options] [case ...]
+
+  examples:
+    bench_granular.py --lmp ../../src/lmp_auto --out results.json
+    bench_granular.py --np 4 --mpirun "mpirun -np" --out results.4.json
+    bench_granular.py --np 4 --scaled 2x2 --out results.scaled.4.json
+    bench_granular.py --out new.json --baseline results.json --tol 0.1
+"""
+import sys
+import os
+import re
+import json
+import time
+import shlex
+import subprocess
+from argparse import ArgumentParser
+
+#====================================================
+### constants
+#====================================================
+cases = ["hertz","cohesion","rolling","mesh","multisphere","stream","heat","cfd"]
+serial_only = ["cfd"]
+
+version_pattern = re.compile(r"^LIGGGHTS \((.*)\)")
+loop_pattern    = re.compile(r"^Loop time of (\S+) on (\d+) procs.* for (\d+) steps with (\d+) atoms")
+section_pattern = re.compile(r"^(\w+)\s+time \(%\) = (\S+) \((\S+)\)")
+
+bench_dir = os.path.dirname(os.path.abspath(__file__))
+
+#====================================================
+### parse a log file, only the last run is used
+#====================================================
+def parse_log(log):
+  result = {"version" : None, "loop_time" : None, "sections" : {}}
+  for line in open(log):
+    m = version_pattern.match(line)
+    if m and not result["version"]:
+      result["version"] = m.group(1)
+      continue
+    m = loop_pattern.match(line)
+    if m:
+      result["loop_time"] = float(m.group(1))
+      result["procs"] = int(m.group(2))
+      result["steps"] = int(m.group(3))
+      result["atoms"] = int(m.group(4))
+      result["sections"] = {}
+      continue
+    m = section_pattern.match(line)
+    if m and result["loop_time"] is not None:
+      result["sections"][m.group(1)] = float(m.group(2))
+  if result["loop_time"] and result["steps"]:
+    result["atom_steps_per_second"] = result["atoms"]*result["steps"]/result["loop_time"]
+  return result
+
+#====================================================
+### parse a modify_timing file (kind id hook/style tmin tavg tmax)
+#====================================================
+def parse_timing(file):
+  timing = {}
+  if not os.path.isfile(file): return timing
+  for line in open(file):
+    if line.startswith("#"): continue
+    words = line.split()
+    if len(words) != 6: continue
+    kind,id,what = words[0:3]
+    if kind == "fix_hook": key = "fix:%s:%s" % (id,what)
+    else: key = "%s:%s" % (kind,id)
+    timing[key] = {"min" : float(words[3]), "avg" : float(words[4]), "max" : float(words[5])}
+  return timing
+
+#====================================================
+### run a single benchmark case
+#====================================================
+def run_case(case,args):
+  tag = "%s.%s.%d" % (case,"scaled" if args.scaled else "fixed",args.np)
+  log = "log."+tag
+  timing = "timing."+tag
+  for f in (log,timing):
+    if os.path.isfile(f): os.remove(f)
+
+  cmd = []
+  if args.np > 1 or args.mpirun != "mpirun -np":
+    cmd += shlex.split(args.mpirun)+[str(args.np)]
+  cmd += [args.lmp,"-in","in."+case,"-log",log,"-echo","none","-screen","none"]
+  cmd += ["-var","x",str(args.px),"-var","y",str(args.py)]
+  cmd += ["-var","nsettle",str(args.settle),"-var","nsteps",str(args.steps)]
+  cmd += ["-var","timingfile",timing]
+
+  standin = None
+  if case == "cfd":
+    couplingdir = "couple."+tag
+    if os.path.isdir(couplingdir):
+      for f in os.listdir(couplingdir): os.remove(os.path.join(couplingdir,f))
+    else:
+      os.mkdir(couplingdir)
+    cmd += ["-var","couplingdir",couplingdir]
+    standin = subprocess.Popen([sys.executable,os.path.join(bench_dir,"cfd_standin.py"),couplingdir])
+
+  start = time.time()
+  status = subprocess.call(cmd)
+  wall = time.time()-start
+  if standin:
+    standin.terminate()
+    standin.wait()
+
+  if status != 0 or not os.path.isfile(log):
+    print("!!! case %s FAILED (exit status %d), see %s" % (case,status,log))
+    return None
+
+  result = parse_log(log)
+  if result["loop_time"] is None:
+    print("!!! case %s FAILED, no loop time in %s" % (case,log))
+    return None
+  result["wall_time"] = wall
+  result["modify"] = parse_timing(timing)
+  print("%-12s %10.4g s loop  %12.4g atom-steps/s" % (case,result["loop_time"],result["atom_steps_per_second"]))
+  return result
+
+#====================================================
+### compare against baseline
+#====================================================
+def compare(current,baseline,attempted,tol,min_time):
+  regressions = []
+  for case in sorted(baseline["cases"]):
+    if case not in attempted: continue
+    if case not in current["cases"]:
+      # a case that ran in the baseline but failed now is a regression
+      print("%-12s %-32s %10s -> %10s  REGRESSION" % (case,"loop","ok","FAILED"))
+      regressions.append((case,"loop",float("inf")))
+      continue
+    b = baseline["cases"][case]
+    c = current["cases"][case]
+    entries = [("loop",b["loop_time"],c["loop_time"])]
+    for name in sorted(b["sections"]):
+      if name in c["sections"]:
+        entries.append((name,b["sections"][name],c["sections"][name]))
+    for key in sorted(b["modify"]):
+      if key in c["modify"]:
+        entries.append((key,b["modify"][key]["avg"],c["modify"][key]["avg"]))
+    for name,tb,tc in entries:
+      if tb < min_time and tc < min_time: continue
+      change = (tc-tb)/tb if tb > 0. else float("inf")
+      flag = ""
+      if change > tol:
+        flag = "  REGRESSION"
+        regressions.append((case,name,change))
+      print("%-12s %-32s %10.4g -> %10.4g  %+7.1f%%%s" % (case,name,tb,tc,100.*change,flag))
+  return regressions
+
+#====================================================
+### main
+#====================================================
+def main():
+  parser = ArgumentParser(description="run the LIGGGHTS granular benchmarks")
+  parser.add_argument("cases",nargs="*",default=cases,help="cases to run (default: all)")
+  parser.add_argument("--lmp",default=os.environ.get("LIGGGHTS_BINARY","lmp_auto"),help="LIGGGHTS executable")
+  parser.add_argument("--np",type=int,default=1,help="number of MPI processes")
+  parser.add_argument("--mpirun",default="mpirun -np",help="MPI launcher, the process count is appended")
+  parser.add_argument("--scaled",default=None,help="scaled-size run on a PXxPY grid of unit cells, e.g. 2x2")
+  parser.add_argument("--steps",type=int,default=2000,help="steps of the measured run")
+  parser.add_argument("--settle",type=int,default=4000,help="steps of the settling run")
+  parser.add_argument("--out",default="results.json",help="JSON file the results are written to")
+  parser.add_argument("--baseline",default=None,help="JSON file of a previous run to compare against")
+  parser.add_argument("--tol",type=float,default=0.1,help="relative slowdown reported as regression")
+  parser.add_argument("--min-time",type=float,default=0.05,help="times below this (s) are not compared")
+  args = parser.parse_args()
+
+  for case in args.cases:
+    if case not in cases: parser.error("unknown case %s" % case)
+
+  args.px = args.py = 1
+  if args.scaled:
+    try: args.px,args.py = [int(v) for v in args.scaled.lower().split("x")]
+    except ValueError: parser.error("--scaled expects PXxPY, e.g. 2x2")
+
+  # paths given relative to the calling directory
+
+  if os.sep in args.lmp: args.lmp = os.path.abspath(args.lmp)
+  args.out = os.path.abspath(args.out)
+  if args.baseline: args.baseline = os.path.abspath(args.baseline)
+  os.chdir(bench_dir)
+
+  current = {"date" : time.asctime(), "np" : args.np,
+             "mode" : "scaled" if args.scaled else "fixed",
+             "grid" : [args.px,args.py], "steps" : args.steps, "cases" : {}}
+
+  attempted = []
+  failed = []
+  for case in args.cases:
+    if case in serial_only and (args.np > 1 or args.scaled):
+      print("skipping case %s, it is serial only" % case)
+      continue
+    attempted.append(case)
+    result = run_case(case,args)
+    if result:
+      current["version"] = result.pop("version")
+      current["cases"][case] = result
+    else:
+      failed.append(case)
+
+  f = open(args.out,"w")
+  json.dump(current,f,indent=2,sort_keys=True)
+  f.close()
+  print("results written to %s" % args.out)
+
+  if args.baseline:
+    baseline = json.load(open(args.baseline))
+    if baseline.get("np") != current["np"] or baseline.get("grid") != current["grid"]:
+      print("WARNING: baseline was run with a different process count or grid")
+    regressions = compare(current,baseline,attempted,args.tol,args.min_time)
+    if regressions:
+      print("!!! %d timings regressed by more than %g%%" % (len(regressions),100.*args.tol))
+      sys.exit(1)
+    print("no regressions")
+
+  if failed:
+    print("!!! %d cases FAILED: %s" % (len(failed)," ".join(failed)))
+    sys.exit(1)
+
+if __name__ == "__main__":
+  main()
@@ -0,0 +1,57 @@
+#!/usr/bin/env python
+"""
+  function: file-based stand-in for the CFD side of fix couple/cfd,
+            used by the in.cfd granular benchmark
+  usage: cfd_standin.py <couplingdir> [fz]
+
+  LIGGGHTS writes the pushed properties (x, v, radius, volumeweight) to
+  <dir>/<name>0 and renames them to <dir>/<name>1 once written; before
+  every exchange but the first it waits for <dir>/<name>0 to exist.
+  It reads the drag force from <dir>/dragforce0 and renames it to
+  <dir>/dragforce1 afterwards.
+  This stand-in keeps one exchange ahead: it writes a constant drag force
+  (0,0,fz) per particle to dragforce0 and creates the push tokens as soon
+  as the previous drag force was consumed, so LIGGGHTS never has to wait.
+"""
+import sys
+import os
+import time
+
+push_names = ["x","v","radius","volumeweight"]
+poll = 0.0005
+
+def write_atomic(path,text):
+  tmp = path+".tmp"
+  f = open(tmp,"w")
+  f.write(text)
+  f.close()
+  os.rename(tmp,path)
+
+def main():
+  if len(sys.argv) < 2:
+    print(__doc__)
+    sys.exit(1)
+  dir = sys.argv[1]
+  fz = 1.e-4
+  if len(sys.argv) > 2: fz = float(sys.argv[2])
+
+  # wait for the particle count, written by in.cfd before the coupled run
+
+  natoms = os.path.join(dir,"natoms")
+  while not os.path.isfile(natoms): time.sleep(poll)
+  time.sleep(0.1)
+  n = int(float(open(natoms).read().split()[0]))
+
+  drag = "# stand-in drag force\n%d\n" % n + ("0 0 %g\n" % fz)*n
+  dragfile = os.path.join(dir,"dragforce0")
+  write_atomic(dragfile,drag)
+
+  while True:
+    if not os.path.isfile(dragfile):
+      for name in push_names:
+        write_atomic(os.path.join(dir,name+"0"),"")
+      write_atomic(dragfile,drag)
+    time.sleep(poll)
+
+if __name__ == "__main__":
+  main()
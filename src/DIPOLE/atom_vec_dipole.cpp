@@ -15,6 +15,7 @@
 #include <stdlib.h>
 #include "atom_vec_dipole.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "comm.h"
 #include "domain.h"
 #include "modify.h"
@@ -71,6 +72,7 @@ void AtomVecDipole::grow(int n)
   q = memory->grow(atom->q,nmax,"atom:q");
   mu = memory->grow(atom->mu,nmax,4,"atom:mu");
 
+  atom->arena->grow(nmax);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -111,6 +113,7 @@ void AtomVecDipole::copy(int i, int j, int delflag)
   mu[j][2] = mu[i][2];
   mu[j][3] = mu[i][3];
 
+  atom->arena->copy(i,j);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->copy_arrays(i,j,delflag);
@@ -603,6 +606,7 @@ int AtomVecDipole::pack_exchange(int i, double *buf)
   buf[m++] = mu[i][2];
   buf[m++] = mu[i][3];
 
+  m += atom->arena->pack_exchange(i,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->pack_exchange(i,&buf[m]);
@@ -636,6 +640,7 @@ int AtomVecDipole::unpack_exchange(double *buf)
   mu[nlocal][2] = buf[m++];
   mu[nlocal][3] = buf[m++];
 
+  m += atom->arena->unpack_exchange(nlocal,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->
@@ -14,6 +14,7 @@
 #include <stdlib.h>
 #include "atom_vec_angle.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "comm.h"
 #include "domain.h"
 #include "modify.h"
@@ -88,6 +89,7 @@ void AtomVecAngle::grow(int n)
   angle_atom3 = memory->grow(atom->angle_atom3,nmax,atom->angle_per_atom,
                              "atom:angle_atom3");
 
+  atom->arena->grow(nmax);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -151,6 +153,7 @@ void AtomVecAngle::copy(int i, int j, int delflag)
   nspecial[j][2] = nspecial[i][2];
   for (k = 0; k < nspecial[j][2]; k++) special[j][k] = special[i][k];
 
+  atom->arena->copy(i,j);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->copy_arrays(i,j,delflag);
@@ -570,6 +573,7 @@ int AtomVecAngle::pack_exchange(int i, double *buf)
   buf[m++] = ubuf(nspecial[i][2]).d;
   for (k = 0; k < nspecial[i][2]; k++) buf[m++] = ubuf(special[i][k]).d;
 
+  m += atom->arena->pack_exchange(i,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->pack_exchange(i,&buf[m]);
@@ -621,6 +625,7 @@ int AtomVecAngle::unpack_exchange(double *buf)
   for (k = 0; k < nspecial[nlocal][2]; k++)
     special[nlocal][k] = (int) ubuf(buf[m++]).i;
 
+  m += atom->arena->unpack_exchange(nlocal,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->
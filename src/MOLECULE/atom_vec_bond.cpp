@@ -14,6 +14,7 @@
 #include <stdlib.h>
 #include "atom_vec_bond.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "comm.h"
 #include "domain.h"
 #include "modify.h"
@@ -78,6 +79,7 @@ void AtomVecBond::grow(int n)
   bond_atom = memory->grow(atom->bond_atom,nmax,atom->bond_per_atom,
                            "atom:bond_atom");
 
+  atom->arena->grow(nmax);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -130,6 +132,7 @@ void AtomVecBond::copy(int i, int j, int delflag)
   nspecial[j][2] = nspecial[i][2];
   for (k = 0; k < nspecial[j][2]; k++) special[j][k] = special[i][k];
 
+  atom->arena->copy(i,j);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->copy_arrays(i,j,delflag);
@@ -541,6 +544,7 @@ int AtomVecBond::pack_exchange(int i, double *buf)
   buf[m++] = ubuf(nspecial[i][2]).d;
   for (k = 0; k < nspecial[i][2]; k++) buf[m++] = ubuf(special[i][k]).d;
 
+  m += atom->arena->pack_exchange(i,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->pack_exchange(i,&buf[m]);
@@ -584,6 +588,7 @@ int AtomVecBond::unpack_exchange(double *buf)
   for (k = 0; k < nspecial[nlocal][2]; k++)
     special[nlocal][k] = (int) ubuf(buf[m++]).i;
 
+  m += atom->arena->unpack_exchange(nlocal,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->
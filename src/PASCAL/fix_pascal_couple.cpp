@@ -215,6 +215,9 @@ void FixParScaleCouple::init()
     if(0 == atom->map_style)
       error->fix_error(FLERR,this,"requires an 'atom_modify map' command to allocate an atom map");
 
+    // the map array is handed to ParScale, so keep map_init() from switching to a hash
+    atom->map_require_array();
+
     //TODO
 //    error->all(FLERR,"TODO: add more properties here to be pushed/pulled");
 //    error->all(FLERR,"TODO: separate framework and model; put this in derived class");
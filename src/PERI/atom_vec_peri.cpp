@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include "atom_vec_peri.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "comm.h"
 #include "domain.h"
 #include "modify.h"
@@ -91,6 +92,7 @@ void AtomVecPeri::grow(int n)
   s0 = memory->grow(atom->s0,nmax,"atom:s0");
   x0 = memory->grow(atom->x0,nmax,3,"atom:x0");
 
+  atom->arena->grow(nmax);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -133,6 +135,7 @@ void AtomVecPeri::copy(int i, int j, int delflag)
   x0[j][1] = x0[i][1];
   x0[j][2] = x0[i][2];
 
+  atom->arena->copy(i,j);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->copy_arrays(i,j,delflag);
@@ -609,6 +612,7 @@ int AtomVecPeri::pack_exchange(int i, double *buf)
   buf[m++] = x0[i][1];
   buf[m++] = x0[i][2];
 
+  m += atom->arena->pack_exchange(i,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->pack_exchange(i,&buf[m]);
@@ -643,6 +647,7 @@ int AtomVecPeri::unpack_exchange(double *buf)
   x0[nlocal][1] = buf[m++];
   x0[nlocal][2] = buf[m++];
 
+  m += atom->arena->unpack_exchange(nlocal,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->
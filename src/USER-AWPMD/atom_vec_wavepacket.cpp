@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include "atom_vec_wavepacket.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "comm.h"
 #include "domain.h"
 #include "modify.h"
@@ -88,6 +89,7 @@ void AtomVecWavepacket::grow(int n)
   ervelforce = memory->grow(atom->ervelforce,nmax,"atom:ervelforce");
   etag = memory->grow(atom->etag,nmax,"atom:etag");
 
+  atom->arena->grow(nmax);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -140,6 +142,7 @@ void AtomVecWavepacket::copy(int i, int j, int delflag)
   etag[j] = etag[i];
 
 
+  atom->arena->copy(i,j);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->copy_arrays(i,j,delflag);
@@ -715,6 +718,7 @@ int AtomVecWavepacket::pack_exchange(int i, double *buf)
   buf[m++] = cs[2*i];
   buf[m++] = cs[2*i+1];
 
+  m += atom->arena->pack_exchange(i,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->pack_exchange(i,&buf[m]);
@@ -751,6 +755,7 @@ int AtomVecWavepacket::unpack_exchange(double *buf)
   cs[2*nlocal] = buf[m++];
   cs[2*nlocal+1] = buf[m++];
 
+  m += atom->arena->unpack_exchange(nlocal,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->
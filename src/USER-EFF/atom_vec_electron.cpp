@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include "atom_vec_electron.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "comm.h"
 #include "domain.h"
 #include "modify.h"
@@ -95,6 +96,7 @@ void AtomVecElectron::grow(int n)
   ervel = memory->grow(atom->ervel,nmax,"atom:ervel");
   erforce = memory->grow(atom->erforce,nmax*comm->nthreads,"atom:erforce");
 
+  atom->arena->grow(nmax);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -135,6 +137,7 @@ void AtomVecElectron::copy(int i, int j, int delflag)
   eradius[j] = eradius[i];
   ervel[j] = ervel[i];
 
+  atom->arena->copy(i,j);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->copy_arrays(i,j,delflag);
@@ -617,6 +620,7 @@ int AtomVecElectron::pack_exchange(int i, double *buf)
   buf[m++] = eradius[i];
   buf[m++] = ervel[i];
 
+  m += atom->arena->pack_exchange(i,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->pack_exchange(i,&buf[m]);
@@ -648,6 +652,7 @@ int AtomVecElectron::unpack_exchange(double *buf)
   eradius[nlocal] = buf[m++];
   ervel[nlocal] = buf[m++];
 
+  m += atom->arena->unpack_exchange(nlocal,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->
@@ -29,6 +29,7 @@
 
 #include "atom_vec_sphere_omp.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "comm.h"
 #include "modify.h"
 #include "fix.h"
@@ -86,6 +87,7 @@ void AtomVecSphereOMP::grow(int n)
   rmass = memory->grow(atom->rmass,nmax,"atom:rmass");
   omega = memory->grow(atom->omega,nmax,3,"atom:omega");
 
+  atom->arena->grow(nmax);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -39,6 +39,7 @@
 #include "force.h"
 #include "pair_gran.h"
 #include "fix_rigid.h"
+#include "fix_sleep.h"
 #include "fix_mesh.h"
 #include "fix_contact_history.h"
 #include "modify.h"
@@ -101,12 +102,23 @@ void FixWallGranOMP::setup(int vflag)
     }
     else
     {
-      ((Respa *) update->integrate)->copy_flevel_f(nlevels_respa_-1);
-      post_force_respa(vflag,nlevels_respa_-1,0);
-      ((Respa *) update->integrate)->copy_f_flevel(nlevels_respa_-1);
+      ((Respa *) update->integrate)->copy_flevel_f(ilevel_respa_);
+      post_force_respa(vflag,ilevel_respa_,0);
+      ((Respa *) update->integrate)->copy_f_flevel(ilevel_respa_);
+    }
+
+    //NP setup is not followed by final_integrate of the mesh
+    if(stress_flag_)
+    {
+      for(int i = 0; i < n_FixMesh_; i++)
+        if(FixMesh_list_[i]->trackStress())
+          static_cast<FixMeshSurfaceStress*>(FixMesh_list_[i])->reduce_thread_contributions();
     }
 
     init_heattransfer();
+
+    if(heattransfer_flag_ && strstr(update->integrate_style,"respa") && ilevel_respa_ < nlevels_respa_-1)
+      error->fix_error(FLERR,this,"heat transfer requires the outermost rRESPA level");
 }
 
 /* ----------------------------------------------------------------------
@@ -115,7 +127,7 @@ void FixWallGranOMP::setup(int vflag)
 
 void FixWallGranOMP::pre_neighbor()
 {
-    rebuildPrimitiveNeighlist_ = (primitiveWalls_.size() > 0);
+    FixWallGran::pre_neighbor();
 }
 
 void FixWallGranOMP::pre_force(int vflag)
@@ -188,6 +200,14 @@ void FixWallGranOMP::post_force_wall(int vflag)
     }
   }
 
+  // start new evaluation, contacts not detected in it expire
+  if(meshwall_ == 1) {
+    for(int iMesh = 0; iMesh < n_FixMesh_; iMesh++) {
+      FixContactHistoryMesh *fix_contact = FixMesh_list_[iMesh]->contactHistory();
+      if(fix_contact) fix_contact->nextGeneration();
+    }
+  }
+
   #pragma omp parallel
   {
     if(meshwall_ == 1) {
@@ -227,26 +247,8 @@ void FixWallGranOMP::post_force_mesh(int vflag)
     cdata.computeflag = computeflag_;
     cdata.shearupdate = shearupdate_;
 
-    for(int iMesh = 0; iMesh < n_FixMesh_; iMesh++)
-    {
-      FixContactHistoryMesh *fix_contact = FixMesh_list_[iMesh]->contactHistory();
-      // mark all contacts for deletion at this point
-      if(fix_contact) {
-        FixNeighlistMeshOMP * meshNeighlist = static_cast<FixNeighlistMeshOMP*>(FixMesh_list_[iMesh]->meshNeighlist());
-        fix_contact->resetDeletionPage(tid);
-
-        int* b = meshNeighlist->partition_begin(tid);
-        int* e = meshNeighlist->partition_end(tid);
-
-        // mark all contacts for deletion at this point
-        for(int* it = b; it != e; ++it) {
-          assert(meshNeighlist->in_thread_partition(tid, *it));
-          fix_contact->markForDeletion(tid, *it);
-        }
-      }
-      // TODO if(store_force_contact_)
-      // TODO  fix_wallforce_contact_ = FixMesh_list_[iMesh]->meshforceContact();
-    }
+    // TODO if(store_force_contact_)
+    // TODO  fix_wallforce_contact_ = FixMesh_list_[iMesh]->meshforceContact();
 
     for(int iMesh = 0; iMesh < n_FixMesh_; iMesh++)
     {
@@ -275,6 +277,10 @@ void FixWallGranOMP::post_force_mesh(int vflag)
       {
         double ***vMesh = vMeshC->begin();
 
+        //NP rigid frame: contact is resolved in the frame of the mesh nodes
+        const bool rigidFrame = mesh->rigidFrame();
+        double xFrame[3];
+
         // loop owned and ghost triangles
         for(int iTri = 0; iTri < nTriAll; iTri++)
         {
@@ -292,7 +298,14 @@ void FixWallGranOMP::post_force_mesh(int vflag)
 
             int idTri = mesh->id(iTri);
 
-            deltan = mesh->resolveTriSphereContactBary(iPart,iTri,radius_ ? radius_[iPart]:r0_ ,x_[iPart],delta,bary);
+            double *xPart = x_[iPart];
+            if(rigidFrame)
+            {
+              mesh->pointToFrame(x_[iPart],xFrame);
+              xPart = xFrame;
+            }
+
+            deltan = mesh->resolveTriSphereContactBary(iPart,iTri,radius_ ? radius_[iPart]:r0_ ,xPart,delta,bary);
 
             if(deltan > skinDistance_) //allow force calculation away from the wall
             {
@@ -301,8 +314,16 @@ void FixWallGranOMP::post_force_mesh(int vflag)
             {
               if(fix_contact && ! fix_contact->handleContact(iPart,idTri,cdata.contact_history)) continue;
 
-              for(int i = 0; i < 3; i++)
-                v_wall[i] = (bary[0]*vMesh[iTri][0][i] + bary[1]*vMesh[iTri][1][i] + bary[2]*vMesh[iTri][2][i]);
+              if(rigidFrame)
+              {
+                mesh->vectorFromFrame(delta);
+                mesh->frameVelocity(iTri,bary,v_wall);
+              }
+              else
+              {
+                for(int i = 0; i < 3; i++)
+                  v_wall[i] = (bary[0]*vMesh[iTri][0][i] + bary[1]*vMesh[iTri][1][i] + bary[2]*vMesh[iTri][2][i]);
+              }
 
               cdata.i = iPart;
               cdata.deltan = -deltan;
@@ -354,21 +375,7 @@ void FixWallGranOMP::post_force_mesh(int vflag)
       }
     }
 
-  // clean-up contacts
-  for(int iMesh = 0; iMesh < n_FixMesh_; iMesh++)
-  {
-    FixContactHistoryMesh *fix_contact = FixMesh_list_[iMesh]->contactHistory();
-      // clean-up contacts
-      if(fix_contact) {
-        FixNeighlistMeshOMP * meshNeighlist = static_cast<FixNeighlistMeshOMP*>(FixMesh_list_[iMesh]->meshNeighlist());
-        int * b = meshNeighlist->partition_begin(tid);
-        int * e = meshNeighlist->partition_end(tid);
-
-        for(int * it = b; it != e; ++it) {
-          fix_contact->cleanUpContact(*it);
-        }
-      }
-  }
+  //NP contacts not detected this time-step expire with the next evaluation
 }
 
 /* ----------------------------------------------------------------------
@@ -456,6 +463,8 @@ inline void FixWallGranOMP::post_force_eval_contact(CollisionData & cdata, doubl
   cdata.meff = rmass_ ? rmass_[iPart] : atom->mass[atom->type[iPart]];
   cdata.area_ratio = 1.;
 
+  if(fix_sleep_ && vectorMag3DSquared(v_wall) > 0.)
+    fix_sleep_->wake(iPart);
 
   ForceData i_forces;
   ForceData j_forces;
@@ -498,7 +507,7 @@ inline void FixWallGranOMP::post_force_eval_contact(CollisionData & cdata, doubl
         delta[0] = -cdata.delta[0];
         delta[1] = -cdata.delta[1];
         delta[2] = -cdata.delta[2];
-        #pragma omp critical
+        //NP no critical section needed, threads accumulate in own buffers
         static_cast<FixMeshSurfaceStress*>(fix_mesh)->add_particle_contribution
         (
            iPart,i_forces.delta_F,delta,iTri,v_wall
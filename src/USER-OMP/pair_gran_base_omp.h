@@ -35,6 +35,7 @@
 #include "suffix.h"
 #include "atom.h"
 #include "fix_contact_property_atom.h"
+#include "fix_sleep.h"
 
 #include <omp.h>
 #include <pthread.h>
@@ -104,6 +105,7 @@ public:
     settings.registerOnOff("patchup", use_patchup_list);
     cmodel.registerSettings(settings);
     bool success = settings.parseArguments(nargs, args);
+    if(success) cmodel.postSettings();
 
     if(!success) {
       error->all(FLERR,settings.error_message.c_str());
@@ -289,6 +291,15 @@ public:
         pg->vflag_fdotr = 0;
       }
     }
+    if(pg->has_contact_consumers()) {
+      // evaluate contacts recorded per thread, in thread order
+      for(int tid = 0; tid < nthreads; ++tid) {
+        std::vector<ContactUpdate> & contactUpdates = fix->get_thr(tid)->patchupContactUpdates;
+        for(std::vector<ContactUpdate>::iterator it = contactUpdates.begin(); it != contactUpdates.end(); ++it)
+          pg->contact_consumers_eval(it->cdata, it->i_forces, it->j_forces);
+        contactUpdates.clear();
+      }
+    }
 #ifdef PAIR_OMP_TIMING
     time_patchup += MPI_Wtime() - startTime;
 #endif
@@ -336,6 +347,8 @@ public:
     const int dnum = pg->dnum();
     const bool store_contact_forces = pg->storeContactForces();
     const int freeze_group_bit = pg->freeze_group_bit();
+    const bool contact_consumers = pg->has_contact_consumers();
+    const double * const sleep = pg->sleep_state();
 
     const int tid = thr->get_tid();
     std::vector<ForceUpdate> * updateList = use_patchup_list ?  &thr->patchupForceUpdates : NULL;
@@ -383,6 +396,36 @@ public:
         // use patchup list instead of duplicated work in conflict case
         if(j <= i && use_patchup_list) continue; 
 
+        // both asleep: no force and no history update, keep touch flag and
+        // contact history, but contact consumers (e.g. heat conduction) still
+        // see the contact
+        if (sleep && sleep[i] == FixSleep::SLEEP_ASLEEP && sleep[j] == FixSleep::SLEEP_ASLEEP) {
+          if (contact_consumers && cdata.computeflag) {
+            const double delx = xtmp - x[j][0];
+            const double dely = ytmp - x[j][1];
+            const double delz = ztmp - x[j][2];
+            const double rsq = delx * delx + dely * dely + delz * delz;
+            const double radsum = radi + radius[j];
+            if (rsq < radsum * radsum) {
+              cdata.j = j;
+              cdata.delta[0] = delx;
+              cdata.delta[1] = dely;
+              cdata.delta[2] = delz;
+              cdata.rsq = rsq;
+              cdata.radj = radius[j];
+              cdata.radsum = radsum;
+              cdata.itype = type[i];
+              cdata.jtype = type[j];
+              cdata.touch = touch ? &touch[jj] : NULL;
+              cdata.contact_history = allshear ? &allshear[dnum*jj] : NULL;
+              i_forces.reset();
+              j_forces.reset();
+              thr->patchupContactUpdates.push_back(ContactUpdate(cdata, i_forces, j_forces));
+            }
+          }
+          continue;
+        }
+
         const double delx = xtmp - x[j][0];
         const double dely = ytmp - x[j][1];
         const double delz = ztmp - x[j][2];
@@ -459,6 +502,10 @@ public:
 
           // if there is a collision, there will always be a force
           cdata.has_force_update = true;
+
+          // consumers are not thread safe, record the contact and evaluate after the loop
+          if (contact_consumers && cdata.computeflag)
+            thr->patchupContactUpdates.push_back(ContactUpdate(cdata, i_forces, j_forces));
         } else {
           // apply force update only if selected contact models have requested it
           cdata.has_force_update = false;
@@ -91,6 +91,7 @@ class ThrData {
   // patchup support
   std::vector<ForceUpdate> patchupForceUpdates;
   std::vector<VatomUpdate>   patchupVatomUpdates;
+  std::vector<ContactUpdate> patchupContactUpdates;
 
   void reset_patchup();
 
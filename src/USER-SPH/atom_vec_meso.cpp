@@ -14,6 +14,7 @@
 #include <stdlib.h>
 #include "atom_vec_meso.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "comm.h"
 #include "domain.h"
 #include "modify.h"
@@ -78,6 +79,7 @@ void AtomVecMeso::grow(int n) {
   vest = memory->grow(atom->vest, nmax, 3, "atom:vest");
   cv = memory->grow(atom->cv, nmax, "atom:cv");
 
+  atom->arena->grow(nmax);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -127,6 +129,7 @@ void AtomVecMeso::copy(int i, int j, int delflag) {
   vest[j][1] = vest[i][1];
   vest[j][2] = vest[i][2];
 
+  atom->arena->copy(i,j);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->copy_arrays(i, j,delflag);
@@ -654,6 +657,7 @@ int AtomVecMeso::pack_exchange(int i, double *buf) {
   buf[m++] = vest[i][1];
   buf[m++] = vest[i][2];
 
+  m += atom->arena->pack_exchange(i,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->pack_exchange(i, &buf[m]);
@@ -688,6 +692,7 @@ int AtomVecMeso::unpack_exchange(double *buf) {
   vest[nlocal][1] = buf[m++];
   vest[nlocal][2] = buf[m++];
 
+  m += atom->arena->unpack_exchange(nlocal,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]-> unpack_exchange(nlocal,
@@ -86,6 +86,12 @@ namespace LAMMPS_NS
         // neigh list stuff for moving mesh
         virtual bool decideRebuild() = 0;
 
+        // rigid frame mode for rigidly moving meshes
+        virtual void setRigidFrame(bool _rigidFrame) = 0;
+        virtual bool rigidFrame() = 0;
+        virtual void setFrameVelocity(const double *vel, const double *omega, const double *origin) = 0;
+        virtual void materialize() = 0;
+
         //NP ***************************************
         //NP interface to MultiNodeMeshParallel
         //NP ***************************************
@@ -32,6 +32,7 @@
 #include "style_partitioner.h"
 #include "atom_vec.h"
 #include "atom_vec_ellipsoid.h"
+#include "per_atom_arena.h"
 #include "comm.h"
 #include "neighbor.h"
 #include "force.h"
@@ -62,6 +63,9 @@ using namespace std;
 #define EPSILON 1.0e-6
 #define CUDA_CHUNK 3000
 #define MAXBODY 20       // max # of lines in one body, also in ReadData class
+#define CURVEBITS 21     // bits per dimension of space-filling curve keys
+
+enum{SORT_BIN,SORT_MORTON,SORT_HILBERT};
 
 /* ---------------------------------------------------------------------- */
 
@@ -79,6 +83,7 @@ Atom::Atom(LAMMPS *lmp) : Pointers(lmp)
   sortfreq = 1000;
   nextsort = 0;
   userbinsize = 0.0;
+  sortorder = SORT_BIN;
   maxbin = maxnext = 0;
   binhead = NULL;
   next = permute = NULL;
@@ -183,18 +188,23 @@ Atom::Atom(LAMMPS *lmp) : Pointers(lmp)
 
   tag_enable = 1;
   map_style = 0;
+  map_user = 0;
   map_tag_max = 0;
   map_nhash = 0;
+  map_nused = 0;
+  map_hmask = 0;
+  map_hshift = 0;
 
   smax = 0;
   sametag = NULL;
   map_array = NULL;
-  map_bucket = NULL;
   map_hash = NULL;
 
   atom_style = NULL;
   avec = NULL;
 
+  arena = new PerAtomArena(lmp);
+
   datamask = ALL_MASK;
   datamask_ext = ALL_MASK;
 
@@ -214,6 +224,7 @@ Atom::~Atom()
   delete partitioner;
   delete [] atom_style;
   delete avec;
+  delete arena;
 
   delete [] firstgroupname;
   memory->destroy(binhead);
@@ -342,6 +353,7 @@ Atom::~Atom()
 void Atom::settings(Atom *old)
 {
   map_style = old->map_style;
+  map_user = old->map_user;
 }
 
 /* ----------------------------------------------------------------------
@@ -566,9 +578,13 @@ void Atom::modify_params(int narg, char **arg)
   while (iarg < narg) {
     if (strcmp(arg[iarg],"map") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal atom_modify command");
-      if (strcmp(arg[iarg+1],"array") == 0) map_style = 1;
-      else if (strcmp(arg[iarg+1],"hash") == 0) map_style = 2;
-      else error->all(FLERR,"Illegal atom_modify command");
+      if (strcmp(arg[iarg+1],"array") == 0) map_style = map_user = 1;
+      else if (strcmp(arg[iarg+1],"hash") == 0) {
+        map_style = 2;
+        map_user = 1;
+      } else if (strcmp(arg[iarg+1],"auto") == 0) {
+        map_user = 0;
+      } else error->all(FLERR,"Illegal atom_modify command");
       if (domain->box_exist)
         error->all(FLERR,
                    "Atom_modify map command after simulation box is defined");
@@ -595,6 +611,19 @@ void Atom::modify_params(int narg, char **arg)
         error->all(FLERR,"Atom_modify sort and first options "
                    "cannot be used together");
       iarg += 3;
+    } else if (strcmp(arg[iarg],"sort_order") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal atom_modify command");
+      if (strcmp(arg[iarg+1],"bin") == 0) sortorder = SORT_BIN;
+      else if (strcmp(arg[iarg+1],"morton") == 0) sortorder = SORT_MORTON;
+      else if (strcmp(arg[iarg+1],"hilbert") == 0) sortorder = SORT_HILBERT;
+      else error->all(FLERR,"Illegal atom_modify command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"hugepages") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal atom_modify command");
+      if (strcmp(arg[iarg+1],"yes") == 0) arena->set_hugepages(true);
+      else if (strcmp(arg[iarg+1],"no") == 0) arena->set_hugepages(false);
+      else error->all(FLERR,"Illegal atom_modify command");
+      iarg += 2;
     } else error->all(FLERR,"Illegal atom_modify command");
   }
 }
@@ -1400,7 +1429,7 @@ void Atom::spatial_sort(){
   // re-setup sort bins if needed
 
   if (domain->box_change) setup_sort_bins();
-  if (nbins == 1) return;
+  if (sortorder == SORT_BIN && nbins == 1) return;
 
   // reallocate per-atom vectors if needed
 
@@ -1416,34 +1445,38 @@ void Atom::spatial_sort(){
 
   if (nlocal == nmax) avec->grow(0);
 
-  // bin atoms in reverse order so linked list will be in forward order
-
-  for (i = 0; i < nbins; i++) binhead[i] = -1;
-
-  for (i = nlocal-1; i >= 0; i--) {
-    ix = static_cast<int> ((x[i][0]-bboxlo[0])*bininvx);
-    iy = static_cast<int> ((x[i][1]-bboxlo[1])*bininvy);
-    iz = static_cast<int> ((x[i][2]-bboxlo[2])*bininvz);
-    ix = MAX(ix,0);
-    iy = MAX(iy,0);
-    iz = MAX(iz,0);
-    ix = MIN(ix,nbinx-1);
-    iy = MIN(iy,nbiny-1);
-    iz = MIN(iz,nbinz-1);
-    ibin = iz*nbiny*nbinx + iy*nbinx + ix;
-    next[i] = binhead[ibin];
-    binhead[ibin] = i;
-  }
-
   // permute = desired permutation of atoms
   // permute[I] = J means Ith new atom will be Jth old atom
 
-  n = 0;
-  for (m = 0; m < nbins; m++) {
-    i = binhead[m];
-    while (i >= 0) {
-      permute[n++] = i;
-      i = next[i];
+  if (sortorder != SORT_BIN) fill_permute_by_curve();
+  else {
+
+    // bin atoms in reverse order so linked list will be in forward order
+
+    for (i = 0; i < nbins; i++) binhead[i] = -1;
+
+    for (i = nlocal-1; i >= 0; i--) {
+      ix = static_cast<int> ((x[i][0]-bboxlo[0])*bininvx);
+      iy = static_cast<int> ((x[i][1]-bboxlo[1])*bininvy);
+      iz = static_cast<int> ((x[i][2]-bboxlo[2])*bininvz);
+      ix = MAX(ix,0);
+      iy = MAX(iy,0);
+      iz = MAX(iz,0);
+      ix = MIN(ix,nbinx-1);
+      iy = MIN(iy,nbiny-1);
+      iz = MIN(iz,nbinz-1);
+      ibin = iz*nbiny*nbinx + iy*nbinx + ix;
+      next[i] = binhead[ibin];
+      binhead[ibin] = i;
+    }
+
+    n = 0;
+    for (m = 0; m < nbins; m++) {
+      i = binhead[m];
+      while (i >= 0) {
+        permute[n++] = i;
+        i = next[i];
+      }
     }
   }
 
@@ -1476,7 +1509,9 @@ void Atom::spatial_sort(){
   // copy before inner-loop moves an atom to end of atom list
   // copy after inner-loop moves atom at end of list back into list
   // empty = location in atom list that is currently empty
+  // per-atom fields in the arena are re-ordered column by column afterwards
 
+  arena->freeze();
   for (i = 0; i < nlocal; i++) {
     if (current[i] == permute[i]) continue;
     avec->copy(i,nlocal,0);
@@ -1488,6 +1523,8 @@ void Atom::spatial_sort(){
     avec->copy(nlocal,empty,0);
     current[empty] = permute[empty];
   }
+  arena->thaw();
+  arena->permute(permute,nlocal);
 
   // set thread assignment
   if(atom->thread) {
@@ -1511,6 +1548,87 @@ void Atom::spatial_sort(){
 }
 
 
+/* ----------------------------------------------------------------------
+   key of integer coords X[0..ndim-1] with CURVEBITS bits each on a
+   Morton (bit interleaving) or Hilbert curve
+   Hilbert transform as in J. Skilling, AIP Conf. Proc. 707, 381 (2004)
+------------------------------------------------------------------------- */
+
+static uint64_t curve_key(unsigned int *X, int ndim, int hilbert)
+{
+  if (hilbert) {
+    const unsigned int M = 1u << (CURVEBITS-1);
+    unsigned int P,Q,t;
+
+    // inverse undo
+
+    for (Q = M; Q > 1; Q >>= 1) {
+      P = Q - 1;
+      for (int i = 0; i < ndim; i++) {
+        if (X[i] & Q) X[0] ^= P;
+        else {
+          t = (X[0] ^ X[i]) & P;
+          X[0] ^= t;
+          X[i] ^= t;
+        }
+      }
+    }
+
+    // Gray encode
+
+    for (int i = 1; i < ndim; i++) X[i] ^= X[i-1];
+    t = 0;
+    for (Q = M; Q > 1; Q >>= 1)
+      if (X[ndim-1] & Q) t ^= Q - 1;
+    for (int i = 0; i < ndim; i++) X[i] ^= t;
+  }
+
+  // interleave bits, most significant first
+
+  uint64_t key = 0;
+  for (int b = CURVEBITS-1; b >= 0; b--)
+    for (int i = 0; i < ndim; i++)
+      key = (key << 1) | ((X[i] >> b) & 1u);
+  return key;
+}
+
+/* ----------------------------------------------------------------------
+   order local atoms along a space-filling curve through my sub-domain
+   resolution is far below the sort bin size, so the curve orders atoms
+   both within and across bins
+------------------------------------------------------------------------- */
+
+void Atom::fill_permute_by_curve()
+{
+  const int ndim = domain->dimension;
+  const int hilbert = (sortorder == SORT_HILBERT);
+  const double ncell = static_cast<double>(1u << CURVEBITS);
+  const unsigned int cellmax = (1u << CURVEBITS) - 1;
+
+  double scale[3];
+  for (int k = 0; k < 3; k++) scale[k] = ncell/(bboxhi[k]-bboxlo[k]);
+
+  sortkey.resize(nlocal);
+
+  for (int i = 0; i < nlocal; i++) {
+    unsigned int X[3];
+    for (int k = 0; k < ndim; k++) {
+      double c = (x[i][k]-bboxlo[k])*scale[k];
+      c = MAX(c,0.0);
+      c = MIN(c,static_cast<double>(cellmax));
+      X[k] = static_cast<unsigned int>(c);
+    }
+    sortkey[i].first = curve_key(X,ndim,hilbert);
+    sortkey[i].second = i;
+  }
+
+  // ties keep the current order
+
+  std::sort(sortkey.begin(),sortkey.end());
+
+  for (int i = 0; i < nlocal; i++) permute[i] = sortkey[i].second;
+}
+
 void Atom::fill_permute_by_spatial_sorted_bins(std::vector<int> & ilist, int * target_permute)
 {
 
@@ -1630,7 +1748,9 @@ void Atom::partitioner_sort() {
   // copy before inner-loop moves an atom to end of atom list
   // copy after inner-loop moves atom at end of list back into list
   // empty = location in atom list that is currently empty
+  // per-atom fields in the arena are re-ordered column by column afterwards
 
+  arena->freeze();
   for (int i = 0; i < nlocal; i++) {
     if (current[i] == permute[i]) continue;
     avec->copy(i,nlocal,0);
@@ -1642,6 +1762,8 @@ void Atom::partitioner_sort() {
     avec->copy(nlocal,empty,0);
     current[empty] = permute[empty];
   }
+  arena->thaw();
+  arena->permute(permute,nlocal);
 
   deltaTime = MPI_Wtime() - startTime;
 #ifdef LIGGGHTS_DEBUG
@@ -2022,10 +2144,8 @@ bigint Atom::memory_usage()
   bytes += smax*sizeof(int);
   if (map_style == 1)
     bytes += memory->usage(map_array,map_tag_max+1);
-  else if (map_style == 2) {
-    bytes += map_nbucket*sizeof(int);
-    bytes += map_nhash*sizeof(HashElem);
-  }
+  else if (map_style == 2)
+    bytes += (map_hmask+1)*sizeof(HashElem);
   if (maxnext) {
     bytes += memory->usage(next,maxnext);
     bytes += memory->usage(permute,maxnext);
@@ -146,6 +146,10 @@ class Atom : protected Pointers {
   int nextra_border_max;
   int nextra_store;
 
+  // per-atom fields of fixes grown, copied and exchanged in bulk
+
+  class PerAtomArena *arena;
+
   int map_style;                  // default or user-specified style of map
                                   // 0 = none, 1 = array, 2 = hash
   int map_tag_max;                // max atom ID that map() is setup for
@@ -217,7 +221,7 @@ class Atom : protected Pointers {
       return extract(_id,a);
   }
 
-  inline int* get_map_array() {return map_array;}
+  int* get_map_array();                // error unless map style is array
   inline int get_map_size() {return map_tag_max+1;}
 
   bigint memory_usage();
@@ -238,7 +242,8 @@ class Atom : protected Pointers {
   void map_set();
   void map_one(int, int);
   void map_delete();
-  int map_find_hash(int);
+  void map_require_array();
+  inline int map_find_hash(int);
 
   void fill_permute_by_spatial_sorted_bins(std::vector<int> & ilist, int * target_permute);
 
@@ -249,18 +254,27 @@ class Atom : protected Pointers {
   int *map_array;       // direct map of length map_tag_max + 1
   int smax;             // max size of sametag
 
+  int map_user;                   // 1 if map style set by atom_modify
+                                  // else chosen by tag density in map_init()
+
+  // open addressing hash table with Robin Hood linear probing
+  // an entry is never further from its home slot than the entries it
+  // passes, so lookups of absent keys stop early
+
   struct HashElem {
-    int global;                   // key to search on = global ID
+    int global;                   // key to search on = global ID, 0 if empty
     int local;                    // value associated with key = local index
-    int next;                     // next entry in this bucket, -1 if last
   };
   int map_nhash;                  // # of entries hash table can hold
   int map_nused;                  // # of actual entries in hash table
-  int map_free;                   // ptr to 1st unused entry in hash table
-  int map_nbucket;                // # of hash buckets
-  int *map_bucket;                // ptr to 1st entry in each bucket
+  int map_hmask;                  // # of slots - 1, # of slots is power of 2
+  int map_hshift;                 // 32 - log2(# of slots)
   HashElem *map_hash;             // hash table
 
+  inline int map_home(int global)
+  { return static_cast<int>((static_cast<unsigned int>(global)*2654435761u) >> map_hshift); }
+  void map_insert_hash(int, int);
+
   // spatial sorting of atoms
 
   int nbins;                      // # of sorting bins
@@ -271,6 +285,8 @@ class Atom : protected Pointers {
   int *next;                      // next atom in bin
   int *permute;                   // permutation vector
   double userbinsize;             // requested sort bin size
+  int sortorder;                  // bins or space-filling curve
+  std::vector<std::pair<uint64_t,int> > sortkey; // curve key, atom index
   double bininvx,bininvy,bininvz; // inverse actual bin sizes
   double bboxlo[3],bboxhi[3];     // bounding box of my sub-domain
 
@@ -291,10 +307,26 @@ class Atom : protected Pointers {
   void setup_sort_bins();
   void spatial_sort();
   void partitioner_sort();
-
-  int next_prime(int);
+  void fill_permute_by_curve();
 };
 
+/* ----------------------------------------------------------------------
+   lookup global ID in hash table, return local index
+   called by map()
+------------------------------------------------------------------------- */
+
+inline int Atom::map_find_hash(int global)
+{
+  int index = map_home(global);
+  for (int dist = 0; ; dist++) {
+    const int key = map_hash[index].global;
+    if (key == 0) return -1;
+    if (key == global) return map_hash[index].local;
+    if (((index - map_home(key)) & map_hmask) < dist) return -1;
+    index = (index+1) & map_hmask;
+  }
+}
+
 }
 
 #endif
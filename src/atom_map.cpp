@@ -12,6 +12,7 @@
 ------------------------------------------------------------------------- */
 
 #include <math.h>
+#include <string.h>
 #include "atom.h"
 #include "comm.h"
 #include "memory.h"
@@ -20,17 +21,20 @@
 using namespace LAMMPS_NS;
 
 #define EXTRA 1000
+#define MAPARRAY_MIN 1000000  // array map is always used below this # of tags
+#define DENSITY 16            // use hash if tags sparser than this
 
 /* ----------------------------------------------------------------------
    allocate and initialize array or hash table for global -> local map
    set map_tag_max = largest atom ID (may be larger than natoms)
+   unless set by atom_modify map, use the array if tags are dense enough
    for array option:
      array length = 1 to largest tag of any atom
      set entire array to -1 as initial values
    for hash option:
-     map_nhash = length of hash table
-     map_nbucket = # of hash buckets, prime larger than map_nhash
-       so buckets will only be filled with 0 or 1 atoms on average
+     map_nhash = max # of entries
+     # of slots = power of 2 at least twice map_nhash
+       so probe sequences stay short
 ------------------------------------------------------------------------- */
 
 void Atom::map_init()
@@ -48,86 +52,60 @@ void Atom::map_init()
   smax = nlocal + nghost + EXTRA;
   memory->create(sametag,smax,"atom:sametag");
 
-  if (map_style == 1) {
-    memory->create(map_array,map_tag_max+1,"atom:map_array");
-    for (int i = 0; i <= map_tag_max; i++) map_array[i] = -1;
+  // map_nhash = max # of atoms that can be hashed on this proc
+  // set to max of ave atoms/proc or atoms I can store
+  // multiply by 2, require at least 1000
+  // doubling means hash table will be re-init only rarely
 
-  } else {
-
-    // map_nhash = max # of atoms that can be hashed on this proc
-    // set to max of ave atoms/proc or atoms I can store
-    // multiply by 2, require at least 1000
-    // doubling means hash table will be re-init only rarely
+  int nper = static_cast<int> (natoms/comm->nprocs);
+  map_nhash = MAX(nper,nmax);
+  map_nhash *= 2;
+  map_nhash = MAX(map_nhash,1000);
 
-    int nper = static_cast<int> (natoms/comm->nprocs);
-    map_nhash = MAX(nper,nmax);
-    map_nhash *= 2;
-    map_nhash = MAX(map_nhash,1000);
+  //NP array costs map_tag_max ints on every proc, hash 4 ints per entry
+  //NP switch to hash if tags are sparse, e.g. after many deletions and
+  //NP insertions, or if the system is spread over many procs
 
-    // map_nbucket = prime just larger than map_nhash
+  if (!map_user)
+    map_style = (map_tag_max >= MAPARRAY_MIN && map_tag_max > DENSITY*map_nhash) ? 2 : 1;
 
-    map_nbucket = next_prime(map_nhash);
+  if (map_style == 1) {
+    memory->create(map_array,map_tag_max+1,"atom:map_array");
+    for (int i = 0; i <= map_tag_max; i++) map_array[i] = -1;
 
-    // set all buckets to empty
-    // set hash to map_nhash in length
-    // put all hash entries in free list and point them to each other
+  } else {
 
-    map_bucket = new int[map_nbucket];
-    for (int i = 0; i < map_nbucket; i++) map_bucket[i] = -1;
+    int nslot = 1;
+    map_hshift = 32;
+    while (nslot < 2*map_nhash) {
+      nslot *= 2;
+      map_hshift--;
+    }
+    map_hmask = nslot-1;
 
-    map_hash = new HashElem[map_nhash];
+    map_hash = new HashElem[nslot];
+    for (int i = 0; i < nslot; i++) map_hash[i].global = 0;
     map_nused = 0;
-    map_free = 0;
-    for (int i = 0; i < map_nhash; i++) map_hash[i].next = i+1;
-    map_hash[map_nhash-1].next = -1;
   }
 }
 
 /* ----------------------------------------------------------------------
    clear global -> local map for all of my own and ghost atoms
    for hash table option:
-     global ID may not be in table if image atom was already cleared
+     table only holds my own and ghost atoms, so it is emptied at once
 ------------------------------------------------------------------------- */
 
 void Atom::map_clear()
 {
+  int nall = nlocal + nghost;
+  for (int i = 0; i < nall; i++) sametag[i] = -1;
+
   if (map_style == 1) {
-    int nall = nlocal + nghost;
-    for (int i = 0; i < nall; i++) {
-      sametag[i] = -1;
-      map_array[tag[i]] = -1;
-    }
+    for (int i = 0; i < nall; i++) map_array[tag[i]] = -1;
 
   } else {
-    int previous,global,ibucket,index;
-    int nall = nlocal + nghost;
-    for (int i = 0; i < nall; i++) {
-      sametag[i] = -1;
-
-      // search for key
-      // if don't find it, done
-
-      previous = -1;
-      global = tag[i];
-      ibucket = global % map_nbucket;
-      index = map_bucket[ibucket];
-      while (index > -1) {
-        if (map_hash[index].global == global) break;
-        previous = index;
-        index = map_hash[index].next;
-      }
-      if (index == -1) continue;
-
-      // delete the hash entry and add it to free list
-      // special logic if entry is 1st in the bucket
-
-      if (previous == -1) map_bucket[ibucket] = map_hash[index].next;
-      else map_hash[previous].next = map_hash[index].next;
-
-      map_hash[index].next = map_free;
-      map_free = index;
-      map_nused--;
-    }
+    if (map_nused) memset(map_hash,0,(map_hmask+1)*sizeof(HashElem));
+    map_nused = 0;
   }
 }
 
@@ -157,41 +135,17 @@ void Atom::map_set()
     }
 
   } else {
-    int previous,global,ibucket,index;
     if (nall > map_nhash) map_init();
 
+    //NP style may have switched to array in map_init()
+    if (map_style == 1) {
+      map_set();
+      return;
+    }
+
     for (int i = nall-1; i >= 0 ; i--) {
       sametag[i] = map_find_hash(tag[i]);
-
-      // search for key
-      // if found it, just overwrite local value with index
-
-      previous = -1;
-      global = tag[i];
-      ibucket = global % map_nbucket;
-      index = map_bucket[ibucket];
-      while (index > -1) {
-        if (map_hash[index].global == global) break;
-        previous = index;
-        index = map_hash[index].next;
-      }
-      if (index > -1) {
-        map_hash[index].local = i;
-        continue;
-      }
-
-      // take one entry from free list
-      // add the new global/local pair as entry at end of bucket list
-      // special logic if this entry is 1st in bucket
-
-      index = map_free;
-      map_free = map_hash[map_free].next;
-      if (previous == -1) map_bucket[ibucket] = index;
-      else map_hash[previous].next = index;
-      map_hash[index].global = global;
-      map_hash[index].local = i;
-      map_hash[index].next = -1;
-      map_nused++;
+      map_insert_hash(tag[i],i);
     }
   }
 }
@@ -206,35 +160,49 @@ void Atom::map_set()
 void Atom::map_one(int global, int local)
 {
   if (map_style == 1) map_array[global] = local;
-  else {
-    // search for key
-    // if found it, just overwrite local value with index
-
-    int previous = -1;
-    int ibucket = global % map_nbucket;
-    int index = map_bucket[ibucket];
-    while (index > -1) {
-      if (map_hash[index].global == global) break;
-      previous = index;
-      index = map_hash[index].next;
+  else map_insert_hash(global,local);
+}
+
+/* ----------------------------------------------------------------------
+   insert global ID into hash table or overwrite its local index
+   an entry which is closer to its home slot than the one being inserted
+   gives up its slot and is moved on instead
+------------------------------------------------------------------------- */
+
+void Atom::map_insert_hash(int global, int local)
+{
+  int index = map_home(global);
+  int dist = 0;
+
+  while (1) {
+    const int key = map_hash[index].global;
+
+    if (key == 0) {
+      map_hash[index].global = global;
+      map_hash[index].local = local;
+      map_nused++;
+      return;
     }
-    if (index > -1) {
+
+    //NP only the original key can be in the table already
+    //NP entries moved on by swapping are unique
+    if (key == global) {
       map_hash[index].local = local;
       return;
     }
 
-    // take one entry from free list
-    // add the new global/local pair as entry at end of bucket list
-    // special logic if this entry is 1st in bucket
-
-    index = map_free;
-    map_free = map_hash[map_free].next;
-    if (previous == -1) map_bucket[ibucket] = index;
-    else map_hash[previous].next = index;
-    map_hash[index].global = global;
-    map_hash[index].local = local;
-    map_hash[index].next = -1;
-    map_nused++;
+    const int keydist = (index - map_home(key)) & map_hmask;
+    if (keydist < dist) {
+      const int swaplocal = map_hash[index].local;
+      map_hash[index].global = global;
+      map_hash[index].local = local;
+      global = key;
+      local = swaplocal;
+      dist = keydist;
+    }
+
+    index = (index+1) & map_hmask;
+    dist++;
   }
 }
 
@@ -252,53 +220,41 @@ void Atom::map_delete()
     map_array = NULL;
   } else {
     if (map_nhash) {
-      delete [] map_bucket;
       delete [] map_hash;
-      map_bucket = NULL;
       map_hash = NULL;
     }
     map_nhash = 0;
+    map_nused = 0;
   }
   map_tag_max = 0;
 }
 
 /* ----------------------------------------------------------------------
-   lookup global ID in hash table, return local index
-   called by map() in atom.h
+   direct access to the array map, e.g. to hand it to a coupled code
 ------------------------------------------------------------------------- */
 
-int Atom::map_find_hash(int global)
+int* Atom::get_map_array()
 {
-  int local = -1;
-  int index = map_bucket[global % map_nbucket];
-  while (index > -1) {
-    if (map_hash[index].global == global) {
-      local = map_hash[index].local;
-      break;
-    }
-    index = map_hash[index].next;
-  }
-  return local;
+  if (map_style != 1)
+    error->all(FLERR,"Atom map array requested, but atom map style is not array");
+  return map_array;
 }
 
 /* ----------------------------------------------------------------------
-   return next prime larger than n
+   pin the map to array style for callers that use get_map_array()
+   re-initializes the map if it currently is a hash table
 ------------------------------------------------------------------------- */
 
-int Atom::next_prime(int n)
+void Atom::map_require_array()
 {
-  int factor;
+  if (map_user && map_style == 2)
+    error->all(FLERR,"Atom map array required, but atom_modify map hash is used");
 
-  int nprime = n+1;
-  if (nprime % 2 == 0) nprime++;
-  int root = static_cast<int> (sqrt(1.0*n)) + 2;
+  map_user = 1;
+  if (map_style == 1) return;
 
-  while (nprime <= MAXSMALLINT) {
-    for (factor = 3; factor < root; factor++)
-      if (nprime % factor == 0) break;
-    if (factor == root) return nprime;
-    nprime += 2;
-  }
-
-  return MAXSMALLINT;
+  map_delete();
+  map_style = 1;
+  map_init();
+  map_set();
 }
@@ -18,6 +18,7 @@
 #include "style_body.h"
 #include "body.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "comm.h"
 #include "domain.h"
 #include "modify.h"
@@ -156,6 +157,7 @@ void AtomVecBody::grow(int n)
   torque = memory->grow(atom->torque,nmax*comm->nthreads,3,"atom:torque");
   body = memory->grow(atom->body,nmax,"atom:body");
 
+  atom->arena->grow(nmax);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -226,6 +228,7 @@ void AtomVecBody::copy(int i, int j, int delflag)
   if (body[i] >= 0 && i != j) bonus[body[i]].ilocal = j;
   body[j] = body[i];
 
+  atom->arena->copy(i,j);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->copy_arrays(i,j,delflag);
@@ -1005,6 +1008,7 @@ int AtomVecBody::pack_exchange(int i, double *buf)
     m += bonus[j].ndouble;
   }
 
+  m += atom->arena->pack_exchange(i,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->pack_exchange(i,&buf[m]);
@@ -1068,6 +1072,7 @@ int AtomVecBody::unpack_exchange(double *buf)
     body[nlocal] = nlocal_bonus++;
   }
 
+  m += atom->arena->unpack_exchange(nlocal,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->
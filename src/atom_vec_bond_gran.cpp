@@ -21,6 +21,7 @@ See the README file in the top-level LAMMPS directory.
 #include <stdlib.h>
 #include "atom_vec_bond_gran.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "domain.h"
 #include "modify.h"
 #include "fix.h"
@@ -148,6 +149,7 @@ void AtomVecBondGran::grow(int n)
         memory->grow(atom->bond_hist,nmax,atom->bond_per_atom,atom->n_bondhist,"atom:bond_hist");
   }
 
+  atom->arena->grow(nmax);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -215,6 +217,7 @@ void AtomVecBondGran::copy(int i, int j, int delflag)
   nspecial[j][2] = nspecial[i][2];
   for (k = 0; k < nspecial[j][2]; k++) special[j][k] = special[i][k];
 
+  atom->arena->copy(i,j);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->copy_arrays(i,j,delflag);
@@ -747,6 +750,7 @@ int AtomVecBondGran::pack_exchange(int i, double *buf)
   buf[m++] = nspecial[i][2];
   for (k = 0; k < nspecial[i][2]; k++) buf[m++] = special[i][k];
 
+  m += atom->arena->pack_exchange(i,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->pack_exchange(i,&buf[m]);
@@ -804,6 +808,7 @@ int AtomVecBondGran::unpack_exchange(double *buf)
   for (k = 0; k < nspecial[nlocal][2]; k++)
     special[nlocal][k] = static_cast<int> (buf[m++]);
 
+  m += atom->arena->unpack_exchange(nlocal,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->
@@ -14,6 +14,7 @@
 #include <stdlib.h>
 #include "atom_vec_charge.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "comm.h"
 #include "domain.h"
 #include "modify.h"
@@ -68,6 +69,7 @@ void AtomVecCharge::grow(int n)
 
   q = memory->grow(atom->q,nmax,"atom:q");
 
+  atom->arena->grow(nmax);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -104,6 +106,7 @@ void AtomVecCharge::copy(int i, int j, int delflag)
 
   q[j] = q[i];
 
+  atom->arena->copy(i,j);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->copy_arrays(i,j,delflag);
@@ -502,6 +505,7 @@ int AtomVecCharge::pack_exchange(int i, double *buf)
 
   buf[m++] = q[i];
 
+  m += atom->arena->pack_exchange(i,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->pack_exchange(i,&buf[m]);
@@ -531,6 +535,7 @@ int AtomVecCharge::unpack_exchange(double *buf)
 
   q[nlocal] = buf[m++];
 
+  m += atom->arena->unpack_exchange(nlocal,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->
@@ -19,6 +19,7 @@
 #include "atom_vec_ellipsoid.h"
 #include "math_extra.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "comm.h"
 #include "force.h"
 #include "domain.h"
@@ -91,6 +92,7 @@ void AtomVecEllipsoid::grow(int n)
   torque = memory->grow(atom->torque,nmax*comm->nthreads,3,"atom:torque");
   ellipsoid = memory->grow(atom->ellipsoid,nmax,"atom:ellipsoid");
 
+  atom->arena->grow(nmax);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -158,6 +160,7 @@ void AtomVecEllipsoid::copy(int i, int j, int delflag)
   if (ellipsoid[i] >= 0 && i != j) bonus[ellipsoid[i]].ilocal = j;
   ellipsoid[j] = ellipsoid[i];
 
+  atom->arena->copy(i,j);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->copy_arrays(i,j,delflag);
@@ -917,6 +920,7 @@ int AtomVecEllipsoid::pack_exchange(int i, double *buf)
     buf[m++] = quat[3];
   }
 
+  m += atom->arena->pack_exchange(i,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->pack_exchange(i,&buf[m]);
@@ -966,6 +970,7 @@ int AtomVecEllipsoid::unpack_exchange(double *buf)
     ellipsoid[nlocal] = nlocal_bonus++;
   }
 
+  m += atom->arena->unpack_exchange(nlocal,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->
@@ -15,6 +15,7 @@
 #include <string.h>
 #include "atom_vec_hybrid.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "domain.h"
 #include "modify.h"
 #include "fix.h"
@@ -156,8 +157,10 @@ void AtomVecHybrid::grow(int n)
 
   int tmp = atom->nextra_grow;
   atom->nextra_grow = 0;
+  atom->arena->freeze();
   for (int k = 0; k < nstyles; k++) styles[k]->grow(nmax);
   atom->nextra_grow = tmp;
+  atom->arena->thaw();
 
   // insure hybrid local ptrs and sub-style ptrs are up to date
   // for sub-styles, do this in case
@@ -165,6 +168,7 @@ void AtomVecHybrid::grow(int n)
 
   grow_reset();
 
+  atom->arena->grow(nmax);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -192,9 +196,12 @@ void AtomVecHybrid::copy(int i, int j, int delflag)
 {
   int tmp = atom->nextra_grow;
   atom->nextra_grow = 0;
+  atom->arena->freeze();
   for (int k = 0; k < nstyles; k++) styles[k]->copy(i,j,delflag);
   atom->nextra_grow = tmp;
+  atom->arena->thaw();
 
+  atom->arena->copy(i,j);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->copy_arrays(i,j,delflag);
@@ -697,13 +704,16 @@ int AtomVecHybrid::pack_exchange(int i, double *buf)
 
   int tmp = atom->nextra_grow;
   atom->nextra_grow = 0;
+  atom->arena->freeze();
 
   m = 0;
   for (k = 0; k < nstyles; k++)
     m += styles[k]->pack_exchange(i,&buf[m]);
 
   atom->nextra_grow = tmp;
+  atom->arena->thaw();
 
+  m += atom->arena->pack_exchange(i,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->pack_exchange(i,&buf[m]);
@@ -727,6 +737,7 @@ int AtomVecHybrid::unpack_exchange(double *buf)
 
   int tmp = atom->nextra_grow;
   atom->nextra_grow = 0;
+  atom->arena->freeze();
 
   m = 0;
   for (k = 0; k < nstyles; k++) {
@@ -735,7 +746,9 @@ int AtomVecHybrid::unpack_exchange(double *buf)
   }
 
   atom->nextra_grow = tmp;
+  atom->arena->thaw();
 
+  m += atom->arena->unpack_exchange(nlocal,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->
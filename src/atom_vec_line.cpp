@@ -16,6 +16,7 @@
 #include <string.h>
 #include "atom_vec_line.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "comm.h"
 #include "domain.h"
 #include "modify.h"
@@ -99,6 +100,7 @@ void AtomVecLine::grow(int n)
   torque = memory->grow(atom->torque,nmax*comm->nthreads,3,"atom:torque");
   line = memory->grow(atom->line,nmax,"atom:line");
 
+  atom->arena->grow(nmax);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -168,6 +170,7 @@ void AtomVecLine::copy(int i, int j, int delflag)
   if (line[i] >= 0 && i != j) bonus[line[i]].ilocal = j;
   line[j] = line[i];
 
+  atom->arena->copy(i,j);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->copy_arrays(i,j,delflag);
@@ -789,6 +792,7 @@ int AtomVecLine::pack_exchange(int i, double *buf)
     buf[m++] = bonus[j].theta;
   }
 
+  m += atom->arena->pack_exchange(i,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->pack_exchange(i,&buf[m]);
@@ -832,6 +836,7 @@ int AtomVecLine::unpack_exchange(double *buf)
     line[nlocal] = nlocal_bonus++;
   }
 
+  m += atom->arena->unpack_exchange(nlocal,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->
@@ -30,6 +30,7 @@ Christoph Kloss (JKU Linz and DCS Computing Gmbh, Linz)
 #include <string.h>
 #include "atom_vec_sph.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "domain.h"
 #include "modify.h"
 #include "force.h"
@@ -103,6 +104,7 @@ void AtomVecSPH::grow(int n)
   de = memory->grow(atom->de,nmax,"atom:de");
   vest = memory->grow(atom->vest, nmax, 3, "atom:vest");
 
+  atom->arena->grow(nmax);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -146,6 +148,7 @@ void AtomVecSPH::copy(int i, int j, int delflag)
   vest[j][1] = vest[i][1];
   vest[j][2] = vest[i][2];
 
+  atom->arena->copy(i,j);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->copy_arrays(i,j,delflag);
@@ -614,6 +617,7 @@ int AtomVecSPH::pack_exchange(int i, double *buf)
   buf[m++] = vest[i][1];
   buf[m++] = vest[i][2];
 
+  m += atom->arena->pack_exchange(i,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->pack_exchange(i,&buf[m]);
@@ -648,6 +652,7 @@ int AtomVecSPH::unpack_exchange(double *buf)
   vest[nlocal][1] = buf[m++];
   vest[nlocal][2] = buf[m++];
 
+  m += atom->arena->unpack_exchange(nlocal,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->
@@ -30,6 +30,7 @@ Christoph Kloss (JKU Linz and DCS Computing Gmbh, Linz)
 #include <string.h>
 #include "atom_vec_sph_var.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "domain.h"
 #include "modify.h"
 #include "force.h"
@@ -114,6 +115,7 @@ void AtomVecSPH2::grow(int n)
   radius = memory->grow(atom->radius,nmax,"atom:radius");
   rmass = memory->grow(atom->rmass,nmax,"atom:rmass");
 
+  atom->arena->grow(nmax);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -157,6 +159,7 @@ void AtomVecSPH2::copy(int i, int j, int delflag)
   radius[j] = radius[i];
   rmass[j] = rmass[i];
 
+  atom->arena->copy(i,j);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->copy_arrays(i,j,delflag);
@@ -739,6 +742,7 @@ int AtomVecSPH2::pack_exchange(int i, double *buf)
   buf[m++] = radius[i];
   buf[m++] = rmass[i];
 
+  m += atom->arena->pack_exchange(i,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->pack_exchange(i,&buf[m]);
@@ -772,6 +776,7 @@ int AtomVecSPH2::unpack_exchange(double *buf)
   radius[nlocal] = buf[m++];
   rmass[nlocal] = buf[m++];
 
+  m += atom->arena->unpack_exchange(nlocal,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->
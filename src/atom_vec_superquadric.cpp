@@ -35,6 +35,7 @@
 #include <string.h>
 #include "atom_vec_superquadric.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "comm.h"
 #include "domain.h"
 //#include "domain_wedge.h"
@@ -117,6 +118,7 @@ void AtomVecSuperquadric::grow(int n)
   quaternion = memory->grow(atom->quaternion,nmax,4,"atom:quaternion");
   angmom = memory->grow(atom->angmom,nmax,3,"atom:angmom");
 //------------------------------------------------------
+  atom->arena->grow(nmax);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -186,6 +188,7 @@ void AtomVecSuperquadric::copy(int i, int j, int delflag)
   angmom[j][1] = angmom[i][1];
   angmom[j][2] = angmom[i][2];
 //----------------------------------------------
+  atom->arena->copy(i,j);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->copy_arrays(i,j,delflag);
@@ -871,6 +874,7 @@ int AtomVecSuperquadric::pack_exchange(int i, double *buf)
   buf[m++] = angmom[i][2];
 //----------------------------------------
 
+  m += atom->arena->pack_exchange(i,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->pack_exchange(i,&buf[m]);
@@ -929,6 +933,7 @@ int AtomVecSuperquadric::unpack_exchange(double *buf)
   angmom[nlocal][2] = buf[m++];
 //----------------------------------------
 
+  m += atom->arena->unpack_exchange(nlocal,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->
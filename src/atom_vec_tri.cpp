@@ -17,6 +17,7 @@
 #include "atom_vec_tri.h"
 #include "math_extra.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "comm.h"
 #include "domain.h"
 #include "modify.h"
@@ -100,6 +101,7 @@ void AtomVecTri::grow(int n)
   torque = memory->grow(atom->torque,nmax*comm->nthreads,3,"atom:torque");
   tri = memory->grow(atom->tri,nmax,"atom:tri");
 
+  atom->arena->grow(nmax);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -170,6 +172,7 @@ void AtomVecTri::copy(int i, int j, int delflag)
   if (tri[i] >= 0 && i != j) bonus[tri[i]].ilocal = j;
   tri[j] = tri[i];
 
+  atom->arena->copy(i,j);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->copy_arrays(i,j,delflag);
@@ -1083,6 +1086,7 @@ int AtomVecTri::pack_exchange(int i, double *buf)
     buf[m++] = inertia[2];
   }
 
+  m += atom->arena->pack_exchange(i,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->pack_exchange(i,&buf[m]);
@@ -1145,6 +1149,7 @@ int AtomVecTri::unpack_exchange(double *buf)
     tri[nlocal] = nlocal_bonus++;
   }
 
+  m += atom->arena->unpack_exchange(nlocal,&buf[m]);
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       m += modify->fix[atom->extra_grow[iextra]]->
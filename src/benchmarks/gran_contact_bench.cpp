@@ -0,0 +1,355 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   microbenchmark of the granular contact models
+
+   every registered GranStyle combination is instantiated as pair style
+   gran in its own LAMMPS instance and evaluated via compute_single_pair()
+   over a synthetic ensemble of contacts (random radii, overlaps,
+   orientations, velocities and histories). the result is the time per
+   contact in ns, best of several repeats
+
+   usage: gran_contact_bench [-n ncontacts] [-r repeats] [-in file] [-all]
+                             ["model hertz tangential history ..."]
+------------------------------------------------------------------------- */
+
+#include <mpi.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "lammps.h"
+#include "input.h"
+#include "force.h"
+#include "pair_gran.h"
+#include "random_park.h"
+#include "contact_interface.h"
+#include "contact_model_constants.h"
+
+using namespace LAMMPS_NS;
+using namespace LIGGGHTS::ContactModels;
+
+namespace {
+
+// setup of the LAMMPS instance, defines the material properties of all
+// models in the default selection below. -in appends further commands
+
+const char *setup_commands[] = {
+  "atom_style granular",
+  "atom_modify map array",
+  "boundary f f f",
+  "units si",
+  "region reg block -0.01 0.01 -0.01 0.01 -0.01 0.01 units box",
+  "create_box 1 reg",
+  "fix m1 all property/global youngsModulus peratomtype 5.e6",
+  "fix m2 all property/global poissonsRatio peratomtype 0.45",
+  "fix m3 all property/global coefficientRestitution peratomtypepair 1 0.5",
+  "fix m4 all property/global coefficientFriction peratomtypepair 1 0.5",
+  "fix m5 all property/global characteristicVelocity scalar 2.",
+  "fix m6 all property/global cohesionEnergyDensity peratomtypepair 1 300000",
+  "fix m7 all property/global coefficientRollingFriction peratomtypepair 1 0.05",
+  "fix m8 all property/global coefficientRollingViscousDamping peratomtypepair 1 0.1",
+  "fix m9 all property/global kn peratomtypepair 1 1000",
+  "fix m10 all property/global kt peratomtypepair 1 1000",
+  "fix m11 all property/global gamman peratomtypepair 1 10",
+  "fix m12 all property/global gammat peratomtypepair 1 10",
+  NULL
+};
+
+// models covered by setup_commands, used unless -all is given
+
+const char *default_models[] = {
+  "hooke", "hertz", "hooke/stiffness", "hertz/stiffness",
+  "no_history", "history", "incremental_history",
+  "off", "sjkr", "sjkr2",
+  "cdt", "epsd", "epsd2",
+  "default",
+  NULL
+};
+
+// names of the registered models
+
+const char *surface_name(int id)
+{
+  switch(id) {
+  #define SURFACE_MODEL(identifier,str,constant) case identifier: return #str;
+  #include "style_surface_model.h"
+  #undef SURFACE_MODEL
+  }
+  return NULL;
+}
+
+const char *normal_name(int id)
+{
+  switch(id) {
+  #define NORMAL_MODEL(identifier,str,constant) case identifier: return #str;
+  #include "style_normal_model.h"
+  #undef NORMAL_MODEL
+  }
+  return NULL;
+}
+
+const char *tangential_name(int id)
+{
+  switch(id) {
+  #define TANGENTIAL_MODEL(identifier,str,constant) case identifier: return #str;
+  #include "style_tangential_model.h"
+  #undef TANGENTIAL_MODEL
+  }
+  return NULL;
+}
+
+const char *cohesion_name(int id)
+{
+  switch(id) {
+  case COHESION_OFF: return "off";
+  #define COHESION_MODEL(identifier,str,constant) case identifier: return #str;
+  #include "style_cohesion_model.h"
+  #undef COHESION_MODEL
+  }
+  return NULL;
+}
+
+const char *rolling_name(int id)
+{
+  switch(id) {
+  case ROLLING_OFF: return "off";
+  #define ROLLING_MODEL(identifier,str,constant) case identifier: return #str;
+  #include "style_rolling_model.h"
+  #undef ROLLING_MODEL
+  }
+  return NULL;
+}
+
+bool is_default_model(const char *name)
+{
+  for (int i = 0; default_models[i]; i++)
+    if (strcmp(name,default_models[i]) == 0) return true;
+  return false;
+}
+
+// pair style arguments of all registered combinations
+
+std::vector<std::string> registered_styles(bool all)
+{
+  std::vector<std::string> styles;
+
+  #define GRAN_MODEL(MODEL,TANGENTIAL,COHESION,ROLLING,SURFACE) \
+  { \
+    const char *names[5] = { normal_name(MODEL), tangential_name(TANGENTIAL), \
+                             cohesion_name(COHESION), rolling_name(ROLLING), \
+                             surface_name(SURFACE) }; \
+    bool use = true; \
+    for (int k = 0; k < 5; k++) \
+      if (!all && !is_default_model(names[k])) use = false; \
+    if (use) { \
+      std::string style = std::string("model ") + names[0] + " tangential " + names[1]; \
+      if (COHESION != COHESION_OFF) style += std::string(" cohesion ") + names[2]; \
+      if (ROLLING != ROLLING_OFF) style += std::string(" rolling_friction ") + names[3]; \
+      if (SURFACE != SURFACE_DEFAULT) style += std::string(" surface ") + names[4]; \
+      styles.push_back(style); \
+    } \
+  }
+  #include "style_contact_model.h"
+  #undef GRAN_MODEL
+
+  return styles;
+}
+
+// synthetic contact ensemble, one entry per contact
+
+struct Ensemble {
+  int n;
+  std::vector<double> radi,radj,delta,v,omega,history;
+  std::vector<int> touch;
+};
+
+void generate_ensemble(LAMMPS *lmp, Ensemble &e, int n, int dnum)
+{
+  RanPark random(lmp,4357);
+
+  e.n = n;
+  e.radi.resize(n);
+  e.radj.resize(n);
+  e.delta.resize(3*n);
+  e.v.resize(6*n);
+  e.omega.resize(6*n);
+  e.history.resize(dnum > 0 ? dnum*n : 1);
+  e.touch.assign(n,1);
+
+  const double rmean = 0.001;
+
+  for (int c = 0; c < n; c++) {
+    e.radi[c] = rmean*(0.8 + 0.4*random.uniform());
+    e.radj[c] = rmean*(0.8 + 0.4*random.uniform());
+
+    // random direction, overlap up to 1% of the radius sum
+
+    double en[3],len;
+    do {
+      for (int k = 0; k < 3; k++) en[k] = 2.*random.uniform() - 1.;
+      len = sqrt(en[0]*en[0] + en[1]*en[1] + en[2]*en[2]);
+    } while (len > 1. || len < 1e-3);
+
+    const double radsum = e.radi[c] + e.radj[c];
+    const double r = radsum*(1. - 0.01*random.uniform());
+    for (int k = 0; k < 3; k++) e.delta[3*c+k] = r*en[k]/len;
+
+    for (int k = 0; k < 6; k++) {
+      e.v[6*c+k] = 2.*random.uniform() - 1.;
+      e.omega[6*c+k] = 200.*random.uniform() - 100.;
+    }
+
+    for (int k = 0; k < dnum; k++)
+      e.history[dnum*c+k] = 1e-6*(2.*random.uniform() - 1.);
+  }
+}
+
+// returns the best time per contact in ns
+
+double run_style(const std::string &style, int ncontacts, int repeats,
+                 const char *infile, double &sink)
+{
+  const char *argv[] = {"gran_contact_bench", "-log", "none", "-screen", "none"};
+  LAMMPS *lmp = new LAMMPS(5,const_cast<char**>(argv),MPI_COMM_WORLD);
+
+  for (int i = 0; setup_commands[i]; i++) lmp->input->one(setup_commands[i]);
+  if (infile) lmp->input->file(infile);
+
+  std::string cmd = "pair_style gran " + style;
+  lmp->input->one(cmd.c_str());
+  lmp->input->one("pair_coeff * *");
+  lmp->input->one("timestep 0.00001");
+  lmp->input->one("create_atoms 1 single 0. 0. 0. units box");
+  lmp->input->one("create_atoms 1 single 0.005 0. 0. units box");
+  lmp->input->one("set atom * density 2500 diameter 0.002");
+  lmp->input->one("run 0");
+
+  PairGran *pg = static_cast<PairGran*>(lmp->force->pair);
+  const int dnum = pg->dnum();
+
+  Ensemble e;
+  generate_ensemble(lmp,e,ncontacts,dnum);
+
+  const double density = 2500.;
+  CollisionData cdata;
+  ForceData i_forces,j_forces;
+  cdata.i = 0;
+  cdata.j = 1;
+  cdata.itype = cdata.jtype = 1;
+  cdata.is_wall = false;
+  cdata.computeflag = 0;
+  cdata.shearupdate = 1;
+
+  double best = 0.;
+  for (int irepeat = 0; irepeat < repeats; irepeat++) {
+    const double start = MPI_Wtime();
+
+    for (int c = 0; c < e.n; c++) {
+      const double *delta = &e.delta[3*c];
+      cdata.radi = e.radi[c];
+      cdata.radj = e.radj[c];
+      cdata.radsum = cdata.radi + cdata.radj;
+      cdata.delta[0] = delta[0];
+      cdata.delta[1] = delta[1];
+      cdata.delta[2] = delta[2];
+      cdata.rsq = delta[0]*delta[0] + delta[1]*delta[1] + delta[2]*delta[2];
+      cdata.r = sqrt(cdata.rsq);
+      cdata.rinv = 1./cdata.r;
+      cdata.en[0] = delta[0]*cdata.rinv;
+      cdata.en[1] = delta[1]*cdata.rinv;
+      cdata.en[2] = delta[2]*cdata.rinv;
+      cdata.v_i = &e.v[6*c];
+      cdata.v_j = &e.v[6*c+3];
+      cdata.omega_i = &e.omega[6*c];
+      cdata.omega_j = &e.omega[6*c+3];
+      cdata.touch = &e.touch[c];
+      cdata.contact_history = dnum > 0 ? &e.history[dnum*c] : NULL;
+      cdata.mi = density*4.*M_PI/3.*cdata.radi*cdata.radi*cdata.radi;
+      cdata.mj = density*4.*M_PI/3.*cdata.radj*cdata.radj*cdata.radj;
+      cdata.meff = cdata.mi*cdata.mj/(cdata.mi + cdata.mj);
+
+      pg->compute_single_pair(cdata,i_forces,j_forces);
+      sink += i_forces.delta_F[0];
+    }
+
+    const double time = MPI_Wtime() - start;
+    if (irepeat == 0 || time < best) best = time;
+  }
+
+  delete lmp;
+  return 1.e9*best/ncontacts;
+}
+
+}
+
+/* ---------------------------------------------------------------------- */
+
+int main(int argc, char **argv)
+{
+  MPI_Init(&argc,&argv);
+
+  int ncontacts = 100000;
+  int repeats = 5;
+  const char *infile = NULL;
+  bool all = false;
+  std::vector<std::string> styles;
+
+  for (int iarg = 1; iarg < argc; iarg++) {
+    if (strcmp(argv[iarg],"-n") == 0 && iarg+1 < argc) ncontacts = atoi(argv[++iarg]);
+    else if (strcmp(argv[iarg],"-r") == 0 && iarg+1 < argc) repeats = atoi(argv[++iarg]);
+    else if (strcmp(argv[iarg],"-in") == 0 && iarg+1 < argc) infile = argv[++iarg];
+    else if (strcmp(argv[iarg],"-all") == 0) all = true;
+    else if (argv[iarg][0] == '-') {
+      fprintf(stderr,"usage: %s [-n ncontacts] [-r repeats] [-in file] [-all] [\"model ...\"]\n",argv[0]);
+      MPI_Finalize();
+      return 1;
+    } else styles.push_back(argv[iarg]);
+  }
+
+  if (ncontacts < 1 || repeats < 1) {
+    fprintf(stderr,"ncontacts and repeats must be > 0\n");
+    MPI_Finalize();
+    return 1;
+  }
+
+  if (styles.empty()) styles = registered_styles(all);
+
+  printf("# %d contacts, best of %d repeats\n",ncontacts,repeats);
+  printf("# %-76s %12s\n","pair_style gran","ns/contact");
+
+  double sink = 0.;
+  for (size_t i = 0; i < styles.size(); i++) {
+    const double ns = run_style(styles[i],ncontacts,repeats,infile,sink);
+    printf("%-78s %12.2f\n",styles[i].c_str(),ns);
+    fflush(stdout);
+  }
+
+  // keeps the force evaluations from being optimized away
+
+  printf("# checksum %g\n",sink);
+
+  MPI_Finalize();
+  return 0;
+}
@@ -35,6 +35,7 @@
 #include "universe.h"
 #include "atom.h"
 #include "atom_vec.h"
+#include "per_atom_arena.h"
 #include "force.h"
 #include "pair.h"
 #include "domain.h"
@@ -146,6 +147,9 @@ Comm::Comm(LAMMPS *lmp) : Pointers(lmp)
   maxrecv = BUFMIN;
   memory->create(buf_recv,maxrecv,"comm:buf_recv");
 
+  exchlist = NULL;
+  maxexchlist = 0;
+
   maxswap = 6;
   allocate_swap(maxswap);
 
@@ -182,6 +186,7 @@ Comm::~Comm()
 
   memory->destroy(buf_send);
   memory->destroy(buf_recv);
+  memory->destroy(exchlist);
 }
 
 /* ----------------------------------------------------------------------
@@ -921,22 +926,43 @@ void Comm::exchange()
 
   for (int dim = 0; dim < 3; dim++) {
 
-    // fill buffer with atoms leaving my box, using < and >=
-    // when atom is deleted, fill it in with last atom
+    // list atoms leaving my box, using < and >=
 
     x = atom->x;
     lo = sublo[dim];
     hi = subhi[dim];
     nlocal = atom->nlocal;
-    i = nsend = 0;
-
-    while (i < nlocal) {
-      if (x[i][dim] < lo || x[i][dim] >= hi) {
-        if (nsend > maxsend) grow_send(nsend,1);
-        nsend += avec->pack_exchange(i,&buf_send[nsend]);
-        avec->copy(nlocal-1,i,1);
-        nlocal--;
-      } else i++;
+
+    if (nlocal > maxexchlist) {
+      maxexchlist = atom->nmax;
+      memory->destroy(exchlist);
+      memory->create(exchlist,maxexchlist,"comm:exchlist");
+    }
+
+    int nexch = 0;
+    for (i = 0; i < nlocal; i++)
+      if (x[i][dim] < lo || x[i][dim] >= hi) exchlist[nexch++] = i;
+
+    // fill buffer with leaving atoms
+    // per-atom fields of the arena are packed for all of them at once
+
+    nsend = 0;
+    atom->arena->begin_pack_exchange(buf_send);
+    for (int k = 0; k < nexch; k++) {
+      if (nsend > maxsend) {
+        grow_send(nsend,1);
+        atom->arena->pack_exchange_buffer(buf_send);
+      }
+      nsend += avec->pack_exchange(exchlist[k],&buf_send[nsend]);
+    }
+    atom->arena->end_pack_exchange();
+
+    // delete leaving atoms, fill each hole with last atom
+    // going backwards, the last atom is never one that leaves
+
+    for (int k = nexch-1; k >= 0; k--) {
+      avec->copy(nlocal-1,exchlist[k],1);
+      nlocal--;
     }
     atom->nlocal = nlocal;
 
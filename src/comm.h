@@ -133,6 +133,9 @@ class Comm : protected Pointers {
   int maxexchange;                  // max # of datums/atom in exchange comm
   int bufextra;                     // extra space beyond maxsend in send buffer
 
+  int *exchlist;                    // atoms leaving my box in exchange
+  int maxexchlist;                  // size of exchlist
+
   int updown(int, int, int, double, int, double *);
                                             // compare cutoff to procs
   virtual void grow_send(int,int);          // reallocate send buffer
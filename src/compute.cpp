@@ -74,6 +74,7 @@ Compute::Compute(LAMMPS *lmp, int narg, char **arg) : Pointers(lmp),
   cudable = 0;
 
   invoked_scalar = invoked_vector = invoked_array = -1;
+  recorded_time = 0.0;
   invoked_peratom = invoked_local = -1;
 
   // set modify defaults
@@ -14,6 +14,7 @@
 #ifndef LMP_COMPUTE_H
 #define LMP_COMPUTE_H
 
+#include <mpi.h>
 #include "pointers.h"
 
 namespace LAMMPS_NS {
@@ -142,6 +143,27 @@ class Compute : protected Pointers {
   inline int sbmask(int j) const {
     return j >> SBBITS & 3;
   }
+ private:
+  // timing of invocations, if modify_timing is on
+  double recorded_time;
+  double previous_time;
+
+ public:
+  inline void reset_time_recording() {
+    recorded_time = 0.0;
+  }
+
+  inline double get_recorded_time() const {
+    return recorded_time;
+  }
+
+  inline void begin_time_recording() {
+    previous_time = MPI_Wtime();
+  }
+
+  inline void end_time_recording() {
+    recorded_time += MPI_Wtime() - previous_time;
+  }
 };
 
 }
@@ -194,6 +194,10 @@ void ComputeNparticlesTracerRegion::compute_vector_eval(bool countMass, double&
     // count all particles in region, taking image flag into account
     resultTot = 0.0; resultMarked = 0.0;
 
+    inregion_.resize(nlocal);
+    if(nlocal > 0)
+        region->match_batch(nlocal,x,&inregion_[0]);
+
     for(int i = 0; i < nlocal; i++)
     {
         if (!(mask[i] & groupbit)) continue; //check if on current processor and in group
@@ -205,7 +209,7 @@ void ComputeNparticlesTracerRegion::compute_vector_eval(bool countMass, double&
         if(IMAGE && image_dim_ == 2 && ( ((image[i] >> IMG2BITS) - IMGMAX) != image_no_) )
             continue;
 
-        if( region->match(x[i][0],x[i][1],x[i][2]) )
+        if( inregion_[i] )
         {
 
             if(countMass)
@@ -29,6 +29,7 @@ ComputeStyle(nparticles/tracer/region,ComputeNparticlesTracerRegion)
 #define LMP_COMPUTE_NPARTICLES_TRACER_REGION_H
 
 #include "compute.h"
+#include <vector>
 
 namespace LAMMPS_NS {
 
@@ -54,6 +55,7 @@ class ComputeNparticlesTracerRegion : public Compute {
   // params for regions where to mark and where to count
   int iregion_count_;
   char *idregion_count_;
+  std::vector<int> inregion_;
 
   class FixPropertyAtomTracer *fix_tracer_;
   char *fix_tracer_name_;
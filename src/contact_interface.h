@@ -159,6 +159,18 @@ struct ForceUpdate {
   }
 };
 
+// contact recorded by a thread, handed to contact consumers after the parallel pair loop
+struct ContactUpdate {
+  CollisionData cdata;
+  ForceData i_forces;
+  ForceData j_forces;
+
+  ContactUpdate(const CollisionData & cdata, const ForceData & i_forces, const ForceData & j_forces) :
+    cdata(cdata), i_forces(i_forces), j_forces(j_forces)
+  {
+  }
+};
+
 }
 
 class IContactHistorySetup {
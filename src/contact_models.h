@@ -90,6 +90,7 @@ namespace ContactModels
     inline void beginPass(CollisionData & cdata, ForceData & i_forces, ForceData & j_forces);
     inline void endPass(CollisionData & cdata, ForceData & i_forces, ForceData & j_forces);
     inline void registerSettings(Settings & settings);
+    inline void postSettings();
     inline void connectToProperties(PropertyRegistry & registry);
     inline bool checkSurfaceIntersect(CollisionData & cdata);
     inline void collision(CollisionData & cdata, ForceData & i_forces, ForceData & j_forces);
@@ -191,6 +192,12 @@ namespace ContactModels
       rollingModel.registerSettings(settings);
     }
 
+    // called once the settings have been parsed, before the history layout is fixed
+    inline void postSettings()
+    {
+      surfaceModel.postSettings();
+    }
+
     inline void connectToProperties(PropertyRegistry & registry)
     {
       surfaceModel.connectToProperties(registry);
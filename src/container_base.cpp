@@ -42,7 +42,8 @@ using namespace LAMMPS_NS;
     refFrame_(REF_FRAME_UNDEFINED),
     restartType_(RESTART_TYPE_UNDEFINED),
     scalePower_(-1),
-    useDefault_(false)
+    useDefault_(false),
+    isConstant_(false)
   {
   }
 
@@ -52,7 +53,8 @@ using namespace LAMMPS_NS;
     refFrame_(REF_FRAME_UNDEFINED),
     restartType_(RESTART_TYPE_UNDEFINED),
     scalePower_(-1),
-    useDefault_(false)
+    useDefault_(false),
+    isConstant_(false)
   {
       if(_id)
       {
@@ -67,7 +69,8 @@ using namespace LAMMPS_NS;
     refFrame_(REF_FRAME_UNDEFINED),
     restartType_(RESTART_TYPE_UNDEFINED),
     scalePower_(-1),
-    useDefault_(false)
+    useDefault_(false),
+    isConstant_(false)
   {
           setProperties(_id, _comm, _ref,_restart,_scalePower);
   }
@@ -78,7 +81,8 @@ using namespace LAMMPS_NS;
      refFrame_(orig.refFrame_),
      restartType_(orig.restartType_),
      scalePower_(orig.scalePower_),
-     useDefault_(orig.useDefault_)
+     useDefault_(orig.useDefault_),
+     isConstant_(orig.isConstant_)
   {
 
   }
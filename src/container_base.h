@@ -36,6 +36,7 @@ namespace LAMMPS_NS
 
   enum{ OPERATION_COMM_EXCHANGE,
         OPERATION_COMM_BORDERS,
+        OPERATION_COMM_BORDERS_UPDATE,
         OPERATION_COMM_FORWARD,
         OPERATION_COMM_REVERSE,
         OPERATION_RESTART,
@@ -74,6 +75,7 @@ namespace LAMMPS_NS
           virtual void delRestart(int n,bool scale,bool translate,bool rotate) = 0;
           virtual void delRestart(bool scale,bool translate,bool rotate) = 0;
           virtual void clearReverse(bool scale,bool translate,bool rotate) = 0;
+          virtual void addToElement(int i, const double *buf) = 0;
 
           virtual bool setFromContainer(ContainerBase *cont) = 0;
 
@@ -87,6 +89,14 @@ namespace LAMMPS_NS
           inline bool useDefault()
           { return useDefault_ ; }
 
+          // values of an element never change once it is created, so
+          // existing ghosts need no update (e.g. ids, mesh topology)
+          inline void setConstant()
+          { isConstant_ = true; }
+
+          inline bool isConstant()
+          { return isConstant_; }
+
           // buffer functions for parallelization
 
           virtual int bufSize(int operation = OPERATION_UNDEFINED,
@@ -140,6 +150,7 @@ namespace LAMMPS_NS
           int scalePower_;
 
           bool useDefault_;
+          bool isConstant_;
 
      private:
 
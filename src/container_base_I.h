@@ -79,6 +79,18 @@
 
   inline bool ContainerBase::decidePackUnpackOperation(int operation,bool scale,bool translate, bool rotate) const
   {
+      //NP update of existing ghosts if ghost lists have not changed
+      //NP refreshes everything borders() would send except for
+      //NP constant values and manual comm (node_, center_ etc.), which
+      //NP every proc updates itself
+      if(OPERATION_COMM_BORDERS_UPDATE == operation)
+      {
+          if(COMM_TYPE_MANUAL == communicationType_ || COMM_TYPE_NONE == communicationType_ ||
+             COMM_TYPE_REVERSE == communicationType_ || isConstant_)
+            return false;
+          return true;
+      }
+
       // return true for manual communication, such as for node_, node_orig_
       // etc in MultiNodeMeshParallel
       if(COMM_TYPE_MANUAL == communicationType_)
@@ -146,7 +158,8 @@
       //NP forward and reverse comm always pull from buffer
       //NP (thats why they are done)
       if(operation == OPERATION_COMM_FORWARD ||
-         operation == OPERATION_COMM_REVERSE )
+         operation == OPERATION_COMM_REVERSE ||
+         operation == OPERATION_COMM_BORDERS_UPDATE)
         return true;
 
 
@@ -185,9 +198,10 @@
          operation == OPERATION_COMM_EXCHANGE )
         return true;
 
-      //NP forward and reverse comm never create new elements
+      //NP forward and reverse comm and ghost update never create new elements
       if(operation == OPERATION_COMM_FORWARD ||
-         operation == OPERATION_COMM_REVERSE )
+         operation == OPERATION_COMM_REVERSE ||
+         operation == OPERATION_COMM_BORDERS_UPDATE)
         return false;
 
       // default
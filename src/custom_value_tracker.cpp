@@ -26,6 +26,8 @@
 ------------------------------------------------------------------------- */
 
 #include "custom_value_tracker.h"
+#include "comm.h"
+#include "error.h"
 
 using namespace LAMMPS_NS;
 
@@ -49,6 +51,8 @@ using namespace LAMMPS_NS;
 
   CustomValueTracker::~CustomValueTracker()
   {
+      for(size_t i = 0; i < reductionBuffers_.size(); i++)
+        delete reductionBuffers_[i];
   }
 
   /* ----------------------------------------------------------------------
@@ -80,6 +84,17 @@ using namespace LAMMPS_NS;
 
   void CustomValueTracker::removeElementProperty(const char *_id)
   {
+     ContainerBase *cb = elementProperties_.getBasePointerById(_id);
+     for(size_t i = 0; cb && i < reductionBuffers_.size(); i++)
+     {
+        if(reductionBuffers_[i]->target() == cb)
+        {
+            delete reductionBuffers_[i];
+            reductionBuffers_.erase(reductionBuffers_.begin()+i);
+            break;
+        }
+     }
+
      elementProperties_.remove(_id);
   }
 
@@ -163,6 +178,34 @@ using namespace LAMMPS_NS;
       globalProperties_.move(vecIncremental);
   }
 
+  /* ----------------------------------------------------------------------
+   move / rotate element or global properties only
+   in rigid frame mode, element properties stay in the frame of the
+   mesh nodes and are transformed on materialization only
+  ------------------------------------------------------------------------- */
+
+  void CustomValueTracker::moveElementProperties(const double *vec)
+  {
+      //NP this handles owned and ghost elements
+      elementProperties_.move(vec);
+  }
+
+  void CustomValueTracker::rotateElementProperties(const double *q)
+  {
+      //NP this handles owned and ghost elements
+      elementProperties_.rotate(q);
+  }
+
+  void CustomValueTracker::moveGlobalProperties(const double *vec)
+  {
+      globalProperties_.move(vec);
+  }
+
+  void CustomValueTracker::rotateGlobalProperties(const double *q)
+  {
+      globalProperties_.rotate(q);
+  }
+
   /* ----------------------------------------------------------------------
    clear reverse properties, i.e. reset all of them to 0
   ------------------------------------------------------------------------- */
@@ -171,4 +214,44 @@ using namespace LAMMPS_NS;
   {
       //NP this handles owned and ghost elements
       elementProperties_.clearReverse(scale,translate,rotate);
+
+      //NP contributions not reduced so far are outdated as well
+      for(size_t i = 0; i < reductionBuffers_.size(); i++)
+        reductionBuffers_[i]->clear();
+  }
+
+  /* ----------------------------------------------------------------------
+   register per-element property as target of per-thread accumulation
+   contributions are added via ReductionBuffer::get() and merged into
+   the property via reduceThreadBuffers()
+  ------------------------------------------------------------------------- */
+
+  ReductionBuffer* CustomValueTracker::addReductionTarget(const char *_id)
+  {
+      if(comm->nthreads < 2)
+        return NULL;
+
+      ContainerBase *cb = elementProperties_.getBasePointerById(_id);
+      if(!cb)
+        error->one(FLERR,"Illegal reduction target: element property does not exist");
+      if(!cb->isDoubleData())
+        error->one(FLERR,"Illegal reduction target: element property must be of type double");
+
+      for(size_t i = 0; i < reductionBuffers_.size(); i++)
+        if(reductionBuffers_[i]->target() == cb)
+            return reductionBuffers_[i];
+
+      reductionBuffers_.push_back(new ReductionBuffer(cb,comm->nthreads));
+      return reductionBuffers_.back();
+  }
+
+  /* ----------------------------------------------------------------------
+   add per-thread contributions to all reduction targets
+   must be called outside of a parallel region
+  ------------------------------------------------------------------------- */
+
+  void CustomValueTracker::reduceThreadBuffers()
+  {
+      for(size_t i = 0; i < reductionBuffers_.size(); i++)
+        reductionBuffers_[i]->reduce();
   }
@@ -28,9 +28,11 @@
 #ifndef LMP_CUSTOM_VALUE_TRACKER_H
 #define LMP_CUSTOM_VALUE_TRACKER_H
 
+#include <vector>
 #include "associative_pointer_array.h"
 #include "container.h"
 #include "abstract_mesh.h"
+#include "reduction_buffer.h"
 
 namespace LAMMPS_NS
 {
@@ -62,6 +64,13 @@ namespace LAMMPS_NS
 
         void check_element_property_consistency(int _len);
 
+        // per-thread accumulation of per-element properties
+        //NP for properties that several threads add contributions to
+        //NP concurrently, returns NULL if running with one thread
+
+        ReductionBuffer* addReductionTarget(const char *_id);
+        void reduceThreadBuffers();
+
         // global (e.g. mesh) properties
 
         template<typename T>
@@ -100,6 +109,12 @@ namespace LAMMPS_NS
         void rotate(const double *dQ);
         void scale(double factor);
 
+        // move / rotate element or global properties only, used in rigid frame mode
+        void moveElementProperties(const double *vec);
+        void rotateElementProperties(const double *q);
+        void moveGlobalProperties(const double *vec);
+        void rotateGlobalProperties(const double *q);
+
         // buffer operations
 
         inline int elemListBufSize(int n,int operation,bool scale,bool translate,bool rotate);
@@ -129,6 +144,8 @@ namespace LAMMPS_NS
         class AssociativePointerArray<ContainerBase> elementProperties_;
         class AssociativePointerArray<ContainerBase> globalProperties_;
         class AssociativePointerArray<ContainerBase> globalProperties_orig_;
+
+        std::vector<ReductionBuffer*> reductionBuffers_;
   };
 
   // *************************************
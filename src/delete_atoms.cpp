@@ -239,16 +239,14 @@ void DeleteAtoms::delete_region(int narg, char **arg)
   if (iregion == -1) error->all(FLERR,"Could not find delete_atoms region ID");
   options(narg-2,&arg[2]);
 
-  // allocate and initialize deletion list
+  // allocate deletion list, flag atoms in region
 
   int nlocal = atom->nlocal;
   memory->create(dlist,nlocal,"delete_atoms:dlist");
-  for (int i = 0; i < nlocal; i++) dlist[i] = 0;
 
   double **x = atom->x;
 
-  for (int i = 0; i < nlocal; i++)
-    if (domain->regions[iregion]->match(x[i][0],x[i][1],x[i][2])) dlist[i] = 1;
+  domain->regions[iregion]->match_batch(nlocal,x,dlist);
   if (mol_flag == 0) return;
 
   // delete entire molecules if any atom in molecule was deleted
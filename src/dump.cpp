@@ -69,6 +69,7 @@ Dump::Dump(LAMMPS *lmp, int narg, char **arg) : Pointers(lmp)
   format_user = NULL;
   format_default = NULL;
   clearstep = 0;
+  recorded_time = 0.0;
   sort_flag = 0;
   append_flag = 0;
   buffer_allow = 0;
@@ -125,6 +125,27 @@ class Dump : protected Pointers {
   static int idcompare(const void *, const void *);
   static int bufcompare(const void *, const void *);
   static int bufcompare_reverse(const void *, const void *);
+ private:
+  // timing of invocations, if modify_timing is on
+  double recorded_time;
+  double previous_time;
+
+ public:
+  inline void reset_time_recording() {
+    recorded_time = 0.0;
+  }
+
+  inline double get_recorded_time() const {
+    return recorded_time;
+  }
+
+  inline void begin_time_recording() {
+    previous_time = MPI_Wtime();
+  }
+
+  inline void end_time_recording() {
+    recorded_time += MPI_Wtime() - previous_time;
+  }
 };
 
 }
@@ -370,7 +370,9 @@ int DumpCustomVTK::count()
   if (ncompute) {
     for (i = 0; i < ncompute; i++)
       if (!(compute[i]->invoked_flag & INVOKED_PERATOM)) {
+        if (modify->timing) compute[i]->begin_time_recording();
         compute[i]->compute_peratom();
+        if (modify->timing) compute[i]->end_time_recording();
         compute[i]->invoked_flag |= INVOKED_PERATOM;
       }
   }
@@ -234,7 +234,9 @@ int DumpLocal::count()
   if (ncompute) {
     for (i = 0; i < ncompute; i++) {
       if (!(compute[i]->invoked_flag & INVOKED_LOCAL)) {
+        if (modify->timing) compute[i]->begin_time_recording();
         compute[i]->compute_local();
+        if (modify->timing) compute[i]->end_time_recording();
         compute[i]->invoked_flag |= INVOKED_LOCAL;
       }
     }
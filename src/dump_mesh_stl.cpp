@@ -218,6 +218,10 @@ int DumpMeshSTL::count()
 
   /*NL*///if (screen) fprintf(screen,"nMesh_ %d\n",nMesh_);
 
+  // meshes in rigid frame mode are output at their current position
+  for(int imesh = 0; imesh < nMesh_; imesh++)
+      meshList_[imesh]->materialize();
+
   for(int imesh = 0; imesh < nMesh_; imesh++)
   {
       bounds(imesh,ilo,ihi);
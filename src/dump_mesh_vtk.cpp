@@ -414,6 +414,10 @@ int DumpMeshVTK::count()
 
   getRefs();
 
+  // meshes in rigid frame mode are output at their current position
+  for(int i = 0; i < nMesh_; i++)
+    meshList_[i]->materialize();
+
   for(int i = 0; i < nMesh_; i++)
   {
     if(!meshList_[i]->isParallel() && 0 != comm->me)
@@ -611,42 +611,7 @@ void Finish::end(int flag)
                 time_max, imbalance);
     }
 
-    if(modify->timing) {
-      double * fix_times = NULL;
-      if (me == 0) fix_times = new double[comm->nprocs];
-
-      // output fix timings
-      for(int i = 0; i < modify->nfix; i++) {
-        Fix * fix = modify->fix[i];
-        time = fix->get_recorded_time();
-        MPI_Allreduce(&time,&tmp,1,MPI_DOUBLE,MPI_SUM,world);
-        time = tmp/nprocs;
-
-         if (me == 0) {
-            if (screen)
-              fprintf(screen,"Fix %s %s time (%%) = %g (%g)\n",
-                  fix->id, fix->style, time,time/time_loop*100.0);
-            if (logfile)
-              fprintf(logfile,"Fix %s %s time (%%) = %g (%g)\n",
-                  fix->id, fix->style, time,time/time_loop*100.0);
-        }
-
-        if(modify->timing > 1) {
-          time = fix->get_recorded_time();
-          MPI_Gather(&time, 1, MPI_DOUBLE, fix_times, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
-
-          if (me == 0) {
-             for (int p = 0; p < comm->nprocs; ++p) {
-               if (screen)
-                 fprintf(screen,"  [%d] Fix %s %s time %g\n", p, fix->id, fix->style, fix_times[p]);
-               if (logfile)
-                 fprintf(logfile," [%d] Fix %s %s time %g\n", p, fix->id, fix->style, fix_times[p]);
-             }
-          }
-        }
-      }
-      delete [] fix_times;
-    }
+    if(modify->timing) timer->modify_breakdown(time_loop);
   }
 
   // FFT timing statistics
@@ -880,6 +845,10 @@ void Finish::end(int flag)
     }
   }
 
+  // write timeline trace of the timestep loop, if requested
+
+  timer->trace_write();
+
   if (logfile) fflush(logfile);
 }
 
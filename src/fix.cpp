@@ -93,7 +93,7 @@ Fix::Fix(LAMMPS *lmp, int narg, char **arg) : Pointers(lmp)
   maxvatom = 0;
   vatom = NULL;
 
-  recorded_time = 0.0;
+  reset_time_recording();
 
   datamask = ALL_MASK;
   datamask_ext = ALL_MASK;
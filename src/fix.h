@@ -25,6 +25,7 @@
 #define LMP_FIX_H
 
 #include "pointers.h"
+#include "timer.h"
 
 namespace LAMMPS_NS {
 
@@ -231,24 +232,31 @@ class Fix : protected Pointers {
  private:
   // add timing functionality to all fixes
   double recorded_time;
+  double recorded_hook_time[TIME_HOOK_N];
   double previous_time;
 
  public:
   inline void reset_time_recording() {
     recorded_time = 0.0;
+    for (int i = 0; i < TIME_HOOK_N; i++) recorded_hook_time[i] = 0.0;
   }
 
   inline double get_recorded_time() const {
     return recorded_time;
   }
 
+  inline double get_recorded_time(int hook) const {
+    return recorded_hook_time[hook];
+  }
+
   inline void begin_time_recording() {
     previous_time = MPI_Wtime();
   }
 
-  inline void end_time_recording() {
+  inline void end_time_recording(int hook = TIME_HOOK_OTHER) {
     double delta_time = MPI_Wtime() - previous_time;
     recorded_time += delta_time;
+    recorded_hook_time[hook] += delta_time;
   }
 
   union ubuf {  //NP modified R.B.
@@ -410,13 +410,17 @@ void FixAveCorrelate::end_of_step()
 
       if (argindex[i] == 0) {
         if (!(compute->invoked_flag & INVOKED_SCALAR)) {
+          if (modify->timing) compute->begin_time_recording();
           compute->compute_scalar();
+          if (modify->timing) compute->end_time_recording();
           compute->invoked_flag |= INVOKED_SCALAR;
         }
         scalar = compute->scalar;
       } else {
         if (!(compute->invoked_flag & INVOKED_VECTOR)) {
+          if (modify->timing) compute->begin_time_recording();
           compute->compute_vector();
+          if (modify->timing) compute->end_time_recording();
           compute->invoked_flag |= INVOKED_VECTOR;
         }
         scalar = compute->vector[argindex[i]-1];
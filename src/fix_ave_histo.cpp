@@ -625,13 +625,17 @@ void FixAveHisto::end_of_step()
       if (kind == GLOBAL && mode == SCALAR) {
         if (j == 0) {
           if (!(compute->invoked_flag & INVOKED_SCALAR)) {
+            if (modify->timing) compute->begin_time_recording();
             compute->compute_scalar();
+            if (modify->timing) compute->end_time_recording();
             compute->invoked_flag |= INVOKED_SCALAR;
           }
           bin_one(compute->scalar);
         } else {
           if (!(compute->invoked_flag & INVOKED_VECTOR)) {
+            if (modify->timing) compute->begin_time_recording();
             compute->compute_vector();
+            if (modify->timing) compute->end_time_recording();
             compute->invoked_flag |= INVOKED_VECTOR;
           }
           bin_one(compute->vector[j-1]);
@@ -639,13 +643,17 @@ void FixAveHisto::end_of_step()
       } else if (kind == GLOBAL && mode == VECTOR) {
         if (j == 0) {
           if (!(compute->invoked_flag & INVOKED_VECTOR)) {
+            if (modify->timing) compute->begin_time_recording();
             compute->compute_vector();
+            if (modify->timing) compute->end_time_recording();
             compute->invoked_flag |= INVOKED_VECTOR;
           }
           bin_vector(compute->size_vector,compute->vector,1);
         } else {
           if (!(compute->invoked_flag & INVOKED_ARRAY)) {
+            if (modify->timing) compute->begin_time_recording();
             compute->compute_array();
+            if (modify->timing) compute->end_time_recording();
             compute->invoked_flag |= INVOKED_ARRAY;
           }
           if (compute->array)
@@ -655,7 +663,9 @@ void FixAveHisto::end_of_step()
 
       } else if (kind == PERATOM) {
         if (!(compute->invoked_flag & INVOKED_PERATOM)) {
+          if (modify->timing) compute->begin_time_recording();
           compute->compute_peratom();
+          if (modify->timing) compute->end_time_recording();
           compute->invoked_flag |= INVOKED_PERATOM;
         }
         if (j == 0)
@@ -665,7 +675,9 @@ void FixAveHisto::end_of_step()
 
       } else if (kind == LOCAL) {
         if (!(compute->invoked_flag & INVOKED_LOCAL)) {
+          if (modify->timing) compute->begin_time_recording();
           compute->compute_local();
+          if (modify->timing) compute->end_time_recording();
           compute->invoked_flag |= INVOKED_LOCAL;
         }
         if (j == 0)
@@ -541,13 +541,17 @@ void FixAveTime::invoke_scalar(bigint ntimestep)
 
       if (argindex[i] == 0) {
         if (!(compute->invoked_flag & INVOKED_SCALAR)) {
+          if (modify->timing) compute->begin_time_recording();
           compute->compute_scalar();
+          if (modify->timing) compute->end_time_recording();
           compute->invoked_flag |= INVOKED_SCALAR;
         }
         scalar = compute->scalar;
       } else {
         if (!(compute->invoked_flag & INVOKED_VECTOR)) {
+          if (modify->timing) compute->begin_time_recording();
           compute->compute_vector();
+          if (modify->timing) compute->end_time_recording();
           compute->invoked_flag |= INVOKED_VECTOR;
         }
         scalar = compute->vector[argindex[i]-1];
@@ -667,7 +671,9 @@ void FixAveTime::invoke_vector(bigint ntimestep)
 
       if (argindex[j] == 0) {
         if (!(compute->invoked_flag & INVOKED_VECTOR)) {
+          if (modify->timing) compute->begin_time_recording();
           compute->compute_vector();
+          if (modify->timing) compute->end_time_recording();
           compute->invoked_flag |= INVOKED_VECTOR;
         }
         double *cvector = compute->vector;
@@ -676,7 +682,9 @@ void FixAveTime::invoke_vector(bigint ntimestep)
 
       } else {
         if (!(compute->invoked_flag & INVOKED_ARRAY)) {
+          if (modify->timing) compute->begin_time_recording();
           compute->compute_array();
+          if (modify->timing) compute->end_time_recording();
           compute->invoked_flag |= INVOKED_ARRAY;
         }
         double **carray = compute->array;
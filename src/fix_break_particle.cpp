@@ -1255,21 +1255,7 @@ void FixBreakParticle::check_von_mises_criterion()
 double* FixBreakParticle::get_triangle_contact_history(TriMesh *mesh, FixContactHistoryMesh *fix_contact, int iPart, int iTri)
 {
   // get contact history of particle iPart and triangle idTri
-  // NOTE: depends on naming in fix_wall_gran!
-  std::string fix_nneighs_name("n_neighs_mesh_");
-  fix_nneighs_name += mesh->mesh_id();
-  FixPropertyAtom* fix_nneighs = static_cast<FixPropertyAtom*>(modify->find_fix_property(fix_nneighs_name.c_str(),"property/atom","scalar",0,0,this->style));
-  if (fix_nneighs) {
-    int idTri = mesh->id(iTri);
-    const int nneighs = fix_nneighs->get_vector_atom_int(iPart);
-    for (int j = 0; j < nneighs; ++j) {
-      if (fix_contact->partner(iPart, j) == idTri) {
-        return fix_contact->contacthistory(iPart, j);
-      }
-    }
-  }
-
-  return NULL;
+  return fix_contact->findHistory(iPart, mesh->id(iTri));
 }
 
 /* ---------------------------------------------------------------------- */
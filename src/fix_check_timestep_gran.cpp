@@ -228,6 +228,9 @@ void FixCheckTimestepGran::calc_rayleigh_hertz_estims()
           mesh = (mesh_list[imesh])->triMesh();
           if(mesh->isMoving())
           {
+              //NP rigid frame: v is set on materialization
+              mesh->materialize();
+
               // check if perElementProperty 'v' exists
               if (!mesh->prop().hasElementProperty("v"))
                   error->one(FLERR,"Internal error - mesh has no perElementProperty 'v' \n");
@@ -41,7 +41,7 @@ class FixCheckTimestepGran : public Fix {
   void end_of_step();
   double compute_vector(int);
 
- private:
+ protected:
   class Properties* properties;
   class PairGran* pg;
   class FixWallGran* fwg;
@@ -279,6 +279,9 @@ void FixCheckTimestepSph::calc_courant_estims_eval()
           mesh = (mesh_list[imesh])->triMesh();
           if(mesh->isMoving())
           {
+              //NP rigid frame: v is set on materialization
+              mesh->materialize();
+
               // loop local elements only
               for(int itri=0;itri<mesh->sizeLocal();itri++)
                   for(int inode=0;inode<3;inode++)
@@ -473,15 +473,16 @@ int FixContactHistory::pack_exchange(int i, double *buf)
   // NOTE: how do I know comm buf is big enough if extreme # of touching neighs
   // Comm::BUFEXTRA may need to be increased
 
+  //NP length-prefixed: npartner, partner IDs, then all histories as one block
+  const int np = npartner_[i];
+
   int m = 0;
-  buf[m++] = ubuf(npartner_[i]).d;
-  for (int n = 0; n < npartner_[i]; n++) {
-    /*NL*/ //if(screen && strcmp(style,"contacthistory ")) fprintf(screen,"id %s: atom %d packing partner %d\n",id,atom->tag[i],partner_[i][n]);
+  buf[m++] = ubuf(np).d;
+  for (int n = 0; n < np; n++)
     buf[m++] = ubuf(partner_[i][n]).d;
-    for (int d = 0; d < dnum_; d++) {
-      buf[m++] = contacthistory_[i][n*dnum_+d];
-    }
-  }
+  if (np*dnum_ > 0)
+    memcpy(&buf[m],contacthistory_[i],np*dnum_*sizeof(double));
+  m += np*dnum_;
   return m;
 }
 
@@ -501,12 +502,12 @@ int FixContactHistory::unpack_exchange(int nlocal, double *buf)
   if (partner_[nlocal] == NULL || contacthistory_[nlocal] == NULL)
       error->one(FLERR,"Contact history overflow, boost neigh_modify one");
 
-  for (int n = 0; n < npartner_[nlocal]; n++) {
+  const int np = npartner_[nlocal];
+  for (int n = 0; n < np; n++)
     partner_[nlocal][n] = ubuf(buf[m++]).i;
-    for (int d = 0; d < dnum_; d++) {
-      contacthistory_[nlocal][n*dnum_+d] = buf[m++];
-    }
-  }
+  if (np*dnum_ > 0)
+    memcpy(contacthistory_[nlocal],&buf[m],np*dnum_*sizeof(double));
+  m += np*dnum_;
   return m;
 }
 
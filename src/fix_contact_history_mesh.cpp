@@ -51,8 +51,11 @@ FixContactHistoryMesh::FixContactHistoryMesh(LAMMPS *lmp, int narg, char **arg)
   dpage1_(0),
   ipage2_(0),
   dpage2_(0),
-  keeppage_(0),
-  keepflag_(0),
+  spage1_(0),
+  spage2_(0),
+  spage_(0),
+  stamp_(0),
+  generation_(0),
   mesh_(0),
   fix_neighlist_mesh_(0),
   fix_nneighs_(0),
@@ -68,11 +71,9 @@ FixContactHistoryMesh::FixContactHistoryMesh(LAMMPS *lmp, int narg, char **arg)
   mesh_ = (static_cast<FixMeshSurface*>(f))->triMesh();
   fix_neighlist_mesh_ = (static_cast<FixMeshSurface*>(f))->meshNeighlist();
 
-  swap_ = new double[dnum_];
-
-  // initial allocation of delflag
-  keepflag_ = (bool **) memory->srealloc(keepflag_,atom->nmax*sizeof(bool *),
-                                      "contact_history:keepflag");
+  // initial allocation of stamps
+  stamp_ = (int **) memory->srealloc(stamp_,atom->nmax*sizeof(int *),
+                                      "contact_history:stamp");
 }
 
 /* ---------------------------------------------------------------------- */
@@ -85,23 +86,15 @@ FixContactHistoryMesh::~FixContactHistoryMesh()
   if(dpage1_) delete [] dpage1_;
   if(ipage2_) delete [] ipage2_;
   if(dpage2_) delete [] dpage2_;
-
-  if(keeppage_) {
-    for(int i = 0; i < numpages_; i++) {
-      delete keeppage_[i];
-      keeppage_[i] = NULL;
-    }
-    delete [] keeppage_;
-    keeppage_ = NULL;
-  }
+  if(spage1_) delete [] spage1_;
+  if(spage2_) delete [] spage2_;
 
   //NP have been free'd above
   ipage_ = 0;
   dpage_ = 0;
+  spage_ = 0;
 
-  delete [] swap_;
-
-  if(keepflag_) memory->sfree(keepflag_);
+  if(stamp_) memory->sfree(stamp_);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -147,15 +140,8 @@ void FixContactHistoryMesh::allocate_pages()
     delete [] dpage1_;
     delete [] ipage2_;
     delete [] dpage2_;
-
-    if(keeppage_) {
-      for(int i = 0; i < numpages_; i++) {
-        delete keeppage_[i];
-        keeppage_[i] = NULL;
-      }
-      delete [] keeppage_;
-      keeppage_ = NULL;
-    }
+    delete [] spage1_;
+    delete [] spage2_;
 
     pgsize_ = neighbor->pgsize;
     oneatom_ = neighbor->oneatom;
@@ -164,7 +150,8 @@ void FixContactHistoryMesh::allocate_pages()
     dpage1_ = new MyPage<double>[numpages_];
     ipage2_ = new MyPage<int>[numpages_];
     dpage2_ = new MyPage<double>[numpages_];
-    keeppage_ = new MyPage<bool>*[numpages_];
+    spage1_ = new MyPage<int>[numpages_];
+    spage2_ = new MyPage<int>[numpages_];
 
     for (int i = 0; i < numpages_; i++) {
       if (ipage1_[i].init(oneatom_,pgsize_) != 0) {
@@ -179,34 +166,25 @@ void FixContactHistoryMesh::allocate_pages()
       if (dpage2_[i].init(oneatom_*MathExtraLiggghts::max(1,dnum_),pgsize_) != 0) {
         error->fix_error(FLERR, this, "bad dpage2 initialization");
       }
-    }
-
-#if defined(_OPENMP)
-    #pragma omp parallel
-    {
-      const int tid = omp_get_thread_num();
-      // make sure page is allocated in memory near core
-      keeppage_[tid] = new MyPage<bool>();
-      keeppage_[tid]->init(oneatom_,pgsize_);
-    }
-#else
-    for (int i = 0; i < numpages_; i++) {
-      keeppage_[i] = new MyPage<bool>();
-      if (keeppage_[i]->init(oneatom_,pgsize_) != 0) {
-        error->fix_error(FLERR, this, "bad keeppage initialization");
+      if (spage1_[i].init(oneatom_,pgsize_) != 0) {
+        error->fix_error(FLERR, this, "bad spage1 initialization");
+      }
+      if (spage2_[i].init(oneatom_,pgsize_) != 0) {
+        error->fix_error(FLERR, this, "bad spage2 initialization");
       }
     }
-#endif
 
     if(use_first)
     {
         ipage_ = ipage1_;
         dpage_ = dpage1_;
+        spage_ = spage1_;
     }
     else
     {
         ipage_ = ipage2_;
         dpage_ = dpage2_;
+        spage_ = spage2_;
     }
   }
 }
@@ -232,14 +210,14 @@ void FixContactHistoryMesh::min_setup_pre_exchange()
 }
 
 /* ----------------------------------------------------------------------
-   sort contacthistory so need
+   compact contacthistory so need
 ------------------------------------------------------------------------- */
 
 void FixContactHistoryMesh::pre_exchange()
 {
     //NP recent_restart is set in case is called out of setup_pre_exchange
     if(!recent_restart)
-        sort_contacts();
+        compact_contacts();
 
    // set maxtouch = max # of partners of any owned atom
    // bump up comm->maxexchange_fix if necessary
@@ -289,32 +267,24 @@ void FixContactHistoryMesh::pre_force(int dummy)
         return;
     build_neighlist_ = false;
 
-    //NP remove old contacts which are still in the history list
-    //NP but not in the new mesh neigh list
-    //NP this might be e.g. caused by particles moving through PBCs
-    //NP in this case, contact "jumps" from one element to the other
-    //NP do this here since have up-to-date mesh neighlist here
-    //NP which was created in FixNeighlistMesh::pre_force()
-
-    cleanUpContactJumps();
-
     //NP prev refers to time-steps before current rebuild
     //NP next refers to time-steps after current rebuild
 
-    int nneighs_next;
     int nlocal = atom->nlocal;
     int *partner_prev;
     double *contacthistory_prev;
 
     MyPage<int>    *ipage_next = (ipage_ == ipage1_) ? ipage2_ : ipage1_;
     MyPage<double> *dpage_next = (dpage_ == dpage1_) ? dpage2_ : dpage1_;
+    MyPage<int>    *spage_next = (spage_ == spage1_) ? spage2_ : spage1_;
 
     ipage_next->reset();
     dpage_next->reset();
+    spage_next->reset();
 
     for (int i = 0; i < nlocal; i++)
     {
-        nneighs_next = fix_nneighs_->get_vector_atom_int(i);
+        const int nslots_next = nSlots(i);
 
         //NP store pointer to previous data
         partner_prev = partner_[i];
@@ -322,37 +292,50 @@ void FixContactHistoryMesh::pre_force(int dummy)
 
         //NP get new storage for partner at next
         //NP get new storage for contact history at next
-        partner_[i] = ipage_next->get(nneighs_next);
+        partner_[i] = ipage_next->get(nslots_next);
         if (!partner_[i])
             error->one(FLERR,"mesh neighbor list overflow, boost neigh_modify one and/or page");
-        vectorInitializeN(partner_[i],nneighs_next,-1);
-        /*NL*/ //if (screen) fprintf(screen,"nneighs_next %d\n",nneighs_next);
-        contacthistory_[i] = dpage_next->get(nneighs_next*dnum_);
+        vectorInitializeN(partner_[i],nslots_next,-1);
+        stamp_[i] = spage_next->get(nslots_next);
+        if (!stamp_[i])
+            error->one(FLERR,"mesh neighbor list overflow, boost neigh_modify one and/or page");
+        vectorInitializeN(stamp_[i],nslots_next,generation_);
+        contacthistory_[i] = dpage_next->get(nslots_next*dnum_);
         if(!contacthistory_[i])
             error->one(FLERR,"mesh neighbor list overflow, boost neigh_modify one");
-        vectorZeroizeN(contacthistory_[i],nneighs_next*dnum_);
-
-        /*NL*/ //if (screen) fprintf(screen,"nneighs_next %d npartner_[i] %d\n",nneighs_next,npartner_[i]);
+        vectorZeroizeN(contacthistory_[i],nslots_next*dnum_);
 
-        if(npartner_[i] > nneighs_next)
-        {
-            /*NL*/ //if (screen) fprintf(screen,"tag %d nneighs_next %d npartner_[i] %d\n",atom->tag[i],nneighs_next,npartner_[i]);
-            error->one(FLERR,"internal error");
-        }
-
-        //NP copy from current to next
+        //NP re-insert from current to next
         //NP need to loop from 0..npartner_[i]-1 only
-        //NP since list has been sorted at this point so that active contacts
+        //NP since list has been compacted at this point so that active contacts
         //NP are at the beginning of the list
 
-        for(int ipartner = 0; ipartner < npartner_[i]; ipartner++)
+        const int npartner_prev = npartner_[i];
+        npartner_[i] = 0;
+
+        for(int ipartner = 0; ipartner < npartner_prev; ipartner++)
         {
-            if(partner_prev[ipartner] < 0)
+            const int idTri = partner_prev[ipartner];
+            if(idTri < 0)
                 error->one(FLERR,"internal error");
 
-            partner_[i][ipartner] = partner_prev[ipartner];
-            vectorCopyN(&(contacthistory_prev[ipartner*dnum_]),&(contacthistory_[i][ipartner*dnum_]),dnum_);
-            /*NL*/ //if (screen) fprintf(screen,"new data %e %e %e\n",contacthistory_[i][ipartner*dnum_],contacthistory_[i][ipartner*dnum_+1],contacthistory_[i][ipartner*dnum_+2]);
+            //NP remove old contacts which are not in the new mesh neigh list
+            //NP this might be e.g. caused by particles moving through PBCs
+            //NP in this case, contact "jumps" from one element to the other
+            //NP delete also non-owned triangles in list
+            //NP can happen when > 1 proc in periodic dimension
+            const int iTri = mesh_->map(idTri);
+            if(iTri == -1 || !fix_neighlist_mesh_->contactInList(iTri,i))
+                continue;
+
+            int slot;
+            findContact(i,idTri,nslots_next,slot);
+            if(slot < 0)
+                error->one(FLERR,"internal error");
+
+            partner_[i][slot] = idTri;
+            vectorCopyN(&(contacthistory_prev[ipartner*dnum_]),&(contacthistory_[i][slot*dnum_]),dnum_);
+            npartner_[i]++;
         }
    }
 
@@ -361,196 +344,41 @@ void FixContactHistoryMesh::pre_force(int dummy)
     //NP switch current and next
     ipage_ = ipage_next;
     dpage_ = dpage_next;
-}
-
-/* ---------------------------------------------------------------------- */
-
-void FixContactHistoryMesh::sort_contacts()
-{
-    int nlocal = atom->nlocal;
-    int nneighs, first_empty, last_filled;
-
-    /*NL*/ //if (screen) fprintf(screen,"starting sort\n");
-
-    for(int i = 0; i < nlocal; i++)
-    {
-        nneighs = fix_nneighs_->get_vector_atom_int(i);
-
-        if(0 == nneighs)
-            continue;
-
-        do
-        {
-            first_empty = last_filled = -1;
-
-            for(int j = 0; j < nneighs; j++)
-            {
-                if(-1 == first_empty && -1 == partner_[i][j])
-                    first_empty = j;
-                if(partner_[i][j] >= 0)
-                    last_filled = j;
-            }
-
-            if(first_empty > -1 && last_filled > -1 && first_empty < last_filled)
-                swap(i,first_empty,last_filled,true);
-        }
-        while(first_empty > -1 && last_filled > -1 && first_empty < last_filled);
-    }
-
-    /*NL*/ //if (screen) fprintf(screen,"ending sort\n");
+    spage_ = spage_next;
 }
 
 /* ----------------------------------------------------------------------
-     mark all contacts for deletion
+   move contacts detected in the last evaluation to the first slots,
+   expired contacts are dropped
 ------------------------------------------------------------------------- */
 
-void FixContactHistoryMesh::markAllContacts()
+void FixContactHistoryMesh::compact_contacts()
 {
     int nlocal = atom->nlocal;
-    keeppage_[0]->reset(true);
 
     for(int i = 0; i < nlocal; i++)
     {
-      const int nneighs = fix_nneighs_->get_vector_atom_int(i);
-      keepflag_[i] = keeppage_[0]->get(nneighs);
-      if (!keepflag_[i])
-        error->one(FLERR,"mesh contact history overflow, boost neigh_modify one");
-    }
-}
-
-/* ----------------------------------------------------------------------
-     mark all contacts for deletion
-------------------------------------------------------------------------- */
-
-void FixContactHistoryMesh::resetDeletionPage(int tid)
-{
-    // keep pages are initalized with 0 (= false)
-    keeppage_[tid]->reset(true);
-}
-
-/* ----------------------------------------------------------------------- */
-
-void FixContactHistoryMesh::markForDeletion(int tid, int i)
-{
-  const int nneighs = fix_nneighs_->get_vector_atom_int(i);
-  keepflag_[i] = keeppage_[tid]->get(nneighs);
-  if (!keepflag_[i])
-    error->one(FLERR,"mesh contact history overflow, boost neigh_modify one");
-}
-
-/* ----------------------------------------------------------------------
-     mark all contacts for deletion
-------------------------------------------------------------------------- */
-
-void FixContactHistoryMesh::markForDeletion(int tid, int ifrom, int ito)
-{
-  for(int i = ifrom; i < ito; ++i)
-  {
-    markForDeletion(tid, i);
-  }
-}
-
-/* ---------------------------------------------------------------------- */
-
-void FixContactHistoryMesh::cleanUpContacts()
-{
-    cleanUpContacts(0, atom->nlocal);
-}
-
-/* ---------------------------------------------------------------------- */
-
-void FixContactHistoryMesh::cleanUpContact(int i) {
-  const int nneighs = fix_nneighs_->get_vector_atom_int(i);
-
-  for(int j = 0; j < nneighs; ++j)
-  {
-    // delete values
-    //NP do not swap with last in array, since paged data structure
-    //NP doesn't support this
-    if(!keepflag_[i][j])
-    {
-      if(partner_[i][j] > -1)
-      {
-        --npartner_[i];
-        /*NL*/ //if(screen && DEBUG_P_TAG == atom->tag[i]) {fprintf(screen,"step " BIGINT_FORMAT " deleting contact: tri id %d, npartner %d, nneighs %d\n",update->ntimestep,partner_[i][j],npartner_[i],nneighs);
-        /*NL*/ //       for(int kk = 0; kk < nneighs; kk++)
-        /*NL*/ //         fprintf(screen,"    neigh %d: tri id %d\n",kk,partner_[i][kk]); }
-      }
-      partner_[i][j] = -1;
-      vectorZeroizeN(&(contacthistory_[i][j*dnum_]),dnum_);
-    }
-  }
-  /*NL*/ //if(screen && DEBUG_P_TAG == atom->tag[i]) {
-  /*NL*/ //       for(int kk = 0; kk < nneighs; kk++)
-  /*NL*/ //          fprintf(screen,"    neigh post-clean %d: tri id %d\n",kk,partner_[i][kk]); }
-}
-
-void FixContactHistoryMesh::cleanUpContacts(int ifrom, int ito)
-{
-  /*NL*/ //if(screen && 10024 == update->ntimestep) {
-  /*NL*/ //       int iDeb = atom->map(DEBUG_P_TAG);
-  /*NL*/ //       int nn = static_cast<int>(round(fix_nneighs_->vector_atom[iDeb]));
-  /*NL*/ //       for(int kk = 0; kk < nn; kk++)
-  /*NL*/ //          fprintf(screen,"       neigh PRE-pre-clean %d: tri id %d\n",kk,partner_[iDeb][kk]); }
+        const int nslots = nSlots(i);
+        int n = 0;
 
-  //NP delete contacts that no longer exist (i.e. delflag set)
-
-  for(int i = ifrom; i < ito; ++i)
-  {
-    cleanUpContact(i);
-  }
-}
-
-/* ---------------------------------------------------------------------- */
-
-void FixContactHistoryMesh::cleanUpContactJumps()
-{
-    int nlocal = atom->nlocal;
-    int iTri;
-
-    //NP delete contacts that no longer exist (i.e. not found in mesh neigh list)
-    //NP important to loop here from 0..npartner-1 because when this fct is called
-    //NP nneighs is already the new #of neighbors
-
-    /*NL*///if(7==comm->me && screen) fprintf(screen,"fix id %s, pre-clean: atom tag %d: partner0 = %d\n",id,atom->tag[378],partner_[378][0]);
-    for(int i = 0; i < nlocal; i++)
-    {
-        int ipartner = 0;
-        while (ipartner < npartner_[i])
+        for(int s = 0; s < nslots; s++)
         {
-            //NP contacts should be sorted at this point
-            if(partner_[i][ipartner] < 0)
-            {
-                /*NL*/if (screen) fprintf(screen,"fix id %s, proc %d: atom %d / tag %d: npartner %d, ipartner %d, partner %d\n",id,comm->me,i,atom->tag[i],npartner_[i],ipartner,partner_[i][ipartner]);
-                error->one(FLERR,"internal error");
-            }
+            if(partner_[i][s] < 0 || stamp_[i][s] != generation_)
+                continue;
 
-            iTri = mesh_->map(partner_[i][ipartner]);
-            /*NL*/ //if(7998 == atom->tag[i] && screen)  fprintf(screen,"tri id %d found in old list %s\n",partner_[i][ipartner],fix_neighlist_mesh_->contactInList(iTri,i)?"true":"false");
-
-            //NP delete also non-owned triangles in list
-            //NP can happen when > 1 proc in periodic dimension
-            if(iTri == -1 || (iTri > -1 && !fix_neighlist_mesh_->contactInList(iTri,i)))
+            if(s != n)
             {
-                /*NL*/ //if(7998 == atom->tag[i] && screen) fprintf(screen,"step " BIGINT_FORMAT " deleting contact jump: tri id %d, npartner %d\n",update->ntimestep,partner_[i][ipartner],npartner_[i]);
-
-                //NP delete non-existing contact
-                //NP need to swap here so that there are no "holes" in the contact list
-                //NP necessary since this is assumed in pre_force and old number of neighbors
-                //NP is not known
-                //NP so need to keep list without holes
-                //NP do not swap delflag since not allocated at this point in parallel
-                //NP since unpack_exchange() does not allocate delflag
-                partner_[i][ipartner] = -1;
-                vectorZeroizeN(&(contacthistory_[i][ipartner*dnum_]),dnum_);
-                swap(i,ipartner,npartner_[i]-1,false);
-                npartner_[i]--;
-
-                /*NL*/ //error->one(FLERR,"catch");
+                partner_[i][n] = partner_[i][s];
+                stamp_[i][n] = stamp_[i][s];
+                vectorCopyN(&(contacthistory_[i][s*dnum_]),&(contacthistory_[i][n*dnum_]),dnum_);
             }
-            else
-                ipartner++;
+            n++;
         }
+
+        for(int s = n; s < nslots; s++)
+            partner_[i][s] = -1;
+
+        npartner_[i] = n;
     }
 }
 
@@ -562,10 +390,10 @@ void FixContactHistoryMesh::reset_history()
 
     for(int i = 0; i < nlocal; i++)
     {
-        const int nneighs = fix_nneighs_->get_vector_atom_int(i);
+        const int nslots = nSlots(i);
 
         // zeroize values
-        for(int j = 0; j < nneighs; j++)
+        for(int j = 0; j < nslots; j++)
             vectorZeroizeN(&(contacthistory_[i][j*dnum_]),dnum_);
     }
 }
@@ -592,8 +420,8 @@ void FixContactHistoryMesh::min_pre_force(int dummy)
 void FixContactHistoryMesh::grow_arrays(int nmax)
 {
   FixContactHistory::grow_arrays(nmax);
-  keepflag_ = (bool **) memory->srealloc(keepflag_,nmax*sizeof(bool *),
-                                      "contact_history:keepflag");
+  stamp_ = (int **) memory->srealloc(stamp_,nmax*sizeof(int *),
+                                      "contact_history:stamp");
 }
 
 /* ----------------------------------------------------------------------
@@ -609,7 +437,7 @@ void FixContactHistoryMesh::copy_arrays(int i, int j, int delflag)
   // OK, b/c will reset ipage,dpage on next reneighboring
 
   FixContactHistory::copy_arrays(i,j,delflag);
-  keepflag_[j] = keepflag_[i];
+  stamp_[j] = stamp_[i];
 }
 
 /* ----------------------------------------------------------------------
@@ -623,36 +451,37 @@ int FixContactHistoryMesh::unpack_exchange(int nlocal, double *buf)
   //NP between time-steps
 
   int m = 0;
-  const int nneighs = fix_nneighs_->get_vector_atom_int(nlocal);
+  const int nslots = nSlots(nlocal);
 
   /*NL*/ //if (screen) fprintf(screen,"unpacking (id %s), nlocal %d, nneighs %d npartner %d \n",id,nlocal,nneighs,static_cast<int> (buf[m]));
 
-  //NP allocate nneigh storage positions instead of npartner in base class
+  //NP allocate hash table storage positions instead of npartner in base class
+  //NP contacts are stored compacted, table is re-built in pre_force()
 
   npartner_[nlocal] = ubuf(buf[m++]).i;
   maxtouch_ = MAX(maxtouch_,npartner_[nlocal]);
-  int nalloc = MathExtraLiggghts::max(nneighs,npartner_[nlocal]);
+  int nalloc = MathExtraLiggghts::max(nslots,npartner_[nlocal]);
   partner_[nlocal] = ipage_->get(nalloc);
+  stamp_[nlocal] = spage_->get(nalloc);
   contacthistory_[nlocal] = dpage_->get(dnum_*nalloc);
 
-  if (!partner_[nlocal] || !contacthistory_[nlocal])
+  if (!partner_[nlocal] || !stamp_[nlocal] || !contacthistory_[nlocal])
         error->one(FLERR,"mesh contact history overflow, boost neigh_modify one");
 
-  //NP unpack values for contacts
-  for (int n = 0; n < npartner_[nlocal]; n++) {
+  //NP unpack values for contacts, layout see FixContactHistory::pack_exchange()
+  const int np = npartner_[nlocal];
+  for (int n = 0; n < np; n++)
     partner_[nlocal][n] = ubuf(buf[m++]).i;
-    /*NL*/ //if(screen) fprintf(screen,"atom %d: unpacking partner %d\n",atom->tag[nlocal],partner_[nlocal][n]);
-    /*NL*/ //if(screen && 22654==atom->tag[nlocal]) fprintf(screen,"id %s, atom tag %d: unpacking partner %d, nneighs %d, nlocal %d\n",id,atom->tag[nlocal],partner_[nlocal][n],nneighs,nlocal);
-    for (int d = 0; d < dnum_; d++) {
-      contacthistory_[nlocal][n*dnum_+d] = buf[m++];
-      /*NL*/ //if(screen) fprintf(screen,"atom %d: unpacking hist %e\n",atom->tag[nlocal],contacthistory_[nlocal][n*dnum_+d]);
-    }
-  }
+  if (np*dnum_ > 0)
+    memcpy(contacthistory_[nlocal],&buf[m],np*dnum_*sizeof(double));
+  m += np*dnum_;
 
   /*NL*/ //if(screen && 7==comm->me && nlocal>= 2432) fprintf(screen,"id %s, atom %d: to partner0 %d\n",id,atom->tag[2432],partner_[nlocal][0]);
 
-  //NP set initial values for neighs
-  for (int n = npartner_[nlocal]; n < nneighs; n++) {
+  vectorInitializeN(stamp_[nlocal],nalloc,generation_);
+
+  //NP set initial values for remaining slots
+  for (int n = npartner_[nlocal]; n < nalloc; n++) {
     partner_[nlocal][n] = -1;
     /*NL*/ //if(screen && 22654==atom->tag[nlocal]) fprintf(screen,"id %s, atom %d: resetting to partner %d\n",id,atom->tag[nlocal],partner_[nlocal][n]);
     for (int d = 0; d < dnum_; d++) {
@@ -681,17 +510,18 @@ void FixContactHistoryMesh::unpack_restart(int nlocal, int nth)
   for (int i = 0; i < nth; i++) m += static_cast<int> (extra[nlocal][m]);
   m++;
 
-  // allocate new chunks from ipage,dpage for incoming values
-  //NP allocate nneigh storage positions instead of npartner in base class
+  // allocate new chunks from ipage,dpage,spage for incoming values
+  //NP contacts are stored compacted, table is re-built in pre_force()
 
   int d;
 
   npartner_[nlocal] = ubuf(extra[nlocal][m++]).i;
   maxtouch_ = MAX(maxtouch_,npartner_[nlocal]);
   partner_[nlocal] = ipage_->get(npartner_[nlocal]);
+  stamp_[nlocal] = spage_->get(npartner_[nlocal]);
   contacthistory_[nlocal] = dpage_->get(npartner_[nlocal]*dnum_);
 
-  if (!partner_[nlocal] || !contacthistory_[nlocal])
+  if (!partner_[nlocal] || !stamp_[nlocal] || !contacthistory_[nlocal])
         error->one(FLERR,"mesh contact history overflow, boost neigh_modify one");
 
   /*NL*/ //if(screen) fprintf(screen,"npartner_[nlocal] %d\n",npartner_[nlocal]);
@@ -707,6 +537,8 @@ void FixContactHistoryMesh::unpack_restart(int nlocal, int nth)
       /*NL*/ //if(screen) fprintf(screen,"unpacking %e\n",contacthistory_[nlocal][n*dnum_+d]);
     }
   }
+
+  vectorInitializeN(stamp_[nlocal],npartner_[nlocal],generation_);
 }
 
 /* ----------------------------------------------------------------------
@@ -715,12 +547,55 @@ void FixContactHistoryMesh::unpack_restart(int nlocal, int nth)
 
 void FixContactHistoryMesh::write_restart(FILE *fp)
 {
+    //NP only contacts, not expired slots are written
+    //NP table is not compacted here since restart may be written mid-run
+
+    int nlocal = atom->nlocal;
+
+    maxtouch_ = 0;
+    for (int i = 0; i < nlocal; i++)
+      maxtouch_ = MAX(maxtouch_,size_restart(i)/(dnum_+1));
+
     FixContactHistory::write_restart(fp);
+}
+
+/* ----------------------------------------------------------------------
+   pack active contacts of atom i for restart file
+------------------------------------------------------------------------- */
+
+int FixContactHistoryMesh::pack_restart(int i, double *buf)
+{
+  const int nslots = MathExtraLiggghts::max(nSlots(i),npartner_[i]);
+  int m = 2, ncontacts = 0;
+
+  for (int s = 0; s < nslots; s++) {
+    if (partner_[i][s] < 0 || stamp_[i][s] != generation_) continue;
+
+    buf[m++] = ubuf(partner_[i][s]).d;
+    for (int d = 0; d < dnum_; d++)
+      buf[m++] = contacthistory_[i][s*dnum_+d];
+    ncontacts++;
+  }
+
+  buf[0] = m;
+  buf[1] = ubuf(ncontacts).d;
+  return m;
+}
+
+/* ----------------------------------------------------------------------
+   size of atom nlocal's restart data
+------------------------------------------------------------------------- */
+
+int FixContactHistoryMesh::size_restart(int nlocal)
+{
+  const int nslots = MathExtraLiggghts::max(nSlots(nlocal),npartner_[nlocal]);
+  int ncontacts = 0;
+
+  for (int s = 0; s < nslots; s++)
+    if (partner_[nlocal][s] >= 0 && stamp_[nlocal][s] == generation_)
+      ncontacts++;
 
-    //NP sort contacts so only contacts, not neighs are written
-    //NP pack_*() implementations in base class operate in npartner_
-    //NP not nneighs
-    sort_contacts();
+  return (dnum_+1)*ncontacts + 2;
 }
 
 /* ----------------------------------------------------------------------
@@ -739,7 +614,8 @@ double FixContactHistoryMesh::memory_usage()
     bytes += dpage1_[i].size();
     bytes += ipage2_[i].size();
     bytes += dpage2_[i].size();
-    bytes += keeppage_[i]->size();
+    bytes += spage1_[i].size();
+    bytes += spage2_[i].size();
   }
 
   return bytes;
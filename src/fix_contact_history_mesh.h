@@ -65,25 +65,24 @@ class FixContactHistoryMesh : public FixContactHistory {
   void grow_arrays(int);
   void copy_arrays(int, int, int);
   int unpack_exchange(int, double *);
+  int pack_restart(int, double *);
   void unpack_restart(int, int);
+  int size_restart(int);
   void write_restart(FILE *fp);
   double memory_usage();
 
   // spefific interface for mesh
 
+  //NP contacts not detected in an evaluation expire with the next one,
+  //NP so no mark and clean-up passes over the particles are needed
+  //NP call once per wall force evaluation, before handleContact()
+  inline void nextGeneration()
+  { generation_++; }
+
   bool handleContact(int iPart, int idTri, double *&history);
-  void markAllContacts();
-  void cleanUpContacts();
-  void cleanUpContactJumps();
+  double* findHistory(int iPart, int idTri);
   /*NL*/ void debug(int iPart, int idTri);
 
-  // OMP interface
-  void resetDeletionPage(int tid);
-  void markForDeletion(int tid, int i);
-  void markForDeletion(int tid, int ifrom, int ito);
-  void cleanUpContact(int i);
-  void cleanUpContacts(int ifrom, int ito);
-
   void reset_history();
 
   // return # of contacts
@@ -101,29 +100,36 @@ class FixContactHistoryMesh : public FixContactHistory {
   MyPage<double> *dpage1_;     // pages of contact history with neighbors
   MyPage<int> *ipage2_;        // pages of neighbor tri IDs
   MyPage<double> *dpage2_;     // pages of contact history with neighbors
-  MyPage<bool> ** keeppage_;   // pages of deletion flags with neighbors
+  MyPage<int> *spage1_;        // pages of generation stamps
+  MyPage<int> *spage2_;        // pages of generation stamps
+  MyPage<int> *spage_;         // current stamp pages
 
-  bool **keepflag_;
+  // per particle, partner_, contacthistory_ and stamp_ form an open
+  // addressing hash table keyed by tri ID with nSlots() slots
+  // between pre_exchange() and pre_force() after re-neighboring,
+  // the active contacts are compacted to the first npartner_ slots
+  int **stamp_;                // generation a contact was last detected
+  int generation_;             // current wall force evaluation
 
   void allocate_pages();
 
  private:
 
   // functions specific for mesh - contact management
-  bool haveContact(int indexPart, int idTri, double *&history);
-  bool coplanarContactAlready(int indexPart, int idTri);
-  void checkCoplanarContactHistory(int indexPart, int idTri, double *&history);
-  void addNewTriContactToExistingParticle(int indexPart, int idTri, double *&history);
+  inline int nSlots(int indexPart);
+  inline int hashSlot(int idTri, int nslots);
+  inline int findContact(int indexPart, int idTri, int nslots, int &insertSlot);
+  bool coplanarContactAlready(int indexPart, int idTri, int nslots);
+  void checkCoplanarContactHistory(int indexPart, int idTri, int nslots, double *&history);
+  void addNewTriContactToExistingParticle(int indexPart, int idTri, int slot, double *&history);
 
   class TriMesh *mesh_;
   class FixNeighlistMesh *fix_neighlist_mesh_;
   class FixPropertyAtom* fix_nneighs_;
   bool build_neighlist_;
-  double *swap_;
   int numpages_;
 
-  void sort_contacts();
-  void swap(int ilocal,int ineigh, int jneigh, bool keepflag_swap);
+  void compact_contacts();
 };
 
 // *************************************
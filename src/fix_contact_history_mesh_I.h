@@ -44,98 +44,116 @@
   {
     /*NL*/ //if(screen && DEBUG_P_TAG == atom->tag[iP]) fprintf(screen,"***contact with tri ID %d (index %d) at step " BIGINT_FORMAT "\n",idTri,iP,update->ntimestep);
 
-    // check if contact with iTri was there before
-    // if so, set history to correct location and return
-    if(haveContact(iP,idTri,history))
-      return true;
+    const int nslots = nSlots(iP);
+    int insertSlot;
+    const int slot = findContact(iP,idTri,nslots,insertSlot);
 
-    /*NL*/// if (screen) fprintf(screen,"   new contact - adding\n");
+    // check if contact with iTri was there in the last evaluation
+    // if so, set history to correct location and return
+    if(slot >= 0 && stamp_[iP][slot] >= generation_-1)
+    {
+        stamp_[iP][slot] = generation_;
+        if(dnum_ > 0) history = &(contacthistory_[iP][slot*dnum_]);
+        return true;
+    }
 
     // else new contact - add contact if did not calculate contact with coplanar neighbor already
-    //NP this can be detected via delflag == false
-    if(coplanarContactAlready(iP,idTri))
+    if(coplanarContactAlready(iP,idTri,nslots))
         // did not add new contact
         return false;
     else
     {
-        addNewTriContactToExistingParticle(iP,idTri,history);
+        //NP an expired contact with the same tri re-uses its slot
+        addNewTriContactToExistingParticle(iP,idTri,slot >= 0 ? slot : insertSlot,history);
 
-        // check if one of the contacts of previous steps is coplanar with iTri
-        //NP can be seen via delflag == false
+        // check if one of the contacts of the last evaluation is coplanar with iTri
         // if so, copy history
-        // also check if this contact has delflag = false, i.e. has been executed already
-        // this step. If so, signalize not to execute this contact (return false)
-        checkCoplanarContactHistory(iP,idTri,history);
+        checkCoplanarContactHistory(iP,idTri,nslots,history);
         return true;
     }
   }
 
+  /* ----------------------------------------------------------------------
+     history of an active contact of particle iP with tri idTri, 0 if none
+  ------------------------------------------------------------------------- */
 
-
-  /* ---------------------------------------------------------------------- */
-
-  inline void FixContactHistoryMesh::swap(int ilocal,int ineigh, int jneigh, bool keepflag_swap)
+  inline double* FixContactHistoryMesh::findHistory(int iP, int idTri)
   {
-      //NP swap data of ineigh and jneigh
+    int insertSlot;
+    const int slot = findContact(iP,idTri,nSlots(iP),insertSlot);
 
-      int id_temp;
-
-      id_temp                  = partner_[ilocal][ineigh];
-      partner_[ilocal][ineigh] = partner_[ilocal][jneigh];
-      partner_[ilocal][jneigh] = id_temp;
+    if(slot < 0 || stamp_[iP][slot] != generation_ || 0 == dnum_)
+        return 0;
+    return &(contacthistory_[iP][slot*dnum_]);
+  }
 
-      vectorCopyN(&(contacthistory_[ilocal][ineigh*dnum_]),swap_,                                   dnum_);
-      vectorCopyN(&(contacthistory_[ilocal][jneigh*dnum_]),&(contacthistory_[ilocal][ineigh*dnum_]),dnum_);
-      vectorCopyN(swap_,                                   &(contacthistory_[ilocal][jneigh*dnum_]),dnum_);
+  /* ----------------------------------------------------------------------
+     twice the # of neighbor tris, so probe sequences stay short
+  ------------------------------------------------------------------------- */
 
-      if(keepflag_swap)
-      {
-          const bool keepflag_temp  = keepflag_[ilocal][ineigh];
-          keepflag_[ilocal][ineigh] = keepflag_[ilocal][jneigh];
-          keepflag_[ilocal][jneigh] = keepflag_temp;
-      }
+  inline int FixContactHistoryMesh::nSlots(int iP)
+  {
+    return MathExtraLiggghts::min(2*fix_nneighs_->get_vector_atom_int(iP),oneatom_);
   }
 
   /* ---------------------------------------------------------------------- */
 
-  inline bool FixContactHistoryMesh::haveContact(int iP, int idTri, double *&history)
+  inline int FixContactHistoryMesh::hashSlot(int idTri, int nslots)
   {
-    int *tri = partner_[iP];
-    const int nneighs = fix_nneighs_->get_vector_atom_int(iP);
+    //NP multiplicative hashing, tri IDs of a particle are often consecutive
+    return static_cast<int>((static_cast<unsigned int>(idTri)*2654435761u) % static_cast<unsigned int>(nslots));
+  }
 
-    /*NL*/ //if (screen) fprintf(screen,"nneighs %d dnum_ %d\n",nneighs,dnum_);
+  /* ----------------------------------------------------------------------
+     slot of tri idTri, -1 if not found
+     insertSlot is the first free or expired slot on the probe sequence
+  ------------------------------------------------------------------------- */
 
-    for(int i = 0; i < nneighs; i++)
+  inline int FixContactHistoryMesh::findContact(int iP, int idTri, int nslots, int &insertSlot)
+  {
+    insertSlot = -1;
+    if(0 == nslots)
+        return -1;
+
+    const int *tri = partner_[iP];
+    const int *stamp = stamp_[iP];
+    int s = hashSlot(idTri,nslots);
+
+    for(int n = 0; n < nslots; n++)
     {
-        if(tri[i] == idTri)
+        if(tri[s] == idTri)
+            return s;
+        if(tri[s] < 0)
         {
-            if(dnum_ > 0) history = &(contacthistory_[iP][i*dnum_]);
-            keepflag_[iP][i] = true;
-            return true;
+            if(insertSlot < 0) insertSlot = s;
+            return -1;
         }
+        //NP expired slots stay occupied so probe sequences are not broken
+        if(insertSlot < 0 && stamp[s] < generation_-1)
+            insertSlot = s;
+        if(++s == nslots) s = 0;
     }
-    return false;
+    return -1;
   }
 
   /* ---------------------------------------------------------------------- */
 
-  inline bool FixContactHistoryMesh::coplanarContactAlready(int iP, int idTri)
+  inline bool FixContactHistoryMesh::coplanarContactAlready(int iP, int idTri, int nslots)
   {
-    const int nneighs = fix_nneighs_->get_vector_atom_int(iP);
-    for(int i = 0; i < nneighs; i++)
+    const int *tri = partner_[iP];
+    const int *stamp = stamp_[iP];
+
+    for(int s = 0; s < nslots; s++)
     {
-      /*NL*/// if (screen) fprintf(screen," step %d: iP %d, partner %d: %d, coplanar %s delflag %s, mesh_->map(tri[i]) %d\n",
-      /*NL*///                update->ntimestep,iP,i,tri[i],mesh_->areCoplanarNodeNeighs(tri[i],idTri)?"y":"n",delflag[iP][i]?"y":"n",mesh_->map(tri[i]));
-      /*NL*/ //if (screen) fprintf(screen,"ip %d i %d idTri %d tri[i] %d\n",iP,i,idTri,tri[i]);
+      //NP only contacts detected in this evaluation
       //NP do only if old partner owned or ghost on this proc
-      int idPartnerTri = partner_[iP][i];
+      const int idPartnerTri = tri[s];
 
-      if(idPartnerTri >= 0 && idPartnerTri != idTri && mesh_->map(idPartnerTri) >= 0 && mesh_->areCoplanarNodeNeighs(idPartnerTri,idTri))
+      if(idPartnerTri >= 0 && stamp[s] == generation_ && idPartnerTri != idTri &&
+         mesh_->map(idPartnerTri) >= 0 && mesh_->areCoplanarNodeNeighs(idPartnerTri,idTri))
       {
-        /*NL*/ //if (screen) fprintf(screen," step %d: idTri %d, delflag %s \n",update->ntimestep,idTri,delflag[iP][i]?"true":"false");
-
         // other coplanar contact handled already - do not handle this contact
-        if(keepflag_[iP][i]) return true;
+        return true;
       }
     }
 
@@ -145,84 +163,48 @@
 
   /* ---------------------------------------------------------------------- */
 
-  inline void FixContactHistoryMesh::checkCoplanarContactHistory(int iP, int idTri, double *&history)
+  inline void FixContactHistoryMesh::checkCoplanarContactHistory(int iP, int idTri, int nslots, double *&history)
   {
-    int *tri = partner_[iP];
-    const int nneighs = fix_nneighs_->get_vector_atom_int(iP);
+    const int *tri = partner_[iP];
+    const int *stamp = stamp_[iP];
 
-    for(int i = 0; i < nneighs; i++)
+    for(int s = 0; s < nslots; s++)
     {
+      //NP contacts of the last evaluation, this evaluation has been checked
+      //NP in coplanarContactAlready() already
       //NP do only if old partner owned or ghost on this proc
-      if(tri[i] >= 0 && tri[i] != idTri && mesh_->map(tri[i]) >= 0 && mesh_->areCoplanarNodeNeighs(tri[i],idTri))
+      if(tri[s] >= 0 && tri[s] != idTri && stamp[s] >= generation_-1 &&
+         mesh_->map(tri[s]) >= 0 && mesh_->areCoplanarNodeNeighs(tri[s],idTri))
       {
-          //NP this is illegal since coplanarContactAlready() should have avoided this
-          /*NL*/ if(keepflag_[iP][i]) error->one(FLERR,"internal error");
-
           // copy contact history
-          if(dnum_ > 0) vectorCopyN(&(contacthistory_[iP][i*dnum_]),history,dnum_);
-          /*NL*/// if (screen) fprintf(screen,"Found coplanar contact, old contact hist %f %f %f\n",
-          /*NL*///                   contacthistory[iP][i][0],contacthistory[iP][i][1],contacthistory[iP][i][2]);
-          /*NL*/// if (screen) fprintf(screen,"Found coplanar contact, new contact hist %f %f %f\n",
-          /*NL*///                   history[0],history[1],history[2]);
-          /*NL*/ //error->one(FLERR,"end");
+          if(dnum_ > 0) vectorCopyN(&(contacthistory_[iP][s*dnum_]),history,dnum_);
       }
     }
   }
 
   /* ---------------------------------------------------------------------- */
 
-  inline void FixContactHistoryMesh::addNewTriContactToExistingParticle(int iP, int idTri, double *&history)
+  inline void FixContactHistoryMesh::addNewTriContactToExistingParticle(int iP, int idTri, int slot, double *&history)
   {
-      //NP error if # contacts larger than # of neighs
-      //NP cannot store contact history in this case since allocation insufficient
+      //NP error if no slot available
       //NP should not happen since only neighbor can become contact
-      const int nneighs = fix_nneighs_->get_vector_atom_int(iP);
-      int iContact = -1;
-
-      if(-1 == idTri)
+      //NP and there are at least as many slots as neighbors
+      if(-1 == idTri || slot < 0)
         error->one(FLERR,"internal error");
 
-      if(npartner_[iP] >= nneighs)
-      {
-        /*NL*/ //if (screen)
-        /*NL*/ //{
-        /*NL*/ //  fprintf(screen,"step " BIGINT_FORMAT ": for particle tag %d, proc %d npartner %d nneighs %d newcontact id %d\n",update->ntimestep,atom->tag[iP],comm->me,npartner_[iP],nneighs,idTri);
-        /*NL*/ //  for(int kk = 0; kk < nneighs; kk++)
-        /*NL*/ //    fprintf(screen,"  neigh %d: tri id %d\n",kk,partner_[iP][kk]);
-        /*NL*/ //}
-        error->one(FLERR,"internal error");
-      }
+      if(partner_[iP][slot] < 0)
+        npartner_[iP]++;
 
-      //NP look for first free storage position in array
-      for(int ineigh = 0; ineigh < nneighs; ineigh++)
-      {
-          if(-1 == partner_[iP][ineigh])
-          {
-              iContact = ineigh;
-              break;
-          }
-      }
-
-      if(iContact >= nneighs)
-        error->one(FLERR,"internal error");
-
-      partner_[iP][iContact] = idTri;
-      keepflag_[iP][iContact] = true;
+      partner_[iP][slot] = idTri;
+      stamp_[iP][slot] = generation_;
 
       if(dnum_ > 0)
       {
-          history = &(contacthistory_[iP][iContact*dnum_]);
+          history = &(contacthistory_[iP][slot*dnum_]);
           vectorZeroizeN(history,dnum_);
       }
       else
           history = 0;
-
-      npartner_[iP]++;
-
-      /*NL*/ //if(screen && DEBUG_P_TAG == atom->tag[iP]) {
-      /*NL*/ //   fprintf(screen,"step " BIGINT_FORMAT " adding contact # %d: tri id %d, npartner %d nneighs %d\n",update->ntimestep,npartner_[iP],idTri,npartner_[iP],nneighs);
-      /*NL*/ //       for(int kk = 0; kk < nneighs; kk++)
-      /*NL*/ //         fprintf(screen,"    neigh %d: tri id %d\n",kk,partner_[iP][kk]); }
   }
 
   /* ---------------------------------------------------------------------- */
@@ -232,7 +214,12 @@
     int ncontacts = 0, nlocal = atom->nlocal;
 
     for(int i = 0; i < nlocal; i++)
-           ncontacts += npartner_[i];
+    {
+        const int nslots = nSlots(i);
+        for(int s = 0; s < nslots; s++)
+            if(partner_[i][s] >= 0 && stamp_[i][s] == generation_)
+                ncontacts++;
+    }
     return ncontacts;
   }
 
@@ -244,8 +231,14 @@
     int *mask = atom->mask;
 
     for(int i = 0; i < nlocal; i++)
-        if(mask[i] & contact_groupbit)
-           ncontacts += npartner_[i];
+    {
+        if(!(mask[i] & contact_groupbit)) continue;
+
+        const int nslots = nSlots(i);
+        for(int s = 0; s < nslots; s++)
+            if(partner_[i][s] >= 0 && stamp_[i][s] == generation_)
+                ncontacts++;
+    }
     return ncontacts;
   }
 
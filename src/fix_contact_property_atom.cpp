@@ -328,14 +328,13 @@ int FixContactPropertyAtom::unpack_exchange(int nlocal, double *buf)
   if (partner_[nlocal] == NULL || contacthistory_[nlocal] == NULL)
       error->one(FLERR,"Contact history overflow, boost neigh_modify one");
 
-  for (int n = 0; n < npartner_[nlocal]; n++) {
+  //NP layout see FixContactHistory::pack_exchange()
+  const int np = npartner_[nlocal];
+  for (int n = 0; n < np; n++)
     partner_[nlocal][n] = ubuf(buf[m++]).i;
-
-    for (int d = 0; d < dnum_; d++) {
-      contacthistory_[nlocal][n*dnum_+d] = buf[m++];
-
-    }
-  }
+  if (np*dnum_ > 0)
+    memcpy(contacthistory_[nlocal],&buf[m],np*dnum_*sizeof(double));
+  m += np*dnum_;
 
   /*
   for (int n = npartner_[nlocal]; n < nneighs; n++) {
@@ -0,0 +1,277 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fix_dt_reset_gran.h"
+#include "atom.h"
+#include "update.h"
+#include "force.h"
+#include "pair_gran.h"
+#include "modify.h"
+#include "neighbor.h"
+#include "neigh_list.h"
+#include "fix_insert_stream.h"
+#include "comm.h"
+#include "error.h"
+#include "mpi_liggghts.h"
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+#define BIG 1.0e20
+
+/* ---------------------------------------------------------------------- */
+
+FixDtResetGran::FixDtResetGran(LAMMPS *lmp, int narg, char **arg) :
+  FixCheckTimestepGran(lmp, narg < 6 ? narg : 6, arg)
+{
+  //NP parent parses nevery and the Rayleigh/Hertz fractions, which are
+  //NP used as upper limits here instead of warning thresholds
+
+  if (nevery <= 0) error->all(FLERR,"Illegal fix dt/reset/gran command");
+  if (fraction_rayleigh_lim <= 0. || fraction_hertz_lim <= 0.)
+    error->all(FLERR,"Illegal fix dt/reset/gran command");
+
+  time_depend = 1;
+  size_vector = 5;
+  warnflag = false;
+
+  dtmin = dtmax = 0.;
+  fraction_skin_lim = 0.2;
+  overlap_lim = 0.05;
+  growth = 1.1;
+  shrink = 0.5;
+  dtdelta = 0.01;
+  double dense = 1.;
+
+  int iarg = 6;
+  while (iarg < narg) {
+    if (iarg+2 > narg) error->all(FLERR,"Illegal fix dt/reset/gran command");
+    if (strcmp(arg[iarg],"dtmin") == 0) {
+      if (strcmp(arg[iarg+1],"NULL") == 0) dtmin = 0.;
+      else dtmin = force->numeric(FLERR,arg[iarg+1]);
+    } else if (strcmp(arg[iarg],"dtmax") == 0) {
+      if (strcmp(arg[iarg+1],"NULL") == 0) dtmax = 0.;
+      else dtmax = force->numeric(FLERR,arg[iarg+1]);
+    } else if (strcmp(arg[iarg],"skin") == 0) {
+      fraction_skin_lim = force->numeric(FLERR,arg[iarg+1]);
+    } else if (strcmp(arg[iarg],"overlap") == 0) {
+      overlap_lim = force->numeric(FLERR,arg[iarg+1]);
+    } else if (strcmp(arg[iarg],"growth") == 0) {
+      growth = force->numeric(FLERR,arg[iarg+1]);
+    } else if (strcmp(arg[iarg],"shrink") == 0) {
+      shrink = force->numeric(FLERR,arg[iarg+1]);
+    } else if (strcmp(arg[iarg],"dense") == 0) {
+      dense = force->numeric(FLERR,arg[iarg+1]);
+    } else error->all(FLERR,"Illegal fix dt/reset/gran command");
+    iarg += 2;
+  }
+
+  if (dtmin < 0. || dtmax < 0. || (dtmin > 0. && dtmax > 0. && dtmin >= dtmax))
+    error->all(FLERR,"Illegal fix dt/reset/gran command");
+  if (fraction_skin_lim <= 0. || overlap_lim <= 0. || growth < 1. ||
+      shrink <= 0. || shrink >= 1. || dense < 0.)
+    error->all(FLERR,"Illegal fix dt/reset/gran command");
+
+  // contacts per particle above which the Rayleigh criterion applies,
+  //   stored as the contact count per particle of a half list
+
+  coordination_dense = 0.5*dense;
+
+  overlap_max = 0.;
+  ncontact = 0;
+  laststep = update->ntimestep;
+  warn_dtmin = true;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixDtResetGran::setmask()
+{
+  int mask = 0;
+  mask |= END_OF_STEP;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixDtResetGran::init()
+{
+  FixCheckTimestepGran::init();
+
+  if (strstr(update->integrate_style,"respa"))
+    error->all(FLERR,"Fix dt/reset/gran does not support run_style respa");
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixDtResetGran::setup(int vflag)
+{
+  end_of_step();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixDtResetGran::end_of_step()
+{
+  calc_rayleigh_hertz_estims();
+  calc_overlap();
+
+  double dt = calc_dt();
+
+  // avoid resetting dependent classes for marginal changes
+
+  if (fabs(dt-update->dt) > dtdelta*update->dt) reset_dt_all(dt);
+
+  dt = update->dt;
+  fraction_rayleigh = dt/rayleigh_time;
+  fraction_hertz = dt/hertz_time;
+  fraction_skin = (vmax * dt) / neighbor->skin;
+}
+
+/* ----------------------------------------------------------------------
+   largest time-step size allowed by the current state
+   Hertz time at current max relative velocity, Rayleigh time if packing
+   is dense, distance travelled per step vs. skin, max overlap, and the
+   extrusion length of insert/stream fixes
+------------------------------------------------------------------------- */
+
+double FixDtResetGran::calc_dt()
+{
+  double dt = update->dt;
+  double dtnew = BIG;
+
+  if (vmax > 0.) {
+    dtnew = MIN(dtnew,fraction_hertz_lim*hertz_time);
+    dtnew = MIN(dtnew,fraction_skin_lim*neighbor->skin/vmax);
+  }
+
+  double natoms = static_cast<double>(atom->natoms);
+  if (natoms > 0. && ncontact >= coordination_dense*natoms)
+    dtnew = MIN(dtnew,fraction_rayleigh_lim*rayleigh_time);
+
+  // overlaps grow too large, so contacts are under-resolved
+
+  if (overlap_max > overlap_lim) dtnew = MIN(dtnew,shrink*dt);
+
+  // insert/stream needs particles to travel at most the extrusion length
+  //   between two insertions
+
+  int nstream = modify->n_fixes_style("insert/stream");
+  for (int i = 0; i < nstream; i++) {
+    FixInsertStream *fis =
+      static_cast<FixInsertStream*>(modify->find_fix_style("insert/stream",i));
+    double dtstream = fis->max_timestep();
+    if (dtstream > 0.) dtnew = MIN(dtnew,dtstream);
+  }
+
+  dtnew = MIN(dtnew,growth*dt);
+  if (dtmax > 0.) dtnew = MIN(dtnew,dtmax);
+  if (dtmin > 0. && dtnew < dtmin) {
+    if (warn_dtmin && comm->me == 0)
+      error->warning(FLERR,"Fix dt/reset/gran: time-step limited by dtmin");
+    warn_dtmin = false;
+    dtnew = dtmin;
+  }
+
+  return dtnew;
+}
+
+/* ----------------------------------------------------------------------
+   max overlap relative to the smaller radius and # of contacts
+   over the particle-particle pairs of the pair style neighbor list
+   with newton off, pairs with a ghost are listed on both procs,
+   so they are counted on the proc owning the atom with the lower tag
+------------------------------------------------------------------------- */
+
+void FixDtResetGran::calc_overlap()
+{
+  overlap_max = 0.;
+  ncontact = 0;
+
+  NeighList *list = pg->list;
+  if (!list) return;
+
+  double **x = atom->x;
+  double *radius = atom->radius;
+  int *mask = atom->mask;
+  int *tag = atom->tag;
+  int nlocal = atom->nlocal;
+  int newton_pair = force->newton_pair;
+  int inum = list->inum;
+  int *ilist = list->ilist;
+  int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+
+  for (int ii = 0; ii < inum; ii++) {
+    const int i = ilist[ii];
+    if (!(mask[i] & groupbit)) continue;
+    const double radi = radius[i];
+    const int *jlist = firstneigh[i];
+    const int jnum = numneigh[i];
+
+    for (int jj = 0; jj < jnum; jj++) {
+      const int j = jlist[jj] & NEIGHMASK;
+      const double delx = x[i][0] - x[j][0];
+      const double dely = x[i][1] - x[j][1];
+      const double delz = x[i][2] - x[j][2];
+      const double rsq = delx*delx + dely*dely + delz*delz;
+      const double radsum = radi + radius[j];
+      if (rsq >= radsum*radsum) continue;
+
+      if (newton_pair || j < nlocal || tag[i] < tag[j]) ncontact++;
+      const double overlap = (radsum - sqrt(rsq))/MIN(radi,radius[j]);
+      if (overlap > overlap_max) overlap_max = overlap;
+    }
+  }
+
+  MPI_Max_Scalar(overlap_max,world);
+  MPI_Sum_Scalar(ncontact,world);
+}
+
+/* ----------------------------------------------------------------------
+   reset update->dt and all classes that depend on it
+------------------------------------------------------------------------- */
+
+void FixDtResetGran::reset_dt_all(double dt)
+{
+  laststep = update->ntimestep;
+
+  update->update_time();
+  update->dt = dt;
+  if (force->pair) force->pair->reset_dt();
+  for (int i = 0; i < modify->nfix; i++) modify->fix[i]->reset_dt();
+}
+
+/* ----------------------------------------------------------------------
+   return fractions of rayleigh/hertz time-step, skin fraction,
+   current time-step size and max relative overlap
+------------------------------------------------------------------------- */
+
+double FixDtResetGran::compute_vector(int n)
+{
+  if (n < 3) return FixCheckTimestepGran::compute_vector(n);
+  else if (n == 3) return update->dt;
+  else if (n == 4) return overlap_max;
+  return 0.;
+}
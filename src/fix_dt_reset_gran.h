@@ -0,0 +1,80 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+
+FixStyle(dt/reset/gran,FixDtResetGran)
+
+#else
+
+#ifndef LMP_FIX_DT_RESET_GRAN_H
+#define LMP_FIX_DT_RESET_GRAN_H
+
+#include "fix_check_timestep_gran.h"
+
+namespace LAMMPS_NS {
+
+class FixDtResetGran : public FixCheckTimestepGran {
+ public:
+  FixDtResetGran(class LAMMPS *, int, char **);
+  int setmask();
+  void init();
+  void setup(int);
+  void end_of_step();
+  double compute_vector(int);
+
+ private:
+  double dtmin,dtmax;        // bounds of time-step size, 0 if unbounded
+  double fraction_skin_lim;  // max distance travelled per step / skin
+  double overlap_lim;        // max overlap relative to smaller radius
+  double growth;             // max factor dt can grow by per evaluation
+  double shrink;             // factor dt is reduced by if overlap_lim exceeded
+  double dtdelta;            // min relative change that resets dt
+  double coordination_dense; // contacts per particle to apply Rayleigh limit
+
+  double overlap_max;        // current max relative overlap
+  int ncontact;              // current # of particle-particle contacts
+  bigint laststep;           // step dt was last reset on
+  bool warn_dtmin;
+
+  double calc_dt();
+  void calc_overlap();
+  void reset_dt_all(double);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal fix dt/reset/gran command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.
+
+W: Fix dt/reset/gran: time-step limited by dtmin
+
+The time-step size required by the Rayleigh, Hertz, skin or overlap
+criterion is smaller than the lower bound set via the dtmin keyword.
+
+*/
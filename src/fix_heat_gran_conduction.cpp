@@ -19,6 +19,7 @@
    See the README file in the top-level directory.
 ------------------------------------------------------------------------- */
 
+#include <string.h>
 #include "fix_heat_gran_conduction.h"
 
 #include "atom.h"
@@ -33,6 +34,8 @@
 #include "modify.h"
 #include "neigh_list.h"
 #include "pair_gran.h"
+#include "respa.h"
+#include "update.h"
 
 using namespace LAMMPS_NS;
 using namespace FixConst;
@@ -123,6 +126,10 @@ void FixHeatGranCond::pre_delete(bool unfixflag)
   // tell cpl that this fix is deleted
   if(cpl && unfixflag) cpl->reference_deleted();
 
+  // stop callbacks from the pair loop
+  PairGran *pg = static_cast<PairGran*>(force->pair_match("gran", 0));
+  if(pg) pg->unregister_contact_consumer(this);
+
 }
 
 /* ---------------------------------------------------------------------- */
@@ -130,6 +137,7 @@ void FixHeatGranCond::pre_delete(bool unfixflag)
 int FixHeatGranCond::setmask()
 {
   int mask = FixHeatGran::setmask();
+  mask |= PRE_FORCE;
   mask |= POST_FORCE;
   return mask;
 }
@@ -200,12 +208,69 @@ void FixHeatGranCond::init()
   // error checks on coarsegraining
   if(force->cg_active())
     error->cg(FLERR,this->style);
+
+  //NP fluxes are reset and integrated once per outer step, a pair computed on
+  //NP an inner rRESPA level would add the flux of each substep
+  if (strcmp(update->integrate_style,"respa") == 0)
+  {
+    Respa *respa = (Respa *) update->integrate;
+    if(respa->level_pair != respa->nlevels-1)
+      error->fix_error(FLERR,this,"requires the granular pair style at the outermost rRESPA level");
+  }
+
+  // evaluate contacts inside the pair loop, so contact detection is done only once
+  pair_gran->register_contact_consumer(this);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixHeatGranCond::pre_force(int vflag)
+{
+  //NP update because re-allocation might have taken place
+  //NP pair_contact_eval() is called from the pair loop that follows
+  updatePtrs();
+}
+
+/* ----------------------------------------------------------------------
+   heat flux of a contact found by the granular pair style
+------------------------------------------------------------------------- */
+
+void FixHeatGranCond::pair_contact_eval(const LCM::CollisionData & cdata, const LCM::ForceData &, const LCM::ForceData &)
+{
+  // heat is not transferred during setup, as for the separate pass
+  if(update->setupflag) return;
+
+  const int i = cdata.i;
+  const int j = cdata.j;
+  const int *mask = atom->mask;
+  if (!(mask[i] & groupbit) && !(mask[j] & groupbit)) return;
+
+  const double *radius = atom->radius;
+  const double *del = cdata.delta;
+
+  if(CONDUCTION_CONTACT_AREA_OVERLAP == area_calculation_mode_)
+    contact_eval<CONDUCTION_CONTACT_AREA_OVERLAP>(i,j,del[0],del[1],del[2],cdata.rsq,radius[i],radius[j],0);
+  else if(CONDUCTION_CONTACT_AREA_CONSTANT == area_calculation_mode_)
+    contact_eval<CONDUCTION_CONTACT_AREA_CONSTANT>(i,j,del[0],del[1],del[2],cdata.rsq,radius[i],radius[j],0);
+  else if(CONDUCTION_CONTACT_AREA_PROJECTION == area_calculation_mode_)
+    contact_eval<CONDUCTION_CONTACT_AREA_PROJECTION>(i,j,del[0],del[1],del[2],cdata.rsq,radius[i],radius[j],0);
 }
 
 /* ---------------------------------------------------------------------- */
 
 void FixHeatGranCond::post_force(int vflag)
 {
+  //NP fluxes have been accumulated in pair_contact_eval() during the pair
+  //NP compute. only send fluxes on ghosts back in case of newton_pair=1
+  if(pair_gran->has_contact_consumers())
+  {
+    if(force->newton_pair)
+    {
+      fix_heatFlux->do_reverse_comm();
+      fix_directionalHeatFlux->do_reverse_comm();
+    }
+    return;
+  }
 
   if(history_flag == 0 && CONDUCTION_CONTACT_AREA_OVERLAP == area_calculation_mode_)
     post_force_eval<0,CONDUCTION_CONTACT_AREA_OVERLAP>(vflag,0);
@@ -245,15 +310,82 @@ void FixHeatGranCond::cpl_evaluate(ComputePairGranLocal *caller)
     post_force_eval<1,CONDUCTION_CONTACT_AREA_PROJECTION>(0,1);
 }
 
+/* ----------------------------------------------------------------------
+   heat flux over a single contact
+------------------------------------------------------------------------- */
+
+template <int CONTACTAREA>
+inline void FixHeatGranCond::contact_eval(int i,int j,double delx,double dely,double delz,double rsq,double radi,double radj,int cpl_flag)
+{
+  double hc,contactAreaOverPi,delta_n,flux,dirFlux[3],tcoi,tcoj;
+  const double radsum = radi + radj;
+  double r;
+  const int *type = atom->type;
+  const int newton_pair = force->newton_pair;
+  const int nlocal = atom->nlocal;
+
+  r = sqrt(rsq);
+
+  if(CONTACTAREA == CONDUCTION_CONTACT_AREA_OVERLAP)
+  {
+      //NP adjust overlap that may be superficially large due to softening
+      if(area_correction_flag_)
+      {
+        delta_n = radsum - r;
+        delta_n *= deltan_ratio_[type[i]-1][type[j]-1];
+        r = radsum - delta_n;
+      }
+
+      contactAreaOverPi = -0.25 * ( (r-radi-radj)*(r+radi-radj)*(r-radi+radj)*(r+radi+radj) )/(r*r); //contact area of the two spheres/Pi
+  }
+  else if (CONTACTAREA == CONDUCTION_CONTACT_AREA_CONSTANT)
+  {
+      contactAreaOverPi = fixed_contact_area_/MY_PI;
+  }
+  else if (CONTACTAREA == CONDUCTION_CONTACT_AREA_PROJECTION)
+  {
+      double rmin = MathExtraLiggghts::min(radi,radj);
+      contactAreaOverPi = rmin*rmin;
+  }
+
+  tcoi = conductivity_[type[i]-1];
+  tcoj = conductivity_[type[j]-1];
+  if (tcoi < SMALL || tcoj < SMALL) hc = 0.;
+  else hc = 4.*tcoi*tcoj/(tcoi+tcoj)*sqrt(contactAreaOverPi);
+
+  flux = (Temp[j]-Temp[i])*hc;
+
+  dirFlux[0] = flux*delx;
+  dirFlux[1] = flux*dely;
+  dirFlux[2] = flux*delz;
+  if(!cpl_flag)
+  {
+    //Add half of the flux (located at the contact) to each particle in contact
+    heatFlux[i] += flux;
+    directionalHeatFlux[i][0] += 0.50 * dirFlux[0];
+    directionalHeatFlux[i][1] += 0.50 * dirFlux[1];
+    directionalHeatFlux[i][2] += 0.50 * dirFlux[2];
+    if (newton_pair || j < nlocal)
+    {
+      heatFlux[j] -= flux;
+      directionalHeatFlux[j][0] += 0.50 * dirFlux[0];
+      directionalHeatFlux[j][1] += 0.50 * dirFlux[1];
+      directionalHeatFlux[j][2] += 0.50 * dirFlux[2];
+    }
+
+  }
+
+  if(cpl_flag && cpl) cpl->add_heat(i,j,flux);
+}
+
 /* ---------------------------------------------------------------------- */
 
 template <int HISTFLAG,int CONTACTAREA>
 void FixHeatGranCond::post_force_eval(int vflag,int cpl_flag)
 {
-  double hc,contactAreaOverPi,delta_n,flux,dirFlux[3];
   int i,j,ii,jj,inum,jnum;
   double xtmp,ytmp,ztmp,delx,dely,delz;
-  double radi,radj,radsum,rsq,r,tcoi,tcoj;
+  double radi,radj,radsum,rsq;
   int *ilist,*jlist,*numneigh,**firstneigh;
   int *touch,**firsttouch;
 
@@ -273,8 +405,6 @@ void FixHeatGranCond::post_force_eval(int vflag,int cpl_flag)
 
   double *radius = atom->radius;
   double **x = atom->x;
-  int *type = atom->type;
-  int nlocal = atom->nlocal;
   int *mask = atom->mask;
 
   //NP update because re-allocation might have taken place
@@ -321,58 +451,7 @@ void FixHeatGranCond::post_force_eval(int vflag,int cpl_flag)
           if(rsq >= radsum*radsum) continue;
         }
 
-        r = sqrt(rsq);
-
-        if(CONTACTAREA == CONDUCTION_CONTACT_AREA_OVERLAP)
-        {
-            //NP adjust overlap that may be superficially large due to softening
-            if(area_correction_flag_)
-            {
-              delta_n = radsum - r;
-              delta_n *= deltan_ratio_[type[i]-1][type[j]-1];
-              r = radsum - delta_n;
-            }
-
-            contactAreaOverPi = -0.25 * ( (r-radi-radj)*(r+radi-radj)*(r-radi+radj)*(r+radi+radj) )/(r*r); //contact area of the two spheres/Pi
-        }
-        else if (CONTACTAREA == CONDUCTION_CONTACT_AREA_CONSTANT)
-        {
-            contactAreaOverPi = fixed_contact_area_/MY_PI;
-        }
-        else if (CONTACTAREA == CONDUCTION_CONTACT_AREA_PROJECTION)
-        {
-            double rmin = MathExtraLiggghts::min(radi,radj);
-            contactAreaOverPi = rmin*rmin;
-        }
-
-        tcoi = conductivity_[type[i]-1];
-        tcoj = conductivity_[type[j]-1];
-        if (tcoi < SMALL || tcoj < SMALL) hc = 0.;
-        else hc = 4.*tcoi*tcoj/(tcoi+tcoj)*sqrt(contactAreaOverPi);
-
-        flux = (Temp[j]-Temp[i])*hc;
-
-        dirFlux[0] = flux*delx;
-        dirFlux[1] = flux*dely;
-        dirFlux[2] = flux*delz;
-        if(!cpl_flag)
-        {
-          //Add half of the flux (located at the contact) to each particle in contact
-          heatFlux[i] += flux;
-          directionalHeatFlux[i][0] += 0.50 * dirFlux[0];
-          directionalHeatFlux[i][1] += 0.50 * dirFlux[1];
-          directionalHeatFlux[i][2] += 0.50 * dirFlux[2];
-          if (newton_pair || j < nlocal)
-          {
-            heatFlux[j] -= flux;
-            directionalHeatFlux[j][0] += 0.50 * dirFlux[0];
-            directionalHeatFlux[j][1] += 0.50 * dirFlux[1];
-            directionalHeatFlux[j][2] += 0.50 * dirFlux[2];
-          }
-
-        }
-
-        if(cpl_flag && cpl) cpl->add_heat(i,j,flux);
+        contact_eval<CONTACTAREA>(i,j,delx,dely,delz,rsq,radi,radj,cpl_flag);
       }
     }
   }
@@ -30,10 +30,11 @@ FixStyle(heat/gran,FixHeatGranCond)
 #define LMP_FIX_HEATGRAN_CONDUCTION_H
 
 #include "fix_heat_gran.h"
+#include "pair_gran.h"
 
 namespace LAMMPS_NS {
 
-  class FixHeatGranCond : public FixHeatGran {
+  class FixHeatGranCond : public FixHeatGran, public PairGranContactConsumer {
   public:
     FixHeatGranCond(class LAMMPS *, int, char **);
     ~FixHeatGranCond();
@@ -42,8 +43,11 @@ namespace LAMMPS_NS {
 
     int setmask();
     void init();
+    virtual void pre_force(int);
     virtual void post_force(int);
 
+    void pair_contact_eval(const LCM::CollisionData & cdata, const LCM::ForceData & i_forces, const LCM::ForceData & j_forces);
+
     void cpl_evaluate(class ComputePairGranLocal *);
     void register_compute_pair_local(ComputePairGranLocal *);
     void unregister_compute_pair_local(ComputePairGranLocal *);
@@ -53,6 +57,7 @@ namespace LAMMPS_NS {
 
   private:
     template <int,int> void post_force_eval(int,int);
+    template <int> inline void contact_eval(int,int,double,double,double,double,double,double,int);
 
     class FixPropertyGlobal* fix_conductivity_;
     double *conductivity_;
@@ -30,6 +30,8 @@
 #include <string.h>
 #include <limits.h>
 #include <set>
+#include <vector>
+#include <algorithm>
 #include "fix_insert_pack.h"
 #include "atom.h"
 #include "atom_vec.h"
@@ -149,11 +151,25 @@ FixInsertPack::FixInsertPack(LAMMPS *lmp, int narg, char **arg) :
       insert_at = true;
       iarg+=4;
       hasargs = true;
+    } else if (strcmp(arg[iarg],"tile_cache") == 0) {
+      if (iarg+3 > narg) error->fix_error(FLERR,this,"expecting file name and fill fraction after 'tile_cache'");
+      int n = strlen(arg[iarg+1]) + 1;
+      delete [] tile_filename;
+      tile_filename = new char[n];
+      strcpy(tile_filename,arg[iarg+1]);
+      tile_fill_fraction = force->numeric(FLERR,arg[iarg+2]);
+      if(tile_fill_fraction <= 0. || tile_fill_fraction > LIGGGHTS::PackingTileCache::max_fill_fraction)
+        error->fix_error(FLERR,this,"Invalid fill fraction for 'tile_cache'");
+      iarg += 3;
+      hasargs = true;
     } else if(strcmp(style,"insert/pack") == 0) {
       error->fix_error(FLERR,this,"unknown keyword");
     }
   }
 
+  if(tile_filename && insert_at)
+    error->fix_error(FLERR,this,"'tile_cache' and 'pos' can not be used together");
+
   // no fixed total number of particles inserted by this fix exists
   if(strcmp(style,"insert/pack") == 0)
     ninsert_exists = 0;
@@ -164,6 +180,8 @@ FixInsertPack::FixInsertPack(LAMMPS *lmp, int narg, char **arg) :
 FixInsertPack::~FixInsertPack()
 {
   delete []idregion;
+  delete []tile_filename;
+  delete tile_cache;
   if (varflag)
   {
     delete [] varstr;
@@ -197,6 +215,10 @@ void FixInsertPack::init_defaults()
 
       warn_region = true;
       insert_at = false;
+
+      tile_cache = NULL;
+      tile_filename = NULL;
+      tile_fill_fraction = 0.;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -219,6 +241,13 @@ void FixInsertPack::init()
         if (varindex < 0)
             error->all(FLERR,"Variable name for fix/insert/pack does not exist");
     }
+
+    // slots must accommodate the largest bounding sphere to be inserted
+    if (tile_filename && !tile_cache)
+    {
+        tile_cache = new LIGGGHTS::PackingTileCache(lmp);
+        tile_cache->setup(tile_filename,fix_distribution->max_r_bound(),tile_fill_fraction,seed);
+    }
 }
 
 /* ----------------------------------------------------------------------
@@ -517,6 +546,14 @@ void FixInsertPack::x_v_omega(int ninsert_this_local,int &ninserted_this_local,
     ninserted_this_local = ninserted_spheres_this_local = 0;
     mass_inserted_this_local = 0.;
 
+    // fill from packing tiles first, remaining particles are inserted randomly
+    if(tile_cache)
+    {
+        x_v_omega_tiles(ninsert_this_local,ninserted_this_local,ninserted_spheres_this_local,mass_inserted_this_local);
+        if(ninserted_this_local == ninsert_this_local)
+            return;
+    }
+
     double pos[3];
     ParticleToInsert *pti;
 
@@ -531,7 +568,7 @@ void FixInsertPack::x_v_omega(int ninsert_this_local,int &ninserted_this_local,
     // no overlap check
     if(!check_ol_flag)
     {
-        for(int itotal = 0; itotal < ninsert_this_local; itotal++)
+        for(int itotal = ninserted_this_local; itotal < ninsert_this_local; itotal++)
         {
             pti = fix_distribution->pti_list[ninserted_this_local];
             double rbound = pti->r_bound_ins;
@@ -636,6 +673,79 @@ void FixInsertPack::x_v_omega(int ninsert_this_local,int &ninserted_this_local,
 
 
 
+/* ----------------------------------------------------------------------
+   take insertion positions from the slots of the cached packing tile
+   slots are kept at least one slot radius away from the subdomain
+   borders, so they cannot overlap slots used by neighbor procs
+   with overlap check, inserted particles are added to the neighbor list
+   and so are seen by later slots and the random insertion that follows
+------------------------------------------------------------------------- */
+
+void FixInsertPack::x_v_omega_tiles(int ninsert_this_local,int &ninserted_this_local, int &ninserted_spheres_this_local, double &mass_inserted_this_local)
+{
+    // same transform on all procs, so that the tiling is consistent
+    tile_cache->randomTransform(randomAll);
+
+    BoundingBox bb(ins_region->extent_xlo, ins_region->extent_xhi,
+                   ins_region->extent_ylo, ins_region->extent_yhi,
+                   ins_region->extent_zlo, ins_region->extent_zhi);
+    bb.shrinkToSubbox(domain->sublo, domain->subhi);
+
+    std::vector<double> slots;
+    tile_cache->getSlotPositions(bb,slots);
+
+    // visit slots in random order
+    int const nslots = slots.size()/3;
+    std::vector<int> order(nslots);
+    for(int i = 0; i < nslots; i++)
+        order[i] = i;
+    for(int i = nslots-1; i > 0; i--)
+    {
+        int j = static_cast<int>(static_cast<double>(i+1)*random->uniform());
+        if(j > i) j = i;
+        std::swap(order[i],order[j]);
+    }
+
+    double const rslot = tile_cache->slotRadius();
+
+    double v_toInsert[3];
+    ParticleToInsert *pti;
+
+    for(int islot = 0; islot < nslots && ninserted_this_local < ninsert_this_local; islot++)
+    {
+        double *pos = &slots[3*order[islot]];
+
+        if(domain->dist_subbox_borders(pos) < rslot) continue;
+
+        if(all_in_flag)
+        {
+            if(!ins_region->match_shrinkby_cut(pos,rslot)) continue;
+        }
+        else if(!ins_region->match(pos[0],pos[1],pos[2])) continue;
+
+        pti = fix_distribution->pti_list[ninserted_this_local];
+
+        vectorCopy3D(v_insert,v_toInsert);
+        generate_random_velocity(v_toInsert);
+
+        if(quat_random_)
+            MathExtraLiggghts::random_unit_quat(random,quat_insert);
+
+        int nins = 0;
+        if(check_ol_flag)
+            nins = pti->check_near_set_x_v_omega(pos,v_toInsert,omega_insert,quat_insert,neighList);
+        else
+            nins = pti->set_x_v_omega(pos,v_toInsert,omega_insert,quat_insert);
+
+        if(nins > 0)
+        {
+            ninserted_spheres_this_local += nins;
+            mass_inserted_this_local += pti->mass_ins;
+            ninserted_this_local++;
+        }
+    }
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixInsertPack::restart(char *buf)
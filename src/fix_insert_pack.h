@@ -35,6 +35,7 @@ FixStyle(insert/pack,FixInsertPack)
 #define LMP_FIX_INSERT_PACK_H
 
 #include "fix_insert.h"
+#include "packing_tile_cache.h"
 
 namespace LAMMPS_NS {
 
@@ -57,6 +58,7 @@ class FixInsertPack : public FixInsert {
   virtual int calc_ninsert_this();
   virtual int calc_maxtry(int);
   void x_v_omega(int,int&,int&,double&);
+  void x_v_omega_tiles(int,int&,int&,double&);
   double insertion_fraction();
 
   int is_nearby(int);
@@ -89,6 +91,11 @@ class FixInsertPack : public FixInsert {
   // warn if region extends outside box
   bool warn_region;
 
+  // cached packing tiles used to generate insertion positions
+  LIGGGHTS::PackingTileCache *tile_cache;
+  char *tile_filename;
+  double tile_fill_fraction;
+
 };
 
 }
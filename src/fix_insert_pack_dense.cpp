@@ -37,6 +37,8 @@
 #include "modify.h"
 #include "error.h"
 #include "domain.h"
+#include "comm.h"
+#include "atom.h"
 #include "fix_particledistribution_discrete.h"
 #include "fix_property_atom.h"
 #include "input.h"
@@ -78,6 +80,8 @@ FixInsertPackDense::FixInsertPackDense(LAMMPS *lmp, int narg, char **arg) :
   insertion_done(false),
   is_inserter(true),
   insert_every(0),
+  fill_interfaces(true),
+  interface_phase(false),
   n_inserted(0),
   n_inserted_local(0),
   property_name(NULL),
@@ -148,6 +152,16 @@ FixInsertPackDense::FixInsertPackDense(LAMMPS *lmp, int narg, char **arg) :
       fix_property_ivalue = static_cast<int>(fix_property_value);
       iarg += 3;
       hasargs = true;
+    } else if (strcmp(arg[iarg],"fill_interfaces") == 0) {
+      if (iarg+2 > narg) error->fix_error(FLERR,this,"");
+      if (strcmp(arg[iarg+1],"yes") == 0)
+        fill_interfaces = true;
+      else if (strcmp(arg[iarg+1],"no") == 0)
+        fill_interfaces = false;
+      else
+        error->fix_error(FLERR,this,"expecting 'yes' or 'no' after 'fill_interfaces'");
+      iarg += 2;
+      hasargs = true;
     }
   }
 
@@ -343,6 +357,11 @@ void FixInsertPackDense::pre_exchange()
     }
   }
 
+  // close the gaps between the fronts of neighboring subdomains
+  if (fill_interfaces && (comm->nprocs > 1 || domain->xperiodic ||
+                          domain->yperiodic || domain->zperiodic))
+    fill_subdomain_interfaces();
+
   // actual insertion
   fix_distribution->pre_insert(n_inserted_local,fix_property,fix_property_value,property_index,fix_property_ivalue,property_iindex);
 
@@ -538,6 +557,268 @@ void FixInsertPackDense::handle_next_front_sphere()
   frontSpheres.pop();
 }
 
+/* ----------------------------------------------------------------------
+   each process grows its front only within its subdomain shrunk by
+   maxrad, which leaves a gap at every subdomain interface. In this
+   second phase the gaps are closed: processes are colored by the
+   parity of their location in the processor grid, so that no two
+   adjacent processes fill at the same time. a periodic dimension with
+   an odd # of procs > 1 needs a third color for its last proc. in a
+   periodic dimension with a single proc, the lo and hi faces are images
+   of each other, so the subdomain is split in two halves which are
+   filled with different colors. Spheres close to the subdomain
+   boundaries are communicated to the neighbor procs after each color
+   and serve as front for the processes that follow.
+------------------------------------------------------------------------- */
+
+void FixInsertPackDense::fill_subdomain_interfaces()
+{
+  // largest radius present in the region determines bin size and halo
+  double rad_max_present = fix_distribution->max_rad();
+  for (int i=0; i<atom->nlocal; i++) {
+    if (atom->radius[i] > rad_max_present &&
+        ins_region->match_expandby_cut(atom->x[i],atom->radius[i]))
+      rad_max_present = atom->radius[i];
+  }
+  MPI_Max_Scalar(rad_max_present,world);
+
+  double const neigh_rad = rad_max_present*radius_factor;
+  double const halo = 4.*neigh_rad;
+
+  // spheres are passed on to the adjacent procs only, so the halo
+  // must not reach beyond the adjacent subdomains
+  // a split dimension needs a halo between the two halves and its images
+  int too_small = 0;
+  for (int i=0; i<3; ++i) {
+    bool const split = domain->periodicity[i] && comm->procgrid[i] == 1;
+    double const min_size = split ? 2.*halo : halo;
+    if ((split || comm->procgrid[i] > 1) && domain->subhi[i]-domain->sublo[i] < min_size)
+      too_small = 1;
+  }
+  MPI_Max_Scalar(too_small,world);
+  if (too_small)
+    error->fix_error(FLERR,this,"subdomain too small for 'fill_interfaces', use 'fill_interfaces no'");
+
+  // centers of inserted particles must lie within the own subdomain,
+  // shrink only at non-periodic boundaries of the simulation domain
+  double sublo[3],subhi[3];
+  for (int i=0; i<3; ++i) {
+    sublo[i] = domain->sublo[i];
+    subhi[i] = domain->subhi[i];
+    if (domain->periodicity[i]) continue;
+    if (sublo[i] <= domain->boxlo[i]) sublo[i] += maxrad;
+    if (subhi[i] >= domain->boxhi[i]) subhi[i] -= maxrad;
+  }
+  fill_bbox = BoundingBox(ins_region->extent_xlo,ins_region->extent_xhi,
+                          ins_region->extent_ylo,ins_region->extent_yhi,
+                          ins_region->extent_zlo,ins_region->extent_zhi);
+  fill_bbox.shrinkToSubbox(sublo,subhi);
+
+  // particles within the halo may interact with particles inserted here
+  double halolo[3],halohi[3];
+  for (int i=0; i<3; ++i) {
+    halolo[i] = domain->sublo[i]-halo;
+    halohi[i] = domain->subhi[i]+halo;
+  }
+  BoundingBox halo_bbox(ins_region->extent_xlo-halo,ins_region->extent_xhi+halo,
+                        ins_region->extent_ylo-halo,ins_region->extent_yhi+halo,
+                        ins_region->extent_zlo-halo,ins_region->extent_zhi+halo);
+  halo_bbox.shrinkToSubbox(halolo,halohi);
+
+  bool const has_fill_volume = fill_bbox.hasVolume();
+
+  neighlist.reset();
+  distfield.reset();
+  while (!frontSpheres.empty()) frontSpheres.pop();
+
+  if (has_fill_volume) {
+    neighlist.setBoundingBox(halo_bbox,neigh_rad);
+    distfield.build(ins_region,fill_bbox,fix_distribution->max_rad()*radius_factor);
+  }
+
+  // spheres closer than halo to a subdomain boundary are communicated
+  double innerlo[3],innerhi[3];
+  for (int i=0; i<3; ++i) {
+    innerlo[i] = domain->sublo[i]+halo;
+    innerhi[i] = domain->subhi[i]-halo;
+  }
+  BoundingBox inner_bbox(innerlo[0],innerhi[0],innerlo[1],innerhi[1],innerlo[2],innerhi[2]);
+
+  // per sphere: position, radius, type, front flag
+  std::vector<double> sendbuf;
+
+  for (int i=0; i<atom->nlocal; i++) {
+    if (!ins_region->match_expandby_cut(atom->x[i],atom->radius[i]))
+      continue;
+    if (has_fill_volume && halo_bbox.isInside(atom->x[i]))
+      neighlist.insert(atom->x[i],atom->radius[i],atom->type[i]);
+    if (!inner_bbox.isInside(atom->x[i])) {
+      sendbuf.insert(sendbuf.end(),atom->x[i],atom->x[i]+3);
+      sendbuf.push_back(atom->radius[i]);
+      sendbuf.push_back(atom->type[i]);
+      sendbuf.push_back(0.);
+    }
+  }
+
+  for (FixParticledistributionDiscrete::pti_list_type::iterator it = fix_distribution->pti_list.begin();
+       it != fix_distribution->pti_list.end(); ++it) {
+    Particle p = particle_from_pti(*it);
+    p.radius *= radius_factor;
+    if (has_fill_volume)
+      neighlist.insert(p.x,p.radius,p.type);
+    if (!inner_bbox.isInside(p.x)) {
+      if (has_fill_volume)
+        frontSpheres.push(p);
+      sendbuf.insert(sendbuf.end(),p.x,p.x+3);
+      sendbuf.push_back(p.radius);
+      sendbuf.push_back(p.type);
+      sendbuf.push_back(1.);
+    }
+  }
+
+  exchange_interface_spheres(sendbuf,halo_bbox,halo);
+
+  // color by parity of grid location, the last proc of a periodic
+  // dimension with odd # of procs would share the color of its neighbor
+  // proc 0 and gets a third one
+  // a periodic dimension with a single proc is its own neighbor, its
+  // lower half is filled with color 0 and its upper half with color 1
+  int my_color[3];
+  int ncol[3];
+  bool split[3];
+  int ncolors = 1;
+  for (int i=0; i<3; ++i) {
+    int const np = comm->procgrid[i];
+    int const loc = comm->myloc[i];
+    split[i] = domain->periodicity[i] && np == 1;
+    ncol[i] = (domain->periodicity[i] && np > 1 && np % 2) ? 3 : 2;
+    my_color[i] = (ncol[i] == 3 && loc == np-1) ? 2 : (loc & 1);
+    ncolors *= ncol[i];
+  }
+  int const n_inserted_before = n_inserted_local;
+
+  interface_phase = true;
+
+  for (int color = 0; color < ncolors; ++color) {
+    sendbuf.clear();
+
+    // decode color per dimension, x varies fastest
+    bool active = has_fill_volume;
+    double partlo[3],parthi[3];
+    for (int i=0, c=color; i<3; c /= ncol[i], ++i) {
+      int const col = c % ncol[i];
+      double const mid = 0.5*(domain->sublo[i]+domain->subhi[i]);
+      partlo[i] = (split[i] && col == 1) ? mid : domain->sublo[i];
+      parthi[i] = (split[i] && col == 0) ? mid : domain->subhi[i];
+      if (!split[i] && col != my_color[i])
+        active = false;
+    }
+
+    if (active) {
+      size_t const n_pti_before = fix_distribution->pti_list.size();
+
+      part_bbox = fill_bbox;
+      part_bbox.shrinkToSubbox(partlo,parthi);
+
+      // the front may also be needed by a later part of this subdomain
+      std::queue<Particle> front(frontSpheres);
+
+      while (!frontSpheres.empty())
+        handle_next_front_sphere();
+
+      frontSpheres.swap(front);
+
+      for (size_t i = n_pti_before; i < fix_distribution->pti_list.size(); ++i) {
+        Particle p = particle_from_pti(fix_distribution->pti_list[i]);
+        p.radius *= radius_factor;
+        frontSpheres.push(p);
+        sendbuf.insert(sendbuf.end(),p.x,p.x+3);
+        sendbuf.push_back(p.radius);
+        sendbuf.push_back(p.type);
+        sendbuf.push_back(1.);
+      }
+    }
+
+    exchange_interface_spheres(sendbuf,halo_bbox,halo);
+  }
+
+  interface_phase = false;
+
+  while (!frontSpheres.empty()) frontSpheres.pop();
+
+  int n_inserted_interfaces = n_inserted_local-n_inserted_before;
+  MPI_Sum_Scalar(n_inserted_interfaces,world);
+  if (comm->me == 0 && screen)
+    fprintf(screen,"inserted %d particles at subdomain interfaces\n",n_inserted_interfaces);
+}
+
+/* ----------------------------------------------------------------------
+   pass interface spheres to the neighbor procs, staged in x, y and z as
+   in Comm::borders() so that edge and corner neighbors are reached
+   positions are shifted when crossing a periodic boundary
+   received spheres inside the own halo are added to the neighbor list,
+   those flagged also to the front
+------------------------------------------------------------------------- */
+
+void FixInsertPackDense::exchange_interface_spheres(std::vector<double> &sendbuf,
+                                                    BoundingBox &halo_bbox,
+                                                    double halo)
+{
+  std::vector<double> buf(sendbuf);
+  std::vector<double> send,recv,received;
+
+  for (int dim = 0; dim < 3; ++dim) {
+    size_t const nbuf = buf.size();
+
+    for (int dir = 0; dir < 2; ++dir) {
+      send.clear();
+
+      // nothing crosses a non-periodic boundary of the domain
+      bool const at_boundary = (dir == 0) ? (comm->myloc[dim] == 0)
+                                          : (comm->myloc[dim] == comm->procgrid[dim]-1);
+      if (!at_boundary || domain->periodicity[dim]) {
+        double const shift = !at_boundary ? 0. :
+                             ((dir == 0) ? domain->prd[dim] : -domain->prd[dim]);
+        for (size_t i = 0; i < nbuf; i += 6) {
+          double const xd = buf[i+dim];
+          if ((dir == 0 && xd < domain->sublo[dim]+halo) ||
+              (dir == 1 && xd >= domain->subhi[dim]-halo)) {
+            send.insert(send.end(),buf.begin()+i,buf.begin()+i+6);
+            send[send.size()-6+dim] += shift;
+          }
+        }
+      }
+
+      int const sendproc = comm->procneigh[dim][dir];
+      int const recvproc = comm->procneigh[dim][1-dir];
+      int nsend = send.size();
+      int nrecv = 0;
+      MPI_Sendrecv(&nsend,1,MPI_INT,sendproc,0,&nrecv,1,MPI_INT,recvproc,0,
+                   world,MPI_STATUS_IGNORE);
+      recv.resize(nrecv);
+      MPI_Sendrecv(nsend ? &send[0] : NULL,nsend,MPI_DOUBLE,sendproc,0,
+                   nrecv ? &recv[0] : NULL,nrecv,MPI_DOUBLE,recvproc,0,
+                   world,MPI_STATUS_IGNORE);
+
+      // received spheres are passed on in the following dimensions
+      buf.insert(buf.end(),recv.begin(),recv.end());
+      received.insert(received.end(),recv.begin(),recv.end());
+    }
+  }
+
+  if (fill_bbox.hasVolume()) {
+    for (size_t i = 0; i < received.size(); i += 6) {
+      double const *xs = &received[i];
+      if (!halo_bbox.isInside(xs))
+        continue;
+      Particle p(xs,received[i+3],static_cast<int>(received[i+4]));
+      neighlist.insert(p.x,p.radius,p.type);
+      if (received[i+5] > 0.5)
+        frontSpheres.push(p);
+    }
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixInsertPackDense::generate_initial_config(ParticleToInsert *&p1,
@@ -719,13 +1000,18 @@ Particle FixInsertPackDense::particle_from_pti(ParticleToInsert* pti)
 
 bool FixInsertPackDense::is_completely_in_subregion(Particle &p)
 {
+  // distfield covers the whole subdomain, only part of it is filled at once
+  if(interface_phase && !part_bbox.isInside(p.x))
+    return false;
+
   if(distfield.isInside(p.x))
     return true;
   if(distfield.isOutside(p.x))
     return false;
 
   // position was either not found or is in boundary cell of distfield
-  return ins_bbox.isInside(p.x) && ins_region->match_shrinkby_cut(p.x,p.radius);
+  BoundingBox &bbox = interface_phase ? fill_bbox : ins_bbox;
+  return bbox.isInside(p.x) && ins_region->match_shrinkby_cut(p.x,p.radius);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -36,6 +36,7 @@ FixStyle(insert/pack/dense,FixInsertPackDense)
 #include "fix.h"
 
 #include <queue>
+#include <vector>
 
 #include "region_neighbor_list.h"
 #include "region_distance_field.h"
@@ -104,12 +105,22 @@ protected:
   int insert_every, most_recent_ins_step;
   double radius_factor;
 
+  // second phase closing the gaps left between subdomains
+  bool fill_interfaces;
+  bool interface_phase;
+  BoundingBox fill_bbox;
+  BoundingBox part_bbox; // part of fill_bbox filled in the current color
+
   bool prepare_insertion();
 
   bool insert_first_particles(); // returns false if no insertion possible
 
   void handle_next_front_sphere();
 
+  void fill_subdomain_interfaces();
+  void exchange_interface_spheres(std::vector<double> &sendbuf,
+                                  BoundingBox &halo_bbox,double halo);
+
   void compute_and_append_candidate_points(LIGGGHTS::Particle const &p1,
                                            LIGGGHTS::Particle const &p2,
                                            LIGGGHTS::Particle const &p3,
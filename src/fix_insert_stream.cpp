@@ -195,6 +195,8 @@ void FixInsertStream::init_defaults()
 
     duration = 0;
 
+    dt_insert = 0.;
+
     parallel = false;
 
     ntry_mc = 100000;
@@ -285,6 +287,7 @@ void FixInsertStream::calc_insertion_properties()
       error->fix_error(FLERR,this,"must not provide both 'extrude_length' and 'duration'");
 
     dt = update->dt;
+    dt_insert = dt;
 
     // if extrude_length given, calculate insert_every
     if(insert_every == -1)
@@ -922,6 +925,81 @@ void FixInsertStream::reset_timestep(bigint newstep,bigint oldstep)
     reset_releasedata(newstep,oldstep);
 }
 
+/* ----------------------------------------------------------------------
+   time-step size changed, e.g. by fix dt/reset/gran
+   keep the extrusion geometry and flow rate, rescale the insertion
+   interval and the release step of particles not released yet
+------------------------------------------------------------------------- */
+
+void FixInsertStream::reset_dt()
+{
+    double dt = update->dt;
+
+    // insertion properties not calculated yet, will use new dt
+    if(dt_insert == 0. || dt == dt_insert) return;
+
+    //NP release of multisphere bodies is computed by fix multisphere
+    if(fix_multisphere)
+        error->fix_error(FLERR,this,"can not change time-step with multisphere particles");
+
+    double ratio = dt_insert/dt;
+    double vmag = vectorMag3D(v_normal);
+    bigint step = update->ntimestep;
+
+    // extrude_length given: insert_every follows from it
+    // insert_every given: scale it, duration keeps extrude_length
+    if(duration == 0)
+    {
+        insert_every = static_cast<int>((extrude_length+FIX_INSERT_STREAM_TINY)/(dt*vmag));
+        if(insert_every == 0)
+          error->fix_error(FLERR,this,"insertion velocity too high or extrude_length too low for new time-step");
+    }
+    else
+    {
+        duration = static_cast<int>((extrude_length+FIX_INSERT_STREAM_TINY)/(dt*vmag));
+        insert_every = MAX(static_cast<int>(insert_every*ratio+0.5),duration);
+        if(duration == 0)
+          error->fix_error(FLERR,this,"'insert_every' too small for new time-step");
+    }
+
+    ninsert_per = nflowrate*(static_cast<double>(insert_every)*dt);
+
+    if(next_reneighbor > step)
+        next_reneighbor = step + MAX(static_cast<bigint>((next_reneighbor-step)*ratio+0.5),1);
+
+    dt_insert = dt;
+
+    // particles travelling through the extruded volume:
+    //   restart constant-velocity integration from current position
+    //NP release data is shared, so only the integrator does this
+
+    if(!i_am_integrator) return;
+
+    int nlocal = atom->nlocal;
+    double **x = atom->x;
+    double **release_data = fix_release->array_atom;
+
+    for(int i = 0; i < nlocal; i++)
+    {
+        if(release_data[i][3] == 0.) continue;
+
+        bigint r_step = static_cast<bigint>(release_data[i][4]+FIX_INSERT_STREAM_TINY);
+        if(r_step <= step) continue;
+
+        vectorCopy3D(x[i],release_data[i]);
+        release_data[i][3] = static_cast<double>(step);
+        release_data[i][4] = static_cast<double>(step + MAX(static_cast<bigint>((r_step-step)*ratio+0.5),1));
+    }
+}
+
+/* ---------------------------------------------------------------------- */
+
+double FixInsertStream::max_timestep()
+{
+    if(dt_insert == 0. || extrude_length <= 0.) return 0.;
+    return extrude_length/vectorMag3D(v_normal);
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixInsertStream::reset_releasedata(bigint newstep,bigint oldstep)
@@ -56,6 +56,11 @@ class FixInsertStream : public FixInsert {
   void init_defaults();
 
   virtual void reset_timestep(bigint newstep,bigint oldstep);
+  virtual void reset_dt();
+
+  // largest time-step size for which inserted particles travel
+  //   at most the extrusion length between two insertions
+  double max_timestep();
 
   void register_tracer_callback(class FixPropertyAtomTracerStream* tr);
 
@@ -100,6 +105,7 @@ class FixInsertStream : public FixInsert {
   double p_ref[3];         // reference point on face
   int face_style;
   double v_normal[3];      // insertion velocity projected on face
+  double dt_insert;        // time-step size insertion properties refer to
   double ins_fraction;
   bool do_ins_fraction_calc;
 
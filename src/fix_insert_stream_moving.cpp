@@ -328,6 +328,15 @@ void FixInsertStreamMoving::end_of_step()
 
 /* ---------------------------------------------------------------------- */
 
+void FixInsertStreamMoving::reset_dt()
+{
+    //NP release data refers to the moving face, can not rescale it
+    if(dt_insert != 0. && update->dt != dt_insert)
+        error->fix_error(FLERR,this,"can not change time-step with a moving insertion face");
+}
+
+/* ---------------------------------------------------------------------- */
+
 void FixInsertStreamMoving::reset_releasedata(bigint newstep,bigint oldstep)
 {
   //NP need to reset releasedata in case of restart, since
@@ -41,6 +41,7 @@ class FixInsertStreamMoving : public FixInsertStream {
 
   virtual void init();
   virtual void end_of_step();
+  void reset_dt();
 
   virtual int release_step_index()
   { return 6; }
@@ -387,6 +387,9 @@ void FixMassflowMesh::post_integrate()
     TriMesh *mesh = fix_mesh_->triMesh();
     int nTriAll = mesh->sizeLocal() + mesh->sizeGhost();
 
+    //NP rigid frame: counting needs the current position of the faces
+    mesh->materialize();
+
     // update time for counter
     // also store values for last invokation
     t_count_ += update->dt;
@@ -605,6 +605,9 @@ void FixMassflowMeshFace::post_integrate()
     TriMesh *mesh = fix_mesh_->triMesh();
     int nTriAll = mesh->sizeLocal() + mesh->sizeGhost();
 
+    //NP rigid frame: counting needs the current position of the faces
+    mesh->materialize();
+
     ScalarContainer<int> *tri_face_ids = mesh->prop().getElementProperty<ScalarContainer<int> >("face_id");
     int nfaceids = faceid2index_.size();
 
@@ -400,6 +400,9 @@ void FixMesh::setup_pre_force(int vflag)
     //NP copy node_orig_ is necessary if a second fix move/mesh is added
     else
     {
+        //NP rigid frame: nodes must be at their current position
+        //NP before they are stored as node_orig_
+        mesh_->materialize();
         mesh_->pbcExchangeBorders(1);
     }
 
@@ -455,6 +458,10 @@ void FixMesh::pre_force(int vflag)
     // case re-neigh step
     if(pOpFlag_)
     {
+        //NP rigid frame: nodes are brought to their current position
+        //NP on re-neigh steps only
+        mesh_->materialize();
+
         //NP invoke comm
         //NP also does equivalent of forward comm
         mesh_->pbcExchangeBorders(0);
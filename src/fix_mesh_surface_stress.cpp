@@ -37,6 +37,7 @@
 #include "math_extra.h"
 #include "fix_property_global.h"
 #include "fix_gravity.h"
+#include "memory.h"
 
 using namespace LAMMPS_NS;
 using namespace FixConst;
@@ -57,7 +58,11 @@ FixMeshSurfaceStress::FixMeshSurfaceStress(LAMMPS *lmp, int narg, char **arg)
   wear_flag_(0),
   k_finnie_(0),
   wear_(0),
-  wear_step_(0)
+  wear_step_(0),
+  f_reduce_(0),
+  wear_step_reduce_(0),
+  f_total_thr_(0),
+  torque_total_thr_(0)
 {
     vectorZeroize3D(f_total_);
     vectorZeroize3D(torque_total_);
@@ -120,7 +125,8 @@ FixMeshSurfaceStress::FixMeshSurfaceStress(LAMMPS *lmp, int narg, char **arg)
 
 FixMeshSurfaceStress::~FixMeshSurfaceStress()
 {
-
+    memory->destroy(f_total_thr_);
+    memory->destroy(torque_total_thr_);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -212,6 +218,21 @@ void FixMeshSurfaceStress::init()
         sigma_t_ = mesh()->prop().getElementProperty<ScalarContainer<double> >("sigma_t");
         if(!f_ || !sigma_n_ || !sigma_t_)
             error->one(FLERR,"Internal error");
+
+        //NP threads of fix wall/gran/omp add to the same elements
+        f_reduce_ = mesh()->prop().addReductionTarget("f");
+        memory->destroy(f_total_thr_);
+        memory->destroy(torque_total_thr_);
+        if(f_reduce_)
+        {
+            memory->create(f_total_thr_,f_reduce_->nThreads(),3,"FixMeshSurfaceStress:f_total_thr_");
+            memory->create(torque_total_thr_,f_reduce_->nThreads(),3,"FixMeshSurfaceStress:torque_total_thr_");
+            for(int tid = 0; tid < f_reduce_->nThreads(); tid++)
+            {
+                vectorZeroize3D(f_total_thr_[tid]);
+                vectorZeroize3D(torque_total_thr_[tid]);
+            }
+        }
     }
 
     if(wear_flag_)
@@ -221,6 +242,8 @@ void FixMeshSurfaceStress::init()
         wear_step_ = mesh()->prop().getElementProperty<ScalarContainer<double> >("wear_step");
         if(!wear_ || ! wear_step_)
             error->one(FLERR,"Internal error");
+
+        wear_step_reduce_ = mesh()->prop().addReductionTarget("wear_step");
     }
 }
 
@@ -249,6 +272,15 @@ void FixMeshSurfaceStress::pre_force(int vflag)
     {
         vectorZeroize3D(f_total_);
         vectorZeroize3D(torque_total_);
+
+        if(f_reduce_)
+        {
+            for(int tid = 0; tid < f_reduce_->nThreads(); tid++)
+            {
+                vectorZeroize3D(f_total_thr_[tid]);
+                vectorZeroize3D(torque_total_thr_[tid]);
+            }
+        }
     }
 
     /*NL*/ //if (screen) fprintf(screen,"force on tri0: %f %f %f\n",f(0)[0],f(0)[2],f(0)[2]);
@@ -258,14 +290,38 @@ void FixMeshSurfaceStress::pre_force(int vflag)
 
 void FixMeshSurfaceStress::final_integrate()
 {
+    reduce_thread_contributions();
+
     //NP wear_step is communicated by reverse comm
     FixMeshSurface::final_integrate();
 
     calc_total_force();
 }
 
+/* ----------------------------------------------------------------------
+   add per-thread contributions to per-element and total values
+   per-element reduction targets of derived classes are merged as well
+------------------------------------------------------------------------- */
+
+void FixMeshSurfaceStress::reduce_thread_contributions()
+{
+    mesh()->prop().reduceThreadBuffers();
+
+    if(f_reduce_)
+    {
+        for(int tid = 0; tid < f_reduce_->nThreads(); tid++)
+        {
+            vectorAdd3D(f_total_,f_total_thr_[tid],f_total_);
+            vectorAdd3D(torque_total_,torque_total_thr_[tid],torque_total_);
+            vectorZeroize3D(f_total_thr_[tid]);
+            vectorZeroize3D(torque_total_thr_[tid]);
+        }
+    }
+}
+
 /* ----------------------------------------------------------------------
    called during wall force calc
+   may be called by several threads concurrently, for different particles
 ------------------------------------------------------------------------- */
 
 void FixMeshSurfaceStress::add_particle_contribution(int ip,double *frc,
@@ -289,16 +345,22 @@ void FixMeshSurfaceStress::add_particle_contribution(int ip,double *frc,
         /*NL*/ //if(screen && strcmp(id,"servo")==0) printVec3D(screen,"added force",frc);
         /*NL*/ //if(screen) fprintf(screen,"step " BIGINT_FORMAT ", added force %f %f %f\n",update->ntimestep,frc[0],frc[1],frc[2]);
 
+        //NP threads add to their own buffers, merged in final_integrate()
+        const int tid = f_reduce_ ? ReductionBuffer::threadNum() : 0;
+        double *fTri = f_reduce_ ? f_reduce_->get(tid,iTri) : f(iTri);
+        double *fTotal = f_reduce_ ? f_total_thr_[tid] : f_total_;
+        double *torqueTotal = f_reduce_ ? torque_total_thr_[tid] : torque_total_;
+
         // add contribution to triangle force
-        vectorAdd3D(f(iTri),frc,f(iTri));
+        vectorAdd3D(fTri,frc,fTri);
 
         // add contribution to total body force and torque
-        vectorAdd3D(f_total_,frc,f_total_);
+        vectorAdd3D(fTotal,frc,fTotal);
         vectorSubtract3D(contactPoint,p_ref_(0),tmp);
         /*NL*/ //if (screen) fprintf(screen,"p_ref_ %f %f %f\n",p_ref_(0)[0],p_ref_(0)[1],p_ref_(0)[2]);
         /*NL*/ //if (screen) fprintf(screen,"tmp %f %f %f\n",tmp[0],tmp[1],tmp[2]);
         vectorCross3D(tmp,frc,tmp2); // tmp2 is torque contrib
-        vectorAdd3D(torque_total_,tmp2,torque_total_);
+        vectorAdd3D(torqueTotal,tmp2,torqueTotal);
     }
 
     // add wear if applicable
@@ -319,6 +381,8 @@ void FixMeshSurfaceStress::add_particle_contribution(int ip,double *frc,
         // get surface normal
         //NP surface normal is normalized
         triMesh()->surfaceNorm(iTri,surfNorm);
+        if(triMesh()->rigidFrame())
+            triMesh()->vectorFromFrame(surfNorm);
 
         // return if no relative velocity
         if(0.0000001 > v_rel_mag)
@@ -360,7 +424,10 @@ void FixMeshSurfaceStress::add_particle_contribution(int ip,double *frc,
         //NP if (screen) fprintf(screen," k_finnie %f, vmag%f, frcmag %f ,wear %1.15f\n",k_finnie[atom_type_wall-1][atom->type[ip]-1],vmag,vectorMag3D(frc),E);
         //NP error->all("wear");
 
-        wear_step(iTri) += E*update->dt / triMesh()->areaElem(iTri);
+        if(wear_step_reduce_)
+            *wear_step_reduce_->get(ReductionBuffer::threadNum(),iTri) += E*update->dt / triMesh()->areaElem(iTri);
+        else
+            wear_step(iTri) += E*update->dt / triMesh()->areaElem(iTri);
     }
 }
 
@@ -417,6 +484,8 @@ void FixMeshSurfaceStress::calc_total_force()
         {
             // get element surface norm and area
             triMesh()->surfaceNorm(i,surfNorm);
+            if(triMesh()->rigidFrame())
+                triMesh()->vectorFromFrame(surfNorm);
             invSurfArea = 1./triMesh()->areaElem(i);
 
             // calculate normal force
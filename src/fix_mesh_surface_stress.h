@@ -65,6 +65,10 @@ namespace LAMMPS_NS
         void add_global_external_contribution(double *frc);
         void add_global_external_contribution(double *frc,double *trq);
 
+        // merge per-thread contributions, called before reverse comm
+        // and by the walls at the end of setup
+        void reduce_thread_contributions();
+
         // inline access
 
         inline bool trackWear()
@@ -146,6 +150,12 @@ namespace LAMMPS_NS
         double const* const* k_finnie_;
         ScalarContainer<double> *wear_;
         ScalarContainer<double> *wear_step_;
+
+        // per-thread accumulation if wall forces are computed by threads
+        //NP NULL if running with one thread
+        class ReductionBuffer *f_reduce_;
+        class ReductionBuffer *wear_step_reduce_;
+        double **f_total_thr_, **torque_total_thr_;
   };
 
 } /* namespace LAMMPS_NS */
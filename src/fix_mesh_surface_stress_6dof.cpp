@@ -407,6 +407,17 @@ void FixMeshSurfaceStress6DOF::init()
 
 /* ---------------------------------------------------------------------- */
 
+void FixMeshSurfaceStress6DOF::reset_dt()
+{
+    dtv_ = update->dt;
+    dtf_ = 0.5 * update->dt * force->ftm2v;
+    dtfm_ = dtf_ / mass_(0);
+
+    dtq_ = 0.5 * update->dt;
+}
+
+/* ---------------------------------------------------------------------- */
+
 void FixMeshSurfaceStress6DOF::setup_pre_force(int vflag)
 {
     FixMeshSurfaceStress::setup_pre_force(vflag);
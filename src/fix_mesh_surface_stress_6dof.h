@@ -46,6 +46,7 @@ class FixMeshSurfaceStress6DOF : public FixMeshSurfaceStress {
       virtual void post_create();
 
       void init();
+      void reset_dt();
       virtual void setup(int vflag);
       virtual void setup_pre_force(int vflag);
 
@@ -43,6 +43,8 @@ using namespace FixConst;
 FixMeshSurfaceStressContact::FixMeshSurfaceStressContact(LAMMPS *lmp, int narg, char **arg)
 : FixMeshSurfaceStress(lmp, narg, arg),
   fix_wallcontacttime_(0),
+  contact_area_step_reduce_(0),
+  contact_area_step_abs_reduce_(0),
   T_(0.),
   step_ave_start_(-1),
   area_correction_(false),
@@ -145,6 +147,10 @@ void FixMeshSurfaceStressContact::init()
     if(!contact_area_ || !contact_area_step_ || !contact_area_abs_ || !contact_area_step_abs_)
         error->one(FLERR,"internal error");
 
+    //NP merged along with the forces in FixMeshSurfaceStress::final_integrate()
+    contact_area_step_reduce_ = mesh()->prop().addReductionTarget("contact_area_step");
+    contact_area_step_abs_reduce_ = mesh()->prop().addReductionTarget("contact_area_step_abs");
+
     if(force->cg() > 1.)
         error->fix_error(FLERR,this,"does not support coarse-graining");
 }
@@ -234,8 +240,17 @@ void FixMeshSurfaceStressContact::add_particle_contribution(int ip,double *frc,
 
     double Acont = (radius*radius-rsq)*M_PI; //contact area sphere-wall
 
-    contactAreaStep(iTri) += Acont / triMesh()->areaElem(iTri);
-    contactAreaStepAbs(iTri) += Acont;
+    if(contact_area_step_reduce_)
+    {
+        const int tid = ReductionBuffer::threadNum();
+        *contact_area_step_reduce_->get(tid,iTri) += Acont / triMesh()->areaElem(iTri);
+        *contact_area_step_abs_reduce_->get(tid,iTri) += Acont;
+    }
+    else
+    {
+        contactAreaStep(iTri) += Acont / triMesh()->areaElem(iTri);
+        contactAreaStepAbs(iTri) += Acont;
+    }
     fix_wallcontacttime_->vector_atom[ip] += dt;
 }
 
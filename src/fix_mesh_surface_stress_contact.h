@@ -76,6 +76,10 @@ namespace LAMMPS_NS
         ScalarContainer<double> *contact_area_step_;
         ScalarContainer<double> *contact_area_step_abs_;
 
+        // per-thread accumulation, NULL if running with one thread
+        class ReductionBuffer *contact_area_step_reduce_;
+        class ReductionBuffer *contact_area_step_abs_reduce_;
+
         //NP time for averaging
         double T_;
 
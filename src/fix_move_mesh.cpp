@@ -47,7 +47,8 @@ FixMoveMesh::FixMoveMesh(LAMMPS *lmp, int narg, char **arg)
     move_(0),
     mesh_(0),
     time_(0),
-    time_since_setup_(0)
+    time_since_setup_(0),
+    rigid_frame_(false)
 {
     vectorZeroize3D(reference_point_);
 
@@ -64,11 +65,26 @@ FixMoveMesh::FixMoveMesh(LAMMPS *lmp, int narg, char **arg)
         error->all(FLERR,"Illegal fix move/mesh command, illegal mesh ID provided");
 
     mesh_ = fix_mesh_->mesh();
-    move_ = createMeshMover(lmp,mesh_,this,&arg[iarg],narg-iarg);
+
+    //NP optional trailing keyword, not seen by the mesh mover
+    int nmove = narg-iarg;
+    if(nmove >= 2 && strcmp(arg[narg-2],"rigid_frame") == 0)
+    {
+        if(strcmp(arg[narg-1],"yes") == 0)
+            rigid_frame_ = true;
+        else if(strcmp(arg[narg-1],"no"))
+            error->all(FLERR,"Illegal fix move/mesh command, expecting 'yes' or 'no' after keyword 'rigid_frame'");
+        nmove -= 2;
+    }
+
+    move_ = createMeshMover(lmp,mesh_,this,&arg[iarg],nmove);
 
     if(move_ == 0)
       error->all(FLERR,"Illegal fix move/mesh command, illegal arguments");
 
+    if(rigid_frame_ && !move_->supportsRigidFrame())
+      error->all(FLERR,"Illegal fix move/mesh command, keyword 'rigid_frame' requires move style linear, wiggle or rotate");
+
     // not compatible because surface velocity is just set once
     // and for moving mesh it is set every step
     if(fix_mesh_->surfaceVel())
@@ -85,6 +101,9 @@ void FixMoveMesh:: post_create()
     //NP must register move here in case of restart so that all
     //NP elements are created already
     move_->post_create();
+
+    if(rigid_frame_)
+        mesh_->setRigidFrame(true);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -115,6 +134,10 @@ void FixMoveMesh::pre_delete(bool unfixflag)
                            "Superposed fix move/mesh commands must be unfixed in reverse order of creation");
         }
 
+        //NP node_orig_ is needed to bring nodes to their current position
+        if(rigid_frame_)
+            mesh_->setRigidFrame(false);
+
         //NP have MeshMover unregister with mesh
         move_->pre_delete();
 
@@ -164,6 +187,10 @@ void FixMoveMesh::setup(int vflag)
 
     reset_reference_point();
 
+    //NP the frame is one rigid body motion, cannot superpose
+    if(mesh_->rigidFrame() && mesh_->nMove() > 1)
+      error->fix_error(FLERR,this,"keyword 'rigid_frame' requires the mesh to be moved by a single fix move/mesh");
+
     if(!mesh_->prop().getElementProperty<MultiVectorContainer<double,3,3> >("v"))
     {
         //NP need to have borders comm in order not to loose vel information
@@ -197,8 +224,9 @@ void FixMoveMesh::initial_integrate(int dummy)
     //NP reset velocity if I am first fix move/mesh on this mesh
     //NP first fix will always be first as it cant be deleted without
     //NP deleting all other fixes
+    //NP rigid frame: v is set on materialization
 
-    if(move_->isFirst())
+    if(move_->isFirst() && !mesh_->rigidFrame())
     {
         v = mesh_->prop().getElementProperty<MultiVectorContainer<double,3,3> >("v");
         v->setAll(0.);
@@ -87,6 +87,9 @@ namespace LAMMPS_NS
 
         double reference_point_[3];
         double reference_axis_[3];
+
+        // keep mesh in rigid frame mode
+        bool rigid_frame_;
   };
 } /* namespace LAMMPS_NS */
 #endif
@@ -295,6 +295,15 @@ void FixMultisphere::init()
 
 /* ---------------------------------------------------------------------- */
 
+void FixMultisphere::reset_dt()
+{
+  dtv = update->dt;
+  dtf = 0.5 * update->dt * force->ftm2v;
+  dtq = 0.5 * update->dt;
+}
+
+/* ---------------------------------------------------------------------- */
+
 void FixMultisphere::add_remove_callback(FixRemove *ptr)
 {
     fix_remove_.push_back(ptr);
@@ -61,6 +61,7 @@ class FixMultisphere : public Fix
       void post_create();
       virtual int setmask();
       virtual void init();
+      virtual void reset_dt();
 
       virtual void setup(int);
       virtual void setup_pre_force(int) {}
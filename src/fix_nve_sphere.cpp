@@ -24,6 +24,7 @@
 #include "domain.h" //NP modified GM
 #include "fix_property_atom.h"
 #include "fix_cfd_coupling_force_implicit.h"
+#include "fix_sleep.h"
 #include "modify.h"
 
 using namespace LAMMPS_NS;
@@ -39,7 +40,8 @@ FixNVESphere::FixNVESphere(LAMMPS *lmp, int narg, char **arg) :
   FixNVE(lmp, narg, arg),
   implicitIntegration_(false),
   fix_Ksl_(0),
-  fix_cfd_coupling_force_implicit_(0)
+  fix_cfd_coupling_force_implicit_(0),
+  fix_sleep_(0)
 {
   if (narg < 3) error->all(FLERR,"Illegal fix nve/sphere command");
 
@@ -121,6 +123,9 @@ void FixNVESphere::init()
     if (mask[i] & groupbit)
       if (radius[i] == 0.0)
         error->one(FLERR,"Fix nve/sphere requires extended particles");
+
+  // sleeping particles are not integrated
+  fix_sleep_ = static_cast<FixSleep*>(modify->find_fix_style_strict("sleep",0));
 }
 
 /* ---------------------------------------------------------------------- */
@@ -143,6 +148,7 @@ void FixNVESphere::initial_integrate(int vflag)
   double invImpDenom;
   double *Ksl;
   if (implicitIntegration_) Ksl = fix_Ksl_->vector_atom;
+  double *sleep = fix_sleep_ ? fix_sleep_->state() : NULL;
 
   // set timestep here since dt may have changed or come via rRESPA
 
@@ -157,6 +163,7 @@ void FixNVESphere::initial_integrate(int vflag)
   {
       for (int i = 0; i < nlocal; i++)
       {
+          if (sleep && sleep[i] == FixSleep::SLEEP_ASLEEP) continue;
           if (mask[i] & groupbit)
           {
               dtfm = dtf / rmass[i];
@@ -184,6 +191,7 @@ void FixNVESphere::initial_integrate(int vflag)
   {
       for (int i = 0; i < nlocal; i++)
       {
+          if (sleep && sleep[i] == FixSleep::SLEEP_ASLEEP) continue;
           if (mask[i] & groupbit)
           {
               dtfm = dtf / rmass[i];
@@ -242,6 +250,7 @@ void FixNVESphere::final_integrate()
   double invImpDenom;
   double *Ksl;
   if (implicitIntegration_) Ksl = fix_Ksl_->vector_atom;
+  double *sleep = fix_sleep_ ? fix_sleep_->state() : NULL;
 
   // set timestep here since dt may have changed or come via rRESPA
 
@@ -256,6 +265,7 @@ void FixNVESphere::final_integrate()
   {
       for (int i = 0; i < nlocal; i++)
       {
+          if (sleep && sleep[i] == FixSleep::SLEEP_ASLEEP) continue;
           if (mask[i] & groupbit)
           {
               dtfm = dtf / rmass[i];
@@ -278,6 +288,7 @@ void FixNVESphere::final_integrate()
   {
       for (int i = 0; i < nlocal; i++)
       {
+          if (sleep && sleep[i] == FixSleep::SLEEP_ASLEEP) continue;
           if (mask[i] & groupbit)
           {
               dtfm = dtf / rmass[i];
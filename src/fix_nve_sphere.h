@@ -40,6 +40,7 @@ class FixNVESphere : public FixNVE {
   bool implicitIntegration_;
   class FixPropertyAtom* fix_Ksl_;
   class FixCfdCouplingForceImplicit* fix_cfd_coupling_force_implicit_;
+  class FixSleep* fix_sleep_;
 };
 
 }
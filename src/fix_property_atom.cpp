@@ -24,6 +24,7 @@
 #include <string.h>
 #include "fix_property_atom.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "memory.h"
 #include "error.h"
 
@@ -179,9 +180,10 @@ void FixPropertyAtom::parse_args(int narg, char **arg)
 
     // perform initial allocation of atom-based array
     // register with Atom class
+    //NP arrays are grown, copied and exchanged by atom->arena
     vector_atom = NULL; array_atom = NULL;
-    grow_arrays(atom->nmax); //NP allocation of arrays
-    atom->add_callback(0); //NP register that fix handles per-particle properties
+    if (data_style) atom->arena->add_field(variablename,&array_atom,nvalues,ARENA_EXCHANGE);
+    else atom->arena->add_field(variablename,&vector_atom,ARENA_EXCHANGE);
     if (restart_peratom) atom->add_callback(1); //NP register that fix handles per-particles restart properties
 
     // init all arrays since dump may access it on timestep 0
@@ -232,7 +234,6 @@ void FixPropertyAtom::parse_args(int narg, char **arg)
 FixPropertyAtom::~FixPropertyAtom()
 {
   // unregister callbacks to this fix from Atom class
-  atom->delete_callback(id,0);
   if (restart_peratom) atom->delete_callback(id,1);
 
   // delete locally stored arrays
@@ -240,8 +241,8 @@ FixPropertyAtom::~FixPropertyAtom()
   delete[] defaultvalues;
   if(propertyname) delete []propertyname;
 
-  if (data_style) memory->destroy(array_atom);
-  else memory->destroy(vector_atom);
+  if (data_style) atom->arena->remove_field(&array_atom);
+  else atom->arena->remove_field(&vector_atom);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -398,27 +399,6 @@ double FixPropertyAtom::memory_usage()
     return bytes;
 }
 
-/* ----------------------------------------------------------------------
-   allocate local atom-based arrays
-------------------------------------------------------------------------- */
-
-void FixPropertyAtom::grow_arrays(int nmax)
-{
-    if (data_style) memory->grow(array_atom,nmax,nvalues,"FixPropertyAtom:array_atom");
-    else memory->grow(vector_atom, nmax, "FixPropertyAtom:vector_atom");
-    /*NL*/ //if (screen) fprintf(screen,"GROW nmax %d\n",nmax);
-}
-
-/* ----------------------------------------------------------------------
-   copy values within local atom-based arrays
-------------------------------------------------------------------------- */
-
-void FixPropertyAtom::copy_arrays(int i, int j, int delflag)
-{
-    if (data_style) for(int k=0;k<nvalues;k++) array_atom[j][k] = array_atom[i][k];
-    else vector_atom[j]=vector_atom[i];
-}
-
 /* ----------------------------------------------------------------------
    called before set_arrays is called for each atom
 ------------------------------------------------------------------------- */
@@ -502,28 +482,6 @@ void FixPropertyAtom::set_vector(int i, double value)
     vector_atom[i] = value;
 }
 
-/* ----------------------------------------------------------------------
-   pack values in local atom-based arrays for exchange with another proc
-------------------------------------------------------------------------- */
-
-int FixPropertyAtom::pack_exchange(int i, double *buf)
-{
-    if (data_style) for(int k=0;k<nvalues;k++) buf[k] = array_atom[i][k];
-    else buf[0] = vector_atom[i];
-    return nvalues;
-}
-
-/* ----------------------------------------------------------------------
-   unpack values into local atom-based arrays after exchange
-------------------------------------------------------------------------- */
-
-int FixPropertyAtom::unpack_exchange(int nlocal, double *buf)
-{
-    if (data_style) for(int k=0;k<nvalues;k++) array_atom[nlocal][k] = buf[k];
-    else vector_atom[nlocal]=buf[0];
-    return nvalues;
-}
-
 /* ----------------------------------------------------------------------
    pack values in local atom-based arrays for restart file
 ------------------------------------------------------------------------- */
@@ -57,8 +57,6 @@ class FixPropertyAtom : public Fix {
   virtual Fix* check_fix(const char *varname,const char *svmstyle,int len1,int len2,const char *caller,bool errflag);
 
   double memory_usage();
-  void grow_arrays(int);
-  void copy_arrays(int, int,int);
   virtual void pre_set_arrays();
   virtual void set_arrays(int);
 
@@ -70,8 +68,6 @@ class FixPropertyAtom : public Fix {
   void write_restart(FILE *);
   virtual void restart(char *);
 
-  int pack_exchange(int, double *);
-  int unpack_exchange(int, double *);
   int pack_restart(int, double *);
   void unpack_restart(int, int);
   int size_restart(int);
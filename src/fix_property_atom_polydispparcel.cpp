@@ -24,6 +24,7 @@
 #include <string.h>
 #include "fix_property_atom_polydispparcel.h"
 #include "atom.h"
+#include "per_atom_arena.h"
 #include "memory.h"
 #include "error.h"
 #include "pair_gran.h"
@@ -103,9 +104,10 @@ void FixPropertyAtomPolydispParcel::parse_args(int narg, char **arg)
 
     // perform initial allocation of atom-based array
     // register with Atom class
+    //NP arrays are grown, copied and exchanged by atom->arena
     vector_atom = NULL; array_atom = NULL;
-    grow_arrays(atom->nmax); //NP allocation of arrays
-    atom->add_callback(0); //NP register that fix handles per-particle properties
+    if (data_style) atom->arena->add_field(variablename,&array_atom,nvalues,ARENA_EXCHANGE);
+    else atom->arena->add_field(variablename,&vector_atom,ARENA_EXCHANGE);
     if (restart_peratom) atom->add_callback(1); //NP register that fix handles per-particles restart properties
 
     // init all arrays since dump may access it on timestep 0
@@ -456,6 +456,15 @@ bool FixRemove::count_eligible(double &mass_eligible_me,double &mass_eligible,
     double mass_ms_eligible_me = 0.;
     bool fits;
 
+    // test all particles against region in one call
+
+    if(iregion_ >= 0)
+    {
+        inregion_.resize(nlocal);
+        if(nlocal > 0)
+            domain->regions[iregion_]->match_batch(nlocal,x,&inregion_[0]);
+    }
+
     // count total eligible mass for single particles
 
     for (int i = 0; i < nlocal; i++)
@@ -463,7 +472,7 @@ bool FixRemove::count_eligible(double &mass_eligible_me,double &mass_eligible,
        fits = (  (mask[i] & groupbit) &&
                  (!fix_ms_ || fix_ms_->belongs_to(i) < 0) &&
                  (type_remove_ < 0 || type[i] == type_remove_) &&
-                 (iregion_ < 0 || domain->regions[iregion_]->match(x[i][0],x[i][1],x[i][2]))
+                 (iregion_ < 0 || inregion_[i])
               );
 
        if(fits)
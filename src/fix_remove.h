@@ -106,6 +106,7 @@ class FixRemove : public Fix {
 
   //NP list of bodies to remove
   std::vector<int> atom_tags_eligible_;
+  std::vector<int> inregion_;
   std::vector<int> body_tags_eligible_;
   std::vector<int> body_tags_delete_;
 };
@@ -12,6 +12,7 @@
 ------------------------------------------------------------------------- */
 
 #include <stdlib.h>
+#include <string.h>
 #include "fix_respa.h"
 #include "atom.h"
 #include "memory.h"
@@ -30,10 +31,16 @@ FixRespa::FixRespa(LAMMPS *lmp, int narg, char **arg) :
 
   nlevels = force->inumeric(FLERR,arg[3]);
 
+  // optionally store torque at each level, e.g. for granular styles
+
+  store_torque = 0;
+  if (narg > 4 && strcmp(arg[4],"torque") == 0) store_torque = 1;
+
   // perform initial allocation of atom-based arrays
   // register with Atom class
 
   f_level = NULL;
+  t_level = NULL;
   grow_arrays(atom->nmax);
   atom->add_callback(0);
 }
@@ -49,6 +56,7 @@ FixRespa::~FixRespa()
   // delete locally stored arrays
 
   memory->destroy(f_level);
+  memory->destroy(t_level);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -65,6 +73,7 @@ int FixRespa::setmask()
 double FixRespa::memory_usage()
 {
   double bytes = atom->nmax*nlevels*3 * sizeof(double);
+  if (store_torque) bytes += atom->nmax*nlevels*3 * sizeof(double);
   return bytes;
 }
 
@@ -75,6 +84,7 @@ double FixRespa::memory_usage()
 void FixRespa::grow_arrays(int nmax)
 {
   memory->grow(f_level,nmax,nlevels,3,"fix_respa:f_level");
+  if (store_torque) memory->grow(t_level,nmax,nlevels,3,"fix_respa:t_level");
 }
 
 /* ----------------------------------------------------------------------
@@ -88,6 +98,13 @@ void FixRespa::copy_arrays(int i, int j, int delflag)
     f_level[j][k][1] = f_level[i][k][1];
     f_level[j][k][2] = f_level[i][k][2];
   }
+  if (store_torque) {
+    for (int k = 0; k < nlevels; k++) {
+      t_level[j][k][0] = t_level[i][k][0];
+      t_level[j][k][1] = t_level[i][k][1];
+      t_level[j][k][2] = t_level[i][k][2];
+    }
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -102,6 +119,13 @@ int FixRespa::pack_exchange(int i, double *buf)
     buf[m++] = f_level[i][k][1];
     buf[m++] = f_level[i][k][2];
   }
+  if (store_torque) {
+    for (int k = 0; k < nlevels; k++) {
+      buf[m++] = t_level[i][k][0];
+      buf[m++] = t_level[i][k][1];
+      buf[m++] = t_level[i][k][2];
+    }
+  }
   return m;
 }
 
@@ -117,5 +141,12 @@ int FixRespa::unpack_exchange(int nlocal, double *buf)
     f_level[nlocal][k][1] = buf[m++];
     f_level[nlocal][k][2] = buf[m++];
   }
+  if (store_torque) {
+    for (int k = 0; k < nlevels; k++) {
+      t_level[nlocal][k][0] = buf[m++];
+      t_level[nlocal][k][1] = buf[m++];
+      t_level[nlocal][k][2] = buf[m++];
+    }
+  }
   return m;
 }
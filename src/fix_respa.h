@@ -43,7 +43,9 @@ class FixRespa : public Fix {
 
  private:
   int nlevels;
+  int store_torque;             // 1 if torque is stored as well
   double ***f_level;            // force at each rRESPA level
+  double ***t_level;            // torque at each rRESPA level
 };
 
 }
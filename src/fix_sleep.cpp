@@ -0,0 +1,294 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fix_sleep.h"
+#include "atom.h"
+#include "force.h"
+#include "pair_gran.h"
+#include "neigh_list.h"
+#include "modify.h"
+#include "memory.h"
+#include "error.h"
+#include "mpi_liggghts.h"
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+/* ---------------------------------------------------------------------- */
+
+FixSleep::FixSleep(LAMMPS *lmp, int narg, char **arg) :
+  Fix(lmp, narg, arg),
+  fix_state_(0),
+  fix_quiet_(0),
+  pg_(0),
+  restless_(0),
+  nmax_(0)
+{
+  if (narg != 8) error->all(FLERR,"Illegal fix sleep command");
+
+  nevery = force->inumeric(FLERR,arg[3]);
+  nsteps_ = force->inumeric(FLERR,arg[4]);
+  double vmax = force->numeric(FLERR,arg[5]);
+  double omegamax = force->numeric(FLERR,arg[6]);
+  double fmax = force->numeric(FLERR,arg[7]);
+
+  if (nevery <= 0 || nsteps_ <= 0 || vmax < 0. || omegamax < 0. || fmax < 0.)
+    error->all(FLERR,"Illegal fix sleep command");
+
+  vsq_ = vmax*vmax;
+  omegasq_ = omegamax*omegamax;
+  fsq_ = fmax*fmax;
+
+  scalar_flag = 1;
+  global_freq = nevery;
+  extscalar = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixSleep::~FixSleep()
+{
+  memory->destroy(restless_);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixSleep::post_create()
+{
+  if(modify->n_fixes_style(style) > 1)
+    error->fix_error(FLERR,this,"only one fix sleep allowed");
+
+  // state is needed for ghosts to skip sleeping pairs
+
+  fix_state_ = static_cast<FixPropertyAtom*>(modify->find_fix_property("sleep_state","property/atom","scalar",0,0,style,false));
+  if(!fix_state_)
+  {
+    const char* fixarg[9];
+    fixarg[0]="sleep_state";
+    fixarg[1]="all";
+    fixarg[2]="property/atom";
+    fixarg[3]="sleep_state";
+    fixarg[4]="scalar";
+    fixarg[5]="yes";    //NP restart yes
+    fixarg[6]="yes";    //NP communicate ghost yes
+    fixarg[7]="no";     //NP communicate rev no
+    fixarg[8]="0.";
+    fix_state_ = modify->add_fix_property_atom(9,const_cast<char**>(fixarg),style);
+  }
+
+  fix_quiet_ = static_cast<FixPropertyAtom*>(modify->find_fix_property("sleep_quiet","property/atom","scalar",0,0,style,false));
+  if(!fix_quiet_)
+  {
+    const char* fixarg[9];
+    fixarg[0]="sleep_quiet";
+    fixarg[1]="all";
+    fixarg[2]="property/atom";
+    fixarg[3]="sleep_quiet";
+    fixarg[4]="scalar";
+    fixarg[5]="yes";    //NP restart yes
+    fixarg[6]="no";     //NP communicate ghost no
+    fixarg[7]="no";     //NP communicate rev no
+    fixarg[8]="0.";
+    fix_quiet_ = modify->add_fix_property_atom(9,const_cast<char**>(fixarg),style);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixSleep::pre_delete(bool unfixflag)
+{
+  // without the state, all particles are integrated again
+  if(unfixflag)
+  {
+    modify->delete_fix("sleep_state");
+    modify->delete_fix("sleep_quiet");
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixSleep::setmask()
+{
+  int mask = 0;
+  mask |= END_OF_STEP;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixSleep::init()
+{
+  pg_ = static_cast<PairGran*>(force->pair_match("gran",0));
+  if(!pg_) error->fix_error(FLERR,this,"requires pair style gran");
+  if(force->newton_pair)
+    error->fix_error(FLERR,this,"requires newton pair off");
+
+  fix_state_ = static_cast<FixPropertyAtom*>(modify->find_fix_property("sleep_state","property/atom","scalar",0,0,style));
+  fix_quiet_ = static_cast<FixPropertyAtom*>(modify->find_fix_property("sleep_quiet","property/atom","scalar",0,0,style));
+
+  //NP only fix nve/sphere skips sleeping particles, any other integrator
+  //NP would keep moving them while pair gran treats them as fixed
+  int *mask = atom->mask;
+  int nlocal = atom->nlocal;
+  for(int ifix = 0; ifix < modify->nfix; ifix++)
+  {
+    Fix *fix = modify->fix[ifix];
+    if(!fix->time_integrate || strcmp(fix->style,"nve/sphere") == 0) continue;
+
+    int overlap = 0;
+    for(int i = 0; i < nlocal; i++)
+      if((mask[i] & groupbit) && (mask[i] & fix->groupbit)) overlap = 1;
+    MPI_Max_Scalar(overlap,world);
+    if(overlap)
+    {
+      char str[512];
+      sprintf(str,"only fix nve/sphere supports sleeping particles, but fix %s (style %s) integrates particles of the group",fix->id,fix->style);
+      error->fix_error(FLERR,this,str);
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixSleep::setup(int)
+{
+  //NP ghosts may carry the state of a previous run or restart
+  fix_state_->do_forward_comm();
+}
+
+/* ----------------------------------------------------------------------
+   particles below the thresholds for nsteps fall asleep unless in
+   contact with an active particle, sleeping particles in contact with an
+   active particle wake up
+------------------------------------------------------------------------- */
+
+void FixSleep::end_of_step()
+{
+  double *state = fix_state_->vector_atom;
+  double *quiet = fix_quiet_->vector_atom;
+  double **v = atom->v;
+  double **f = atom->f;
+  double **omega = atom->omega;
+  int *mask = atom->mask;
+  int nlocal = atom->nlocal;
+
+  // count quiet steps of awake particles
+  // particles outside the group can be quiet, but never fall asleep
+
+  for(int i = 0; i < nlocal; i++)
+  {
+    if(state[i] == SLEEP_ASLEEP) continue;
+
+    const double vsq = v[i][0]*v[i][0] + v[i][1]*v[i][1] + v[i][2]*v[i][2];
+    const double omegasq = omega[i][0]*omega[i][0] + omega[i][1]*omega[i][1] + omega[i][2]*omega[i][2];
+    const double fsq = f[i][0]*f[i][0] + f[i][1]*f[i][1] + f[i][2]*f[i][2];
+
+    if(vsq < vsq_ && omegasq < omegasq_ && fsq < fsq_) quiet[i] += nevery;
+    else quiet[i] = 0.;
+
+    state[i] = quiet[i] >= nsteps_ ? SLEEP_QUIET : SLEEP_ACTIVE;
+  }
+
+  fix_state_->do_forward_comm();
+
+  // flag particles in contact with an active particle
+  //NP newton off: contacts across procs are seen by both procs
+
+  if(atom->nmax > nmax_)
+  {
+    nmax_ = atom->nmax;
+    memory->destroy(restless_);
+    memory->create(restless_,nmax_,"sleep:restless");
+  }
+  for(int i = 0; i < nlocal; i++) restless_[i] = 0;
+
+  double **x = atom->x;
+  double *radius = atom->radius;
+  NeighList *list = pg_->list;
+  int inum = list->inum;
+  int *ilist = list->ilist;
+  int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+
+  for(int ii = 0; ii < inum; ii++)
+  {
+    const int i = ilist[ii];
+    const int *jlist = firstneigh[i];
+    const int jnum = numneigh[i];
+
+    for(int jj = 0; jj < jnum; jj++)
+    {
+      const int j = jlist[jj] & NEIGHMASK;
+      if(state[i] != SLEEP_ACTIVE && state[j] != SLEEP_ACTIVE) continue;
+
+      const double delx = x[i][0] - x[j][0];
+      const double dely = x[i][1] - x[j][1];
+      const double delz = x[i][2] - x[j][2];
+      const double radsum = radius[i] + radius[j];
+      if(delx*delx + dely*dely + delz*delz >= radsum*radsum) continue;
+
+      if(state[j] == SLEEP_ACTIVE) restless_[i] = 1;
+      if(state[i] == SLEEP_ACTIVE && j < nlocal) restless_[j] = 1;
+    }
+  }
+
+  // wake up or fall asleep
+
+  for(int i = 0; i < nlocal; i++)
+  {
+    if(state[i] == SLEEP_ASLEEP)
+    {
+      if(restless_[i])
+      {
+        state[i] = SLEEP_ACTIVE;
+        quiet[i] = 0.;
+      }
+    }
+    else if(state[i] == SLEEP_QUIET && (mask[i] & groupbit) && !restless_[i])
+    {
+      state[i] = SLEEP_ASLEEP;
+      v[i][0] = v[i][1] = v[i][2] = 0.;
+      omega[i][0] = omega[i][1] = omega[i][2] = 0.;
+    }
+  }
+
+  fix_state_->do_forward_comm();
+}
+
+/* ----------------------------------------------------------------------
+   # of sleeping particles
+------------------------------------------------------------------------- */
+
+double FixSleep::compute_scalar()
+{
+  double *state = fix_state_->vector_atom;
+  int nlocal = atom->nlocal;
+
+  int nsleep = 0;
+  for(int i = 0; i < nlocal; i++)
+    if(state[i] == SLEEP_ASLEEP) nsleep++;
+
+  MPI_Sum_Scalar(nsleep,world);
+  return static_cast<double>(nsleep);
+}
@@ -0,0 +1,103 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+
+FixStyle(sleep,FixSleep)
+
+#else
+
+#ifndef LMP_FIX_SLEEP_H
+#define LMP_FIX_SLEEP_H
+
+#include "fix.h"
+#include "fix_property_atom.h"
+
+namespace LAMMPS_NS {
+
+class FixSleep : public Fix {
+ public:
+
+  // per-atom sleep state
+  //   SLEEP_QUIET: below thresholds for nsteps, but not asleep yet
+  //   SLEEP_ASLEEP: skipped by pair gran and fix nve/sphere
+
+  enum { SLEEP_ACTIVE = 0, SLEEP_QUIET = 1, SLEEP_ASLEEP = 2 };
+
+  FixSleep(class LAMMPS *, int, char **);
+  ~FixSleep();
+  void post_create();
+  void pre_delete(bool unfixflag);
+
+  int setmask();
+  void init();
+  void setup(int);
+  void end_of_step();
+  double compute_scalar();
+
+  // state of owned and ghost atoms
+  inline double *state()
+  { return fix_state_->vector_atom; }
+
+  // wake owned atom i, e.g. on contact with a moving wall
+  inline void wake(int i)
+  {
+    if(fix_state_->vector_atom[i] == SLEEP_ASLEEP)
+    {
+      fix_state_->vector_atom[i] = SLEEP_ACTIVE;
+      fix_quiet_->vector_atom[i] = 0.;
+    }
+  }
+
+ private:
+
+  int nsteps_;                    // # steps below thresholds to fall asleep
+  double vsq_, omegasq_, fsq_;    // squared thresholds
+
+  class FixPropertyAtom *fix_state_;
+  class FixPropertyAtom *fix_quiet_; // # steps below thresholds
+  class PairGran *pg_;
+
+  int *restless_;                 // 1 if in contact with active particle
+  int nmax_;
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal fix sleep command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.
+
+E: Fix sleep requires pair style gran
+
+Contacts are detected via the neighbor list of the granular pair style.
+
+E: Fix sleep requires newton pair off
+
+Each proc has to see all contacts of its owned particles.
+
+*/
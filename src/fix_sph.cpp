@@ -59,6 +59,7 @@ FixSph::FixSph(LAMMPS *lmp, int narg, char **arg) :
   kernel_id = -1;   // default value
   kernel_cut = -1;
   kernel_style = NULL;
+  sl_const = 0;
 
   fppaSl = NULL;
   fppaSlType = NULL;
@@ -123,7 +124,15 @@ void FixSph::init()
         slComType[i][j] = slComType[j][i] = interpDist(sli,slj);;
       }
 
+    // allows kernel loops with smoothing length fixed at loop entry
+
+    sl_const = 1;
+    for (int i = 1; i <= ntypes; i++)
+      for (int j = 1; j <= ntypes; j++)
+        if (slComType[i][j] != slComType[1][1]) sl_const = 0;
+
   } else {
+    sl_const = 0;
     if (fppaSl == NULL) {
       fppaSl=static_cast<FixPropertyAtom*>(modify->find_fix_property("sl","property/atom","scalar",0,0,"FixSph",false));
     }
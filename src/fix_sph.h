@@ -64,6 +64,7 @@ class FixSph : public Fix {
   int nlevels_respa;
 
   int mass_type; // flag defined in atom_vec*
+  int sl_const;  // 1 if common smoothing length is the same for all type pairs
 
 };
 
@@ -49,6 +49,8 @@ andreas.aigner@jku.at
 using namespace LAMMPS_NS;
 using namespace FixConst;
 
+#define NBLOCK 64     // neighbors per block of kernel evaluations
+
 /* ---------------------------------------------------------------------- */
 
 FixSPHDensitySum::FixSPHDensitySum(LAMMPS *lmp, int narg, char **arg) :
@@ -135,20 +137,48 @@ void FixSPHDensitySum::init()
 void FixSPHDensitySum::post_integrate()
 {
   //template function for using per atom or per atomtype smoothing length
-  if (mass_type) post_integrate_eval<1>();
-  else post_integrate_eval<0>();
+  //per atomtype smoothing length which is the same for all types is
+  //hoisted out of the loops
+  if (mass_type && sl_const) post_integrate_kernel<1,1>();
+  else if (mass_type) post_integrate_kernel<1,0>();
+  else post_integrate_kernel<0,0>();
 }
 
-/* ---------------------------------------------------------------------- */
+/* ----------------------------------------------------------------------
+   resolve kernel id to a template parameter
+------------------------------------------------------------------------- */
+
+template <int MASSFLAG, int CONSTSL>
+void FixSPHDensitySum::post_integrate_kernel()
+{
+  if (0) return;
+  #define SPH_KERNEL_CLASS
+  #define SPHKernel(id,kernelstyle,SPHKernelCalculation,SPHKernelCalculationDer,SPHKernelCalculationCut) \
+  else if (kernel_id == id) post_integrate_eval<MASSFLAG,CONSTSL,id>();
+  #include "style_sph_kernel.h"
+  #undef SPH_KERNEL_CLASS
+  #undef SPHKernel
+  else error->all(FLERR,"Illegal fix sph/density/summation command, unknown sph kernel");
+}
+
+/* ----------------------------------------------------------------------
+   neighbors are processed in blocks of NBLOCK
+   (1) collect neighbors within kernel support
+   (2) evaluate kernel for all of them in one loop
+   (3) add contributions to rho
+------------------------------------------------------------------------- */
 
-template <int MASSFLAG>
+template <int MASSFLAG, int CONSTSL, int KERNEL>
 void FixSPHDensitySum::post_integrate_eval()
 {
-  int i,j,ii,jj,inum,jnum,itype,jtype;
-  double xtmp,ytmp,ztmp,delx,dely,delz,rsq,r,s=0.,W;
-  double sli,sliInv,slj,slCom,slComInv,cut,imass,jmass;
+  int i,j,k,ii,jj,inum,jnum,itype=0,jtype,nblock;
+  double xtmp,ytmp,ztmp,delx,dely,delz,rsq,s=0.,W;
+  double sli=0.,sliInv,slj,slCom,cut,imass,jmass;
   int *ilist,*jlist,*numneigh,**firstneigh;
 
+  int jblock[NBLOCK];
+  double rsqblock[NBLOCK],slblock[NBLOCK],wblock[NBLOCK];
+
   double **x = atom->x;
   int *mask = atom->mask;
   double *rho = atom->rho;
@@ -160,6 +190,16 @@ void FixSPHDensitySum::post_integrate_eval()
 
   updatePtrs(); // get sl
 
+  // common smoothing length and cutoff if same for all types
+
+  double slConst = 0.,slConstInv = 0.,cutsqConst = 0.;
+  if (CONSTSL) {
+    slConst = slComType[1][1];
+    slConstInv = 1./slConst;
+    cut = slConst*kernel_cut;
+    cutsqConst = cut*cut;
+  }
+
   // reset and add rho contribution of self
 
   int nlocal = atom->nlocal;
@@ -177,7 +217,7 @@ void FixSPHDensitySum::post_integrate_eval()
 
     // this gets a value for W at self, perform error check
 
-    W = SPH_KERNEL_NS::sph_kernel(kernel_id,0.,sli,sliInv);
+    W = SPH_KERNEL_NS::SPHKernelStatic<KERNEL>::value(0.,sli,sliInv);
     if (W < 0.)
     {
       if (screen) fprintf(screen,"s = %f, W = %f\n",s,W);
@@ -219,52 +259,73 @@ void FixSPHDensitySum::post_integrate_eval()
       sli = sl[i];
     }
 
-    for (jj = 0; jj < jnum; jj++) {
-      j = jlist[jj];
+    for (int jstart = 0; jstart < jnum; jstart += NBLOCK) {
+      const int jend = MIN(jstart+NBLOCK,jnum);
+
+      // collect neighbors within kernel support
+
+      nblock = 0;
+      for (jj = jstart; jj < jend; jj++) {
+        j = jlist[jj];
+
+        if (!(mask[j] & groupbit)) continue;
+
+        delx = xtmp - x[j][0];
+        dely = ytmp - x[j][1];
+        delz = ztmp - x[j][2];
+        rsq = delx*delx + dely*dely + delz*delz;
+
+        if (CONSTSL) {
+          if (rsq >= cutsqConst) continue;
+          slCom = slConst;
+        } else {
+          if (MASSFLAG) {
+            jtype = type[j];
+            slCom = slComType[itype][jtype];
+          } else {
+            slj = sl[j];
+            slCom = interpDist(sli,slj);
+          }
+          cut = slCom*kernel_cut;
+          if (rsq >= cut*cut) continue;
+        }
+
+        jblock[nblock] = j;
+        rsqblock[nblock] = rsq;
+        slblock[nblock] = slCom;
+        nblock++;
+      }
 
-      if (!(mask[j] & groupbit)) continue;
+      // calculate normalized distance and kernel for whole block
 
-      if (MASSFLAG) {
-        jtype = type[j];
-        jmass = mass[jtype];
-        slCom = slComType[itype][jtype];
-      } else {
-        jmass = rmass[j];
-        slj = sl[j];
-        slCom = interpDist(sli,slj);
+      for (k = 0; k < nblock; k++) {
+        const double slComInv = CONSTSL ? slConstInv : 1./slblock[k];
+        const double sk = sqrt(rsqblock[k])*slComInv;
+        wblock[k] = SPH_KERNEL_NS::SPHKernelStatic<KERNEL>::value(sk,slblock[k],slComInv);
       }
 
-      slComInv = 1./slCom;
-      cut = slCom*kernel_cut;
+      // add contribution of neighbors
+      // have a half neigh list, so do it for both if necessary
 
-      delx = xtmp - x[j][0];
-      dely = ytmp - x[j][1];
-      delz = ztmp - x[j][2];
-      rsq = delx*delx + dely*dely + delz*delz;
+      for (k = 0; k < nblock; k++) {
+        j = jblock[k];
+        W = wblock[k];
 
-      if (rsq >= cut*cut) continue;
-      // calculate distance and normalized distance
+        if (W < 0.)
+        {
+          s = sqrt(rsqblock[k])/slblock[k];
+          if (screen) fprintf(screen,"s = %f, W = %f\n",s,W);
+          error->one(FLERR,"Illegal kernel used, W < 0");
+        }
 
-      r = sqrt(rsq);
-      slComInv = 1./slCom;
-      s = r*slComInv;
+        if (MASSFLAG) jmass = mass[type[j]];
+        else jmass = rmass[j];
 
-      // this gets a value for W at self, perform error check
+        rho[i] += W * jmass;
 
-      W = SPH_KERNEL_NS::sph_kernel(kernel_id,s,slCom,slComInv);
-      if (W < 0.)
-      {
-        if (screen) fprintf(screen,"s = %f, W = %f\n",s,W);
-        error->one(FLERR,"Illegal kernel used, W < 0");
+        if (newton_pair || j < nlocal)
+          rho[j] += W * imass;
       }
-
-      // add contribution of neighbor
-      // have a half neigh list, so do it for both if necessary
-
-      rho[i] += W * jmass;
-
-      if (newton_pair || j < nlocal)
-        rho[j] += W * imass;
     }
   }
 
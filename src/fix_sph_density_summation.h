@@ -47,7 +47,8 @@ class FixSPHDensitySum : public FixSph {
   virtual void post_integrate();
 
  private:
-  template <int> void post_integrate_eval();
+  template <int,int> void post_integrate_kernel();
+  template <int,int,int> void post_integrate_eval();
 
 };
 
@@ -38,6 +38,7 @@
 #include "force.h"
 #include "pair_gran.h"
 #include "fix_rigid.h"
+#include "fix_sleep.h"
 #include "fix_mesh.h"
 #include "fix_contact_history_mesh.h"
 #include "modify.h"
@@ -55,6 +56,7 @@
 #include "tri_mesh.h"
 #include "primitive_wall.h"
 #include "primitive_wall_definitions.h"
+#include "primitive_wall_distance_field.h"
 #include "mpi_liggghts.h"
 #include "neighbor.h"
 #include "contact_interface.h"
@@ -119,8 +121,12 @@ FixWallGran::FixWallGran(LAMMPS *lmp, int narg, char **arg) :
     fix_wallforce_ = 0;
     fix_wallforce_contact_ = 0;
     fix_rigid_ = NULL;
+    fix_sleep_ = NULL;
     heattransfer_flag_ = false;
 
+    respa_level_ = 0;
+    ilevel_respa_ = 0;
+
     FixMesh_list_ = NULL;
 
     rebuildPrimitiveNeighlist_ = false;
@@ -183,6 +189,39 @@ FixWallGran::FixWallGran(LAMMPS *lmp, int narg, char **arg) :
            for(int iWall = 0; iWall < n_primitives_; ++iWall) {
 
              char *wallstyle = arg[iarg_++];
+
+             //NP static surface from file, resolved via distance field
+             if(strcmp(wallstyle,"sdf") == 0)
+             {
+               if(narg-iarg_ < 6)
+                 error->fix_error(FLERR,this,"not enough arguments for primitive wall 'sdf'");
+               if(strcmp(arg[iarg_++],"file"))
+                 error->fix_error(FLERR,this,"expecting keyword 'file' after 'sdf'");
+               char *sdf_file = arg[iarg_++];
+               if(strcmp(arg[iarg_++],"spacing"))
+                 error->fix_error(FLERR,this,"expecting keyword 'spacing'");
+               double sdf_spacing = force->numeric(FLERR,arg[iarg_++]);
+               if(strcmp(arg[iarg_++],"band"))
+                 error->fix_error(FLERR,this,"expecting keyword 'band'");
+               double sdf_band = force->numeric(FLERR,arg[iarg_++]);
+               double sdf_scale = 1., sdf_angle = 30.;
+               while(iarg_ < narg)
+               {
+                 if(narg-iarg_ > 1 && strcmp(arg[iarg_],"scale") == 0)
+                   sdf_scale = force->numeric(FLERR,arg[iarg_+1]);
+                 else if(narg-iarg_ > 1 && strcmp(arg[iarg_],"refine_angle") == 0)
+                   sdf_angle = force->numeric(FLERR,arg[iarg_+1]);
+                 else break;
+                 iarg_ += 2;
+               }
+               if(sdf_spacing <= 0. || sdf_band <= sdf_spacing || sdf_scale <= 0.)
+                 error->fix_error(FLERR,this,"'sdf' requires spacing > 0, band > spacing and scale > 0");
+               if(sdf_angle <= 0. || sdf_angle > 180.)
+                 error->fix_error(FLERR,this,"'sdf' requires 0 < refine_angle <= 180");
+               primitiveWalls_.push_back(new PrimitiveWallDistanceField(lmp,sdf_file,sdf_spacing,sdf_band,sdf_scale,sdf_angle));
+               continue;
+             }
+
              int nPrimitiveArgs = PRIMITIVE_WALL_DEFINITIONS::numArgsPrimitiveWall(wallstyle);
              /*NL*/// if (screen) fprintf(screen,"nPrimitiveArgs %d\n",nPrimitiveArgs);
 
@@ -231,6 +270,14 @@ FixWallGran::FixWallGran(LAMMPS *lmp, int narg, char **arg) :
            else error->fix_error(FLERR,this,"expecting 'yes' or 'no' after keyword 'store_force_contact_'");
            hasargs = true;
            iarg_ += 2;
+        } else if (strcmp(arg[iarg_],"respa_level") == 0) {
+           if (iarg_+2 > narg)
+              error->fix_error(FLERR,this,"not enough arguments");
+           respa_level_ = force->inumeric(FLERR,arg[iarg_+1]);
+           if(respa_level_ < 1)
+              error->fix_error(FLERR,this,"'respa_level' > 0 required");
+           hasargs = true;
+           iarg_ += 2;
         } else if (strcmp(arg[iarg_],"n_meshes") == 0) {
           if (meshwall_ != 1)
              error->fix_error(FLERR,this,"have to use keyword 'mesh' before using 'n_meshes'");
@@ -521,8 +568,23 @@ void FixWallGran::init()
         // check if a fix rigid is registered - important for damp
         fix_rigid_ = static_cast<FixRigid*>(modify->find_fix_style_strict("rigid",0));
 
+        // moving walls wake up sleeping particles
+        fix_sleep_ = static_cast<FixSleep*>(modify->find_fix_style_strict("sleep",0));
+
         if (strcmp(update->integrate_style,"respa") == 0)
+        {
           nlevels_respa_ = ((Respa *) update->integrate)->nlevels;
+          if(respa_level_ > nlevels_respa_)
+            error->fix_error(FLERR,this,"'respa_level' exceeds number of rRESPA levels");
+
+          //NP stiff walls can be sub-cycled with the particle-particle contacts,
+          //NP the wall force then enters every substep of that level
+          ilevel_respa_ = respa_level_ > 0 ? respa_level_-1 : nlevels_respa_-1;
+
+          //NP mesh stress is reset and reduced once per outer step
+          if(ilevel_respa_ < nlevels_respa_-1 && stress_flag_)
+            error->fix_error(FLERR,this,"meshes tracking stress require the outermost rRESPA level");
+        }
 
         if(impl)
           impl->init_granular();
@@ -545,6 +607,36 @@ void FixWallGran::init()
                 if (fwg->is_mesh_wall())
                     error->fix_error(FLERR,this,"More than one wall of type 'mesh' is not supported");
             }
+
+#ifdef SUPERQUADRIC_ACTIVE_FLAG
+            //NP superquadric contact is resolved in space only
+            if(atom->superquadric_flag)
+                for(int iMesh = 0; iMesh < n_FixMesh_; iMesh++)
+                    if(FixMesh_list_[iMesh]->triMesh()->rigidFrame())
+                        error->fix_error(FLERR,this,"meshes in rigid frame mode do not support superquadric particles");
+#endif
+        }
+
+        //NP contacts are only found inside the band of a distance field,
+        //NP the largest particle must be within reach over the neighbor skin
+        double maxrad = 0., minrad = 0.;
+        bool maxrad_set = false;
+        for(size_t i = 0; i < primitiveWalls_.size(); i++)
+        {
+            PrimitiveWallDistanceField *sdf = dynamic_cast<PrimitiveWallDistanceField*>(primitiveWalls_[i]);
+            if(!sdf) continue;
+            if(!maxrad_set)
+            {
+                modify->max_min_rad(maxrad,minrad);
+                maxrad_set = true;
+            }
+            if(sdf->band() < sdf->requiredBand(maxrad,neighbor->skin))
+            {
+                char str[512];
+                sprintf(str,"'sdf' band %g is too small, it must be at least max radius + skin + sqrt(3)*spacing = %g",
+                        sdf->band(),sdf->requiredBand(maxrad,neighbor->skin));
+                error->fix_error(FLERR,this,str);
+            }
         }
     }
     //NP out = fopen("shearhistory","w");
@@ -562,13 +654,26 @@ void FixWallGran::setup(int vflag)
     }
     else
     {
-      ((Respa *) update->integrate)->copy_flevel_f(nlevels_respa_-1);
-      post_force_respa(vflag,nlevels_respa_-1,0);
-      ((Respa *) update->integrate)->copy_f_flevel(nlevels_respa_-1);
+      ((Respa *) update->integrate)->copy_flevel_f(ilevel_respa_);
+      post_force_respa(vflag,ilevel_respa_,0);
+      ((Respa *) update->integrate)->copy_f_flevel(ilevel_respa_);
+    }
+
+    //NP setup is not followed by final_integrate of the mesh, so merge the
+    //NP per-thread stress contributions here, otherwise they would be dropped
+    //NP by clearReverse() of the mesh at the first step
+    if(stress_flag_)
+    {
+      for(int i = 0; i < n_FixMesh_; i++)
+        if(FixMesh_list_[i]->trackStress())
+          static_cast<FixMeshSurfaceStress*>(FixMesh_list_[i])->reduce_thread_contributions();
     }
 
     //NP doing this here because deltan_ratio is set in init() of fix heat/gran
     init_heattransfer();
+
+    if(heattransfer_flag_ && strstr(update->integrate_style,"respa") && ilevel_respa_ < nlevels_respa_-1)
+      error->fix_error(FLERR,this,"heat transfer requires the outermost rRESPA level");
 }
 
 /* ----------------------------------------------------------------------
@@ -578,6 +683,9 @@ void FixWallGran::setup(int vflag)
 void FixWallGran::pre_neighbor()
 {
     rebuildPrimitiveNeighlist_ = (primitiveWalls_.size() > 0);
+
+    for(size_t i = 0; i < primitiveWalls_.size(); ++i)
+      primitiveWalls_[i]->preNeighbor();
 }
 
 void FixWallGran::pre_force(int vflag)
@@ -701,7 +809,7 @@ void FixWallGran::post_force_wall(int vflag)
 
 void FixWallGran::post_force_respa(int vflag, int ilevel, int iloop)
 {
-    if (ilevel == nlevels_respa_-1) post_force(vflag);
+    if (ilevel == ilevel_respa_) post_force(vflag);
 }
 
 /* ----------------------------------------------------------------------
@@ -729,28 +837,17 @@ void FixWallGran::post_force_mesh(int vflag)
     for(int iMesh = 0; iMesh < n_FixMesh_; iMesh++)
     {
       FixContactHistoryMesh *fix_contact = FixMesh_list_[iMesh]->contactHistory();
-      // mark all contacts for deletion at this point
-      //NP all detected contacts will be un-marked by fix_contact->handleContact()
+      // start new evaluation, contacts not detected in it expire
+      //NP all detected contacts will be stamped by fix_contact->handleContact()
 
-      if(fix_contact) {
-        FixNeighlistMesh * meshNeighlist = static_cast<FixNeighlistMesh*>(FixMesh_list_[iMesh]->meshNeighlist());
-        fix_contact->resetDeletionPage(0);
-
-        std::vector<int> & particle_indices = meshNeighlist->particle_indices;
-
-        // mark all contacts for deletion at this point
-        //NP all detected contacts will be un-marked by fix_contact->handleContact()
-        for(std::vector<int>::iterator it = particle_indices.begin(); it != particle_indices.end(); ++it) {
-          fix_contact->markForDeletion(0, *it);
-        }
-      }
+      if(fix_contact)
+        fix_contact->nextGeneration();
 
       //NP extremely dirty; this is that FixWallGranBase can use fix_wallforce_contact_
       //NP pointer for both primitive and mesh case
       if(store_force_contact_)
         fix_wallforce_contact_ = FixMesh_list_[iMesh]->meshforceContact();
     }
-    //if (screen) fprintf(screen, "[%d] Mark All took %g seconds.\n", tid, MPI_Wtime() - markAllTime);
 
     for(int iMesh = 0; iMesh < n_FixMesh_; iMesh++)
     {
@@ -774,6 +871,10 @@ void FixWallGran::post_force_mesh(int vflag)
       {
         double ***vMesh = vMeshC->begin();
 
+        //NP rigid frame: contact is resolved in the frame of the mesh nodes
+        const bool rigidFrame = mesh->rigidFrame();
+        double xFrame[3];
+
         // loop owned and ghost triangles
         for(int iTri = 0; iTri < nTriAll; iTri++)
         {
@@ -789,6 +890,13 @@ void FixWallGran::post_force_mesh(int vflag)
 
             int idTri = mesh->id(iTri);
 
+            double *xPart = x_[iPart];
+            if(rigidFrame)
+            {
+              mesh->pointToFrame(x_[iPart],xFrame);
+              xPart = xFrame;
+            }
+
 #ifdef SUPERQUADRIC_ACTIVE_FLAG
             if(atom->superquadric_flag)
             {
@@ -807,10 +915,10 @@ void FixWallGran::post_force_mesh(int vflag)
             }
             else
             {
-              deltan = mesh->resolveTriSphereContactBary(iPart,iTri,radius_ ? radius_[iPart]:r0_,x_[iPart],delta,bary);
+              deltan = mesh->resolveTriSphereContactBary(iPart,iTri,radius_ ? radius_[iPart]:r0_,xPart,delta,bary);
             }
 #else
-            deltan = mesh->resolveTriSphereContactBary(iPart,iTri,radius_ ? radius_[iPart]:r0_ ,x_[iPart],delta,bary);
+            deltan = mesh->resolveTriSphereContactBary(iPart,iTri,radius_ ? radius_[iPart]:r0_ ,xPart,delta,bary);
 #endif
 
             if(deltan > cutneighmax_) continue;
@@ -821,8 +929,16 @@ void FixWallGran::post_force_mesh(int vflag)
             {
               if(fix_contact && ! fix_contact->handleContact(iPart,idTri,cdata.contact_history)) continue;
 
-              for(int i = 0; i < 3; i++)
-                v_wall[i] = (bary[0]*vMesh[iTri][0][i] + bary[1]*vMesh[iTri][1][i] + bary[2]*vMesh[iTri][2][i]);
+              if(rigidFrame)
+              {
+                mesh->vectorFromFrame(delta);
+                mesh->frameVelocity(iTri,bary,v_wall);
+              }
+              else
+              {
+                for(int i = 0; i < 3; i++)
+                  v_wall[i] = (bary[0]*vMesh[iTri][0][i] + bary[1]*vMesh[iTri][1][i] + bary[2]*vMesh[iTri][2][i]);
+              }
 
               cdata.i = iPart;
               cdata.deltan = -deltan;
@@ -899,25 +1015,8 @@ void FixWallGran::post_force_mesh(int vflag)
       }
     }
 
-  // clean-up contacts
-  //NP i.e. delete all which have not been detected this time-step
-  //NP have to do this here: values cannot be deleted before
-  //NP since must be available to copy contact history for coplanar neighs
-  //double cleanupTime = MPI_Wtime();
-  for(int iMesh = 0; iMesh < n_FixMesh_; iMesh++)
-  {
-    FixContactHistoryMesh *fix_contact = FixMesh_list_[iMesh]->contactHistory();
-      // clean-up contacts
-      //NP i.e. delete all which have not been detected this time-step
-      if(fix_contact) {
-        FixNeighlistMesh * meshNeighlist = static_cast<FixNeighlistMesh*>(FixMesh_list_[iMesh]->meshNeighlist());
-        std::vector<int> & particle_indices = meshNeighlist->particle_indices;
-
-        for(std::vector<int>::iterator it = particle_indices.begin(); it != particle_indices.end(); ++it) {
-          fix_contact->cleanUpContact(*it);
-        }
-      }
-  }
+  //NP contacts which have not been detected this time-step expire with
+  //NP the next evaluation, no clean-up needed here
 }
 
 /* ----------------------------------------------------------------------
@@ -1038,6 +1137,9 @@ inline void FixWallGran::post_force_eval_contact(CollisionData & cdata, bool int
   cdata.meff = rmass_ ? rmass_[iPart] : atom->mass[atom->type[iPart]];
   cdata.area_ratio = 1.;
 
+  if(fix_sleep_ && vectorMag3DSquared(v_wall) > 0.)
+    fix_sleep_->wake(iPart);
+
   ForceData i_forces;
   ForceData j_forces;
 
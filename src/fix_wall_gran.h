@@ -223,6 +223,7 @@ class FixWallGran : public Fix, public LIGGGHTS::IContactHistorySetup {
   int n_FixMesh_;
   class FixMeshSurface **FixMesh_list_;
   class FixRigid *fix_rigid_;
+  class FixSleep *fix_sleep_;
   int *body_;
   double *masstotal_;
 
@@ -244,6 +245,8 @@ class FixWallGran : public Fix, public LIGGGHTS::IContactHistorySetup {
   class FixContactPropertyAtomWall *fix_wallforce_contact_;
 
   int nlevels_respa_;
+  int respa_level_;   // rRESPA level set by user, 0 for outermost
+  int ilevel_respa_;  // rRESPA level the wall force is computed at
 
   int shear_, shearDim_, shearAxis_;
   double vshear_;
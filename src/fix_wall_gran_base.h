@@ -94,6 +94,7 @@ public:
     Settings settings(lmp);
     cmodel.registerSettings(settings);
     bool success = settings.parseArguments(nargs, args);
+    if(success) cmodel.postSettings();
 
 #ifdef LIGGGHTS_DEBUG
     if(comm->me == 0) {
@@ -58,6 +58,7 @@ namespace LAMMPS_NS
           void delRestart(int n,bool scale,bool translate,bool rotate);
           void delRestart(bool scale,bool translate,bool rotate);
           void clearReverse(bool scale,bool translate,bool rotate);
+          void addToElement(int i, const double *buf);
 
           void get(int n, T** elem);
 
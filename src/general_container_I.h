@@ -221,6 +221,19 @@
                     arr_[i][j][k] = 0.;
   }
 
+  /* ----------------------------------------------------------------------
+   add NUM_VEC*LEN_VEC values to element i, e.g. from a reduction buffer
+  ------------------------------------------------------------------------- */
+
+  template<typename T, int NUM_VEC, int LEN_VEC>
+  void GeneralContainer<T,NUM_VEC,LEN_VEC>::addToElement(int i, const double *buf)
+  {
+      int m = 0;
+      for(int j = 0; j < NUM_VEC; j++)
+          for(int k = 0; k < LEN_VEC; k++)
+              arr_[i][j][k] += static_cast<T>(buf[m++]);
+  }
+
   /* ----------------------------------------------------------------------
    delete an element if restart
   ------------------------------------------------------------------------- */
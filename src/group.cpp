@@ -186,9 +186,14 @@ void Group::assign(int narg, char **arg)
     domain->regions[iregion]->init();
     domain->regions[iregion]->prematch();
 
+    int *flag;
+    memory->create(flag,nlocal,"group:flag");
+    domain->regions[iregion]->match_batch(nlocal,x,flag);
+
     for (i = 0; i < nlocal; i++)
-      if (domain->regions[iregion]->match(x[i][0],x[i][1],x[i][2]))
-        mask[i] |= bit;
+      if (flag[i]) mask[i] |= bit;
+
+    memory->destroy(flag);
 
   // style = type, molecule, id
 
@@ -53,6 +53,7 @@
 #include "special.h"
 #include "variable.h"
 #include "accelerator_cuda.h"
+#include "timer.h"
 #include "error.h"
 #include "memory.h"
 
@@ -592,6 +593,7 @@ int Input::execute_command()
   else if (!strcmp(command,"unfix")) unfix();
   else if (!strcmp(command,"units")) units();
   else if (!strcmp(command,"modify_timing")) modify_timing(); //NP modified by R.B.
+  else if (!strcmp(command,"timer_trace")) timer_trace();
   else if (!strcmp(command,"partitioner_style")) partitioner_style(); //NP modified by R.B.
   else flag = 0;
 
@@ -1420,13 +1422,22 @@ void Input::modify_timing()
 {
   int timing = 0;
 
-  if (narg == 1) {
+  if (narg == 1 || narg == 3) {
     if (strcmp(arg[0],"off") == 0) timing = 0;
     else if (strcmp(arg[0],"on") == 0) timing = 1;
     else if (strcmp(arg[0],"verbose") == 0) timing = 2;
     else error->all(FLERR,"Illegal modify_timing command");
   } else error->all(FLERR,"Illegal modify_timing command");
 
+  delete [] modify->timing_file;
+  modify->timing_file = NULL;
+  if (narg == 3) {
+    if (strcmp(arg[1],"file") != 0) error->all(FLERR,"Illegal modify_timing command");
+    int n = strlen(arg[2]) + 1;
+    modify->timing_file = new char[n];
+    strcpy(modify->timing_file,arg[2]);
+  }
+
   modify->timing = timing;
 }
 
@@ -1637,6 +1648,36 @@ void Input::timestep()
 
 /* ---------------------------------------------------------------------- */
 
+void Input::timer_trace()
+{
+  if (narg == 1 && strcmp(arg[0],"off") == 0) {
+    timer->trace_setup(0,0,NULL);
+    return;
+  }
+
+  if (narg < 4 || strcmp(arg[0],"file") != 0 || strcmp(arg[2],"every") != 0)
+    error->all(FLERR,"Illegal timer_trace command");
+
+  int every = force->inumeric(FLERR,arg[3]);
+  int maxevents = 1000000;
+
+  int iarg = 4;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"maxevents") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal timer_trace command");
+      maxevents = force->inumeric(FLERR,arg[iarg+1]);
+      iarg += 2;
+    } else error->all(FLERR,"Illegal timer_trace command");
+  }
+
+  if (every <= 0 || maxevents <= 0)
+    error->all(FLERR,"Illegal timer_trace command");
+
+  timer->trace_setup(every,maxevents,arg[1]);
+}
+
+/* ---------------------------------------------------------------------- */
+
 void Input::uncompute()
 {
   if (narg != 1) error->all(FLERR,"Illegal uncompute command");
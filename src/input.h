@@ -137,6 +137,7 @@ class Input : protected Pointers {
   void thermo_style();
   void thermo_log();
   void timestep();
+  void timer_trace();
   void uncompute();
   void undump();
   void unfix();
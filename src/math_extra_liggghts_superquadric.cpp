@@ -774,9 +774,10 @@ double determinant_4x4(double *mat)
 }
 
 void calc_contact_point(Superquadric *particleA, Superquadric *particleB,
-    double ratio, const double *initial_point1, double *result_point, double &fi, double &fj, bool *fail, LAMMPS_NS::Error *error)
+    double ratio, const double *initial_point1, double *result_point, double &fi, double &fj, bool *fail, LAMMPS_NS::Error *error,
+    double tolerance, double *merit)
 {
-  const double tol1 = 1e-10; //tolerance
+  const double tol1 = tolerance; //tolerance
   const double tol2 = 1e-12;
   *fail = false;
 
@@ -798,6 +799,7 @@ void calc_contact_point(Superquadric *particleA, Superquadric *particleB,
     LAMMPS_NS::vectorCopy3D(gradB1, particleB->gradient);
     fi = fi1;
     fj = fj1;
+    if(merit) *merit = merit01;
     return; //finish if initial guess is good enough
   }
 
@@ -834,6 +836,7 @@ void calc_contact_point(Superquadric *particleA, Superquadric *particleB,
 
   if(merit0 < tol1) {
     LAMMPS_NS::vectorCopy3D(point, result_point);
+    if(merit) *merit = merit0;
     return; //finish if the solution for spheres is good enough
   }
 
@@ -1014,6 +1017,7 @@ void calc_contact_point(Superquadric *particleA, Superquadric *particleB,
       break;
     }
   }
+  if(merit) *merit = merit1;
 }
 
 const int ndim = 8;
@@ -1435,13 +1439,26 @@ bool calc_contact_point_if_no_previous_point_avaialable(CollisionData & cdata, S
 
 //calculate the contact point using information from previous step
 bool calc_contact_point_using_prev_step(CollisionData & cdata, Superquadric *particleA, Superquadric *particleB,
-    double ratio, double dt, double *prev_step_point, double *contact_point, double &fi, double &fj, LAMMPS_NS::Error *error)
+    double ratio, double dt, double *prev_step_point, double *contact_point, double &fi, double &fj, LAMMPS_NS::Error *error,
+    double tolerance, double *merit)
 {
   bool fail_flag = false;
 
   #ifdef SUPERQUADRIC_ACTIVE_FLAG
 
   double estimation[3];
+  estimate_contact_point_using_prev_step(cdata, particleA, particleB, dt, prev_step_point, estimation);
+
+  MathExtraLiggghtsNonspherical::calc_contact_point(particleA, particleB, ratio, estimation, contact_point, fi, fj, &fail_flag, error, tolerance, merit);
+  #endif
+
+  return fail_flag;
+}
+
+//move the contact point of the previous step with the average velocity of both particles at that point
+void estimate_contact_point_using_prev_step(CollisionData & cdata, Superquadric *particleA, Superquadric *particleB,
+    double dt, const double *prev_step_point, double *estimation)
+{
   double xci[3], xcj[3], v_rot_i[3], v_rot_j[3], vi[3], vj[3];
   LAMMPS_NS::vectorSubtract3D(prev_step_point, particleA->center, xci);
   LAMMPS_NS::vectorSubtract3D(prev_step_point, particleB->center, xcj);
@@ -1458,11 +1475,14 @@ bool calc_contact_point_using_prev_step(CollisionData & cdata, Superquadric *par
 
   for(int k = 0; k < 3; k++)
     estimation[k] = prev_step_point[k] + v_eff[k]*dt; //contact point estimation
+}
 
-  MathExtraLiggghtsNonspherical::calc_contact_point(particleA, particleB, ratio, estimation, contact_point, fi, fj, &fail_flag, error);
-  #endif
-
-  return fail_flag;
+//evaluate shape functions and gradients at a given contact point without iterating, returns merit
+double contact_point_props(Superquadric *particleA, Superquadric *particleB, const double *point, double &fi, double &fj)
+{
+  double mu, merit, F[4];
+  calc_F(particleA, particleB, fi, fj, particleA->gradient, particleB->gradient, NULL, NULL, point, &mu, F, &merit);
+  return merit;
 }
 
 //basic estimation of the overlap magnitude
@@ -84,6 +84,13 @@ void MeshMoverLinear::initial_integrate(double dTAbs,double dTSetup,double dt)
     mesh_->move(dX,dx);
 
     // set mesh velocity
+    if(mesh_->rigidFrame())
+    {
+        const double zero[3] = {0.,0.,0.};
+        mesh_->setFrameVelocity(vel_,zero,zero);
+        return;
+    }
+
     for (int i = 0; i < size; i++)
         for(int j = 0; j < numNodes; j++)
             vectorAdd3D(v_node[i][j],vel_,v_node[i][j]);
@@ -273,6 +280,13 @@ void MeshMoverWiggle::initial_integrate(double dTAbs,double dTSetup,double dt)
     mesh_->move(dX,dx);
 
     // set mesh velocity
+    if(mesh_->rigidFrame())
+    {
+        const double zero[3] = {0.,0.,0.};
+        mesh_->setFrameVelocity(vNode,zero,zero);
+        return;
+    }
+
     for (int i = 0; i < size; i++)
         for(int j = 0; j < numNodes; j++)
             vectorAdd3D(v_node[i][j],vNode,v_node[i][j]);
@@ -347,6 +361,13 @@ void MeshMoverRotate::initial_integrate(double dTAbs,double dTSetup,double dt)
     // set mesh velocity, w x rPA
     vectorScalarMult3D(axis_,omega_,omegaVec);
 
+    if(mesh_->rigidFrame())
+    {
+        const double zero[3] = {0.,0.,0.};
+        mesh_->setFrameVelocity(zero,omegaVec,reference_point);
+        return;
+    }
+
     #if defined(_OPENMP)
     #pragma omp parallel for shared(reference_point,omegaVec)
     #endif
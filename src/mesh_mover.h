@@ -59,6 +59,11 @@ namespace LAMMPS_NS
         inline bool isFirst()
         { return isFirst_; }
 
+        // true if the mover is a rigid body motion that sets the
+        // frame velocity in rigid frame mode
+        virtual bool supportsRigidFrame()
+        { return false; }
+
         virtual int n_restart()
         { return 0; }
 
@@ -113,6 +118,8 @@ namespace LAMMPS_NS
         void final_integrate(double dTAbs,double dTSetup,double dt) {}
         void pre_delete();
         void post_create();
+        bool supportsRigidFrame()
+        { return true; }
 
       private:
 
@@ -163,6 +170,8 @@ namespace LAMMPS_NS
         void final_integrate(double dTAbs,double dTSetup,double dt) {}
         void pre_delete();
         void post_create();
+        bool supportsRigidFrame()
+        { return true; }
 
       private:
 
@@ -185,6 +194,8 @@ namespace LAMMPS_NS
         void final_integrate(double dTAbs,double dTSetup,double dt) {}
         void pre_delete();
         void post_create();
+        bool supportsRigidFrame()
+        { return true; }
 
       private:
 
@@ -70,6 +70,8 @@ Modify::Modify(LAMMPS *lmp) : Pointers(lmp)
   n_final_integrate = n_end_of_step = n_thermo_energy = 0;
   n_initial_integrate_respa = n_post_integrate_respa = 0;
   n_pre_force_respa = n_post_force_respa = n_final_integrate_respa = 0;
+  n_initial_integrate_outer = n_post_integrate_outer = 0;
+  n_pre_force_outer = n_post_force_outer = n_final_integrate_outer = 0;
   n_min_pre_exchange = n_min_pre_force = n_min_post_force = n_min_energy = 0;
   n_min_pre_neighbor = 0;
 
@@ -84,6 +86,9 @@ Modify::Modify(LAMMPS *lmp) : Pointers(lmp)
   list_initial_integrate_respa = list_post_integrate_respa = NULL;
   list_pre_force_respa = list_post_force_respa = NULL;
   list_final_integrate_respa = NULL;
+  list_initial_integrate_outer = list_post_integrate_outer = NULL;
+  list_pre_force_outer = list_post_force_outer = NULL;
+  list_final_integrate_outer = NULL;
   list_min_pre_exchange = list_min_pre_neighbor = NULL;
   list_min_pre_force = list_min_post_force = NULL;
   list_min_energy = NULL;
@@ -103,6 +108,8 @@ Modify::Modify(LAMMPS *lmp) : Pointers(lmp)
   compute = NULL;
 
   timing = 0;
+  timing_hook = TIME_HOOK_OTHER;
+  timing_file = NULL;
 
   // fill map with fixes listed in style_fix.h
 
@@ -131,6 +138,8 @@ Modify::Modify(LAMMPS *lmp) : Pointers(lmp)
 
 Modify::~Modify()
 {
+  delete [] timing_file;
+
   // delete all fixes
   // do it via delete_fix() so callbacks in Atom are also updated correctly
 
@@ -158,6 +167,11 @@ Modify::~Modify()
   delete [] list_pre_force_respa;
   delete [] list_post_force_respa;
   delete [] list_final_integrate_respa;
+  delete [] list_initial_integrate_outer;
+  delete [] list_post_integrate_outer;
+  delete [] list_pre_force_outer;
+  delete [] list_post_force_outer;
+  delete [] list_final_integrate_outer;
   delete [] list_min_pre_exchange;
   delete [] list_min_pre_neighbor;
   delete [] list_min_pre_force;
@@ -210,6 +224,17 @@ void Modify::init()
   list_init(FINAL_INTEGRATE_RESPA,
             n_final_integrate_respa,list_final_integrate_respa);
 
+  list_init_outer(INITIAL_INTEGRATE,INITIAL_INTEGRATE_RESPA,
+                  n_initial_integrate_outer,list_initial_integrate_outer);
+  list_init_outer(POST_INTEGRATE,POST_INTEGRATE_RESPA,
+                  n_post_integrate_outer,list_post_integrate_outer);
+  list_init_outer(PRE_FORCE,PRE_FORCE_RESPA,
+                  n_pre_force_outer,list_pre_force_outer);
+  list_init_outer(POST_FORCE,POST_FORCE_RESPA,
+                  n_post_force_outer,list_post_force_outer);
+  list_init_outer(FINAL_INTEGRATE,FINAL_INTEGRATE_RESPA,
+                  n_final_integrate_outer,list_final_integrate_outer);
+
   list_init(MIN_PRE_EXCHANGE,n_min_pre_exchange,list_min_pre_exchange);
   list_init(MIN_PRE_FORCE,n_min_pre_force,list_min_pre_force);
   list_init(MIN_POST_FORCE,n_min_post_force,list_min_post_force);
@@ -370,7 +395,9 @@ void Modify::initial_integrate(int vflag)
   /*NL*/// if (screen) fprintf(screen,"proc %d executing initial_integrate for %s\n",
   /*NL*///                                      comm->me,fix[list_initial_integrate[i]]->style);
   /*NL*/// __debug__(lmp);}
+  timing_hook = TIME_HOOK_INITIAL_INTEGRATE;
   call_method_on_fixes(&Fix::initial_integrate, vflag, list_initial_integrate, n_initial_integrate);
+  timing_hook = TIME_HOOK_OTHER;
 }
 
 /* ----------------------------------------------------------------------
@@ -379,7 +406,9 @@ void Modify::initial_integrate(int vflag)
 
 void Modify::post_integrate()
 {
+  timing_hook = TIME_HOOK_POST_INTEGRATE;
   call_method_on_fixes(&Fix::post_integrate, list_post_integrate, n_post_integrate);
+  timing_hook = TIME_HOOK_OTHER;
 }
 
 /* ----------------------------------------------------------------------
@@ -390,7 +419,9 @@ void Modify::pre_exchange()
 {
   /*NL*/ //if(667 == update->ntimestep && screen) fprintf(screen,"proc %d executing pre_exch for %s\n",
   /*NL*/ //                                     comm->me,fix[list_pre_exchange[i]]->style);
+  timing_hook = TIME_HOOK_PRE_EXCHANGE;
   call_method_on_fixes(&Fix::pre_exchange, list_pre_exchange, n_pre_exchange);
+  timing_hook = TIME_HOOK_OTHER;
 }
 
 /* ----------------------------------------------------------------------
@@ -401,7 +432,9 @@ void Modify::pre_neighbor()
 {
   /*NL*/ //(update->ntimestep == 1254 && screen) fprintf(screen,"proc %d executing pre_neigh for %s\n",
   /*NL*/ //                                    comm->me,fix[list_pre_neighbor[i]]->style);
+  timing_hook = TIME_HOOK_PRE_NEIGHBOR;
   call_method_on_fixes(&Fix::pre_neighbor, list_pre_neighbor, n_pre_neighbor);
+  timing_hook = TIME_HOOK_OTHER;
 }
 
 /* ----------------------------------------------------------------------
@@ -412,7 +445,9 @@ void Modify::pre_force(int vflag)
 {
   /*NL*/// if(update->ntimestep > 54500 && screen) fprintf(screen,"proc %d executing pre_force for %s\n",
   /*NL*///                                     comm->me,fix[list_pre_force[i]]->style);
+  timing_hook = TIME_HOOK_PRE_FORCE;
   call_method_on_fixes(&Fix::pre_force, vflag, list_pre_force, n_pre_force);
+  timing_hook = TIME_HOOK_OTHER;
 }
 
 /* ----------------------------------------------------------------------
@@ -425,7 +460,9 @@ void Modify::post_force(int vflag)
   /*NL*/// if (screen) fprintf(screen,"proc %d executing post_force for %s\n",
   /*NL*///                                      comm->me,fix[list_post_force[i]]->style);
   /*NL*/// __debug__(lmp);}
+  timing_hook = TIME_HOOK_POST_FORCE;
   call_method_on_fixes_omp(&Fix::post_force, vflag, list_post_force, n_post_force, list_post_force_omp, n_post_force_omp);
+  timing_hook = TIME_HOOK_OTHER;
 }
 
 /* ----------------------------------------------------------------------
@@ -447,7 +484,9 @@ bool Modify::iterate_implicitly()
 
 void Modify::final_integrate()
 {
+  timing_hook = TIME_HOOK_FINAL_INTEGRATE;
   call_method_on_fixes(&Fix::final_integrate, list_final_integrate, n_final_integrate);
+  timing_hook = TIME_HOOK_OTHER;
 }
 
 /* ----------------------------------------------------------------------
@@ -457,13 +496,13 @@ void Modify::final_integrate()
 
 void Modify::end_of_step()
 {
-  if(timing) {
+  if(timed()) {
     for (int i = 0; i < n_end_of_step; i++) {
       if (update->ntimestep % end_of_step_every[i] == 0) {
         const int ifix = list_end_of_step[i];
-        fix[ifix]->begin_time_recording();
+        begin_fix_call(ifix);
         fix[ifix]->end_of_step();
-        fix[ifix]->end_time_recording();
+        end_fix_call(ifix,TIME_HOOK_END_OF_STEP);
       }
     }
   }
@@ -486,12 +525,12 @@ void Modify::end_of_step()
 double Modify::thermo_energy()
 {
   double energy = 0.0;
-  if(timing) {
+  if(timed()) {
     for (int i = 0; i < n_thermo_energy; i++) {
       const int ifix = list_thermo_energy[i];
-      fix[ifix]->begin_time_recording();
+      begin_fix_call(ifix);
       energy += fix[ifix]->compute_scalar();
-      fix[ifix]->end_time_recording();
+      end_fix_call(ifix,TIME_HOOK_OTHER);
     }
   }
   else
@@ -572,6 +611,62 @@ void Modify::final_integrate_respa(int ilevel, int iloop)
       list_final_integrate_respa, n_final_integrate_respa);
 }
 
+/* ----------------------------------------------------------------------
+   Verlet hooks of fixes that have no rRESPA counterpart
+   called by rRESPA at the outermost level, so fixes like mesh movement,
+   mesh neighbor lists or CFD coupling also work with run_style respa
+------------------------------------------------------------------------- */
+
+void Modify::setup_pre_force_outer(int vflag)
+{
+  call_method_on_fixes(&Fix::setup_pre_force, vflag, list_pre_force_outer, n_pre_force_outer);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Modify::initial_integrate_outer(int vflag)
+{
+  timing_hook = TIME_HOOK_INITIAL_INTEGRATE;
+  call_method_on_fixes(&Fix::initial_integrate, vflag, list_initial_integrate_outer, n_initial_integrate_outer);
+  timing_hook = TIME_HOOK_OTHER;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Modify::post_integrate_outer()
+{
+  timing_hook = TIME_HOOK_POST_INTEGRATE;
+  call_method_on_fixes(&Fix::post_integrate, list_post_integrate_outer, n_post_integrate_outer);
+  timing_hook = TIME_HOOK_OTHER;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Modify::pre_force_outer(int vflag)
+{
+  timing_hook = TIME_HOOK_PRE_FORCE;
+  call_method_on_fixes(&Fix::pre_force, vflag, list_pre_force_outer, n_pre_force_outer);
+  timing_hook = TIME_HOOK_OTHER;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Modify::post_force_outer(int vflag)
+{
+  timing_hook = TIME_HOOK_POST_FORCE;
+  call_method_on_fixes(&Fix::post_force, vflag, list_post_force_outer, n_post_force_outer);
+  timing_hook = TIME_HOOK_OTHER;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Modify::final_integrate_outer()
+{
+  timing_hook = TIME_HOOK_FINAL_INTEGRATE;
+  call_method_on_fixes(&Fix::final_integrate, list_final_integrate_outer, n_final_integrate_outer);
+  timing_hook = TIME_HOOK_OTHER;
+}
+
 /* ----------------------------------------------------------------------
    minimizer pre-exchange call, only for relevant fixes
 ------------------------------------------------------------------------- */
@@ -1296,6 +1391,25 @@ void Modify::list_init(int mask, int &n, int *&list)
   for (int i = 0; i < nfix; i++) if (fmask[i] & mask) list[n++] = i;
 }
 
+/* ----------------------------------------------------------------------
+   create list of fix indices for fixes which match mask
+   but have no rRESPA counterpart respamask
+------------------------------------------------------------------------- */
+
+void Modify::list_init_outer(int mask, int respamask, int &n, int *&list)
+{
+  delete [] list;
+
+  n = 0;
+  for (int i = 0; i < nfix; i++)
+    if ((fmask[i] & mask) && !(fmask[i] & respamask)) n++;
+  list = new int[n];
+
+  n = 0;
+  for (int i = 0; i < nfix; i++)
+    if ((fmask[i] & mask) && !(fmask[i] & respamask)) list[n++] = i;
+}
+
 /* ----------------------------------------------------------------------
    create list of fix indices for end_of_step fixes
    also create end_of_step_every[]
@@ -1380,11 +1494,11 @@ bigint Modify::memory_usage()
 ------------------------------------------------------------------------- */
 
 void Modify::call_method_on_fixes(FixMethod method) {
-  if(timing) {
+  if(timed()) {
     for (int i = 0; i < nfix; i++) {
-      fix[i]->begin_time_recording();
+      begin_fix_call(i);
       (fix[i]->*method)();
-      fix[i]->end_time_recording();
+      end_fix_call(i,timing_hook);
     }
   }
   else
@@ -1400,12 +1514,12 @@ void Modify::call_method_on_fixes(FixMethod method) {
 ------------------------------------------------------------------------- */
 
 void Modify::call_method_on_fixes(FixMethod method, int *& ilist, int & inum) {
-  if(timing) {
+  if(timed()) {
     for (int i = 0; i < inum; i++) {
       const int ifix = ilist[i];
-      fix[ifix]->begin_time_recording();
+      begin_fix_call(ifix);
       (fix[ifix]->*method)();
-      fix[ifix]->end_time_recording();
+      end_fix_call(ifix,timing_hook);
     }
   }
   else
@@ -1421,11 +1535,11 @@ void Modify::call_method_on_fixes(FixMethod method, int *& ilist, int & inum) {
 ------------------------------------------------------------------------- */
 
 void Modify::call_method_on_fixes(FixMethodWithVFlag method, int vflag) {
-  if(timing) {
+  if(timed()) {
     for (int i = 0; i < nfix; i++) {
-      fix[i]->begin_time_recording();
+      begin_fix_call(i);
       (fix[i]->*method)(vflag);
-      fix[i]->end_time_recording();
+      end_fix_call(i,timing_hook);
     }
   }
   else
@@ -1442,12 +1556,12 @@ void Modify::call_method_on_fixes(FixMethodWithVFlag method, int vflag) {
 ------------------------------------------------------------------------- */
 
 void Modify::call_method_on_fixes(FixMethodWithVFlag method, int vflag, int *& ilist, int & inum) {
-  if(timing) {
+  if(timed()) {
     for (int i = 0; i < inum; i++) {
       const int ifix = ilist[i];
-      fix[ifix]->begin_time_recording();
+      begin_fix_call(ifix);
       (fix[ifix]->*method)(vflag);
-      fix[ifix]->end_time_recording();
+      end_fix_call(ifix,timing_hook);
     }
   }
   else
@@ -1466,14 +1580,14 @@ void Modify::call_method_on_fixes(FixMethodWithVFlag method, int vflag, int *& i
 
 void Modify::call_method_on_fixes_omp(FixMethodWithVFlag method, int vflag, int *& ilist, int & inum, int *& plist, int & pnum) {
 #if defined(_OPENMP)
-  if(timing) {
+  if(timed()) {
     int i = 0;
     while (i < inum) {
       int ifix = ilist[i];
       if(!(fmask[ifix] & PARALLEL_OPENMP)) {
-        fix[ifix]->begin_time_recording();
+        begin_fix_call(ifix);
         (fix[ifix]->*method)(vflag);
-        fix[ifix]->end_time_recording();
+        end_fix_call(ifix,timing_hook);
       }
       else
       {
@@ -1486,7 +1600,7 @@ void Modify::call_method_on_fixes_omp(FixMethodWithVFlag method, int vflag, int
             ifix = ilist[i];
             if (fmask[ifix] & PARALLEL_OPENMP) {
               #pragma omp single
-              fix[ifix]->begin_time_recording();
+              begin_fix_call(ifix);
 
               (fix[ifix]->*method)(vflag);
 
@@ -1494,7 +1608,7 @@ void Modify::call_method_on_fixes_omp(FixMethodWithVFlag method, int vflag, int
 
               #pragma omp single
               {
-                fix[ifix]->end_time_recording();
+                end_fix_call(ifix,timing_hook);
                 i++;
               }
             }
@@ -1553,12 +1667,12 @@ void Modify::call_method_on_fixes_omp(FixMethodWithVFlag method, int vflag, int
 
 void Modify::call_respa_method_on_fixes(FixMethodRESPA2 method,
     int arg1, int arg2, int *& ilist, int & inum) {
-  if(timing) {
+  if(timed()) {
     for (int i = 0; i < inum; i++) {
       const int ifix = ilist[i];
-      fix[ifix]->begin_time_recording();
+      begin_fix_call(ifix);
       (fix[ifix]->*method)(arg1, arg2);
-      fix[ifix]->end_time_recording();
+      end_fix_call(ifix,timing_hook);
     }
   }
   else
@@ -1576,12 +1690,12 @@ void Modify::call_respa_method_on_fixes(FixMethodRESPA2 method,
 
 void Modify::call_respa_method_on_fixes(FixMethodRESPA3 method, int arg1,
     int arg2, int arg3, int *& ilist, int & inum) {
-  if(timing) {
+  if(timed()) {
     for (int i = 0; i < inum; i++) {
       const int ifix = ilist[i];
-      fix[ifix]->begin_time_recording();
+      begin_fix_call(ifix);
       (fix[ifix]->*method)(arg1, arg2, arg3);
-      fix[ifix]->end_time_recording();
+      end_fix_call(ifix,timing_hook);
     }
   }
   else
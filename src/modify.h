@@ -26,6 +26,7 @@
 
 #include <stdio.h>
 #include "pointers.h"
+#include "timer.h"
 #include "fix.h"
 #include <map>
 #include <string>
@@ -41,6 +42,8 @@ class Modify : protected Pointers {
   int n_final_integrate,n_end_of_step,n_thermo_energy;
   int n_initial_integrate_respa,n_post_integrate_respa;
   int n_pre_force_respa,n_post_force_respa,n_final_integrate_respa;
+  int n_initial_integrate_outer,n_post_integrate_outer;
+  int n_pre_force_outer,n_post_force_outer,n_final_integrate_outer;
   int n_min_pre_exchange,n_min_pre_neighbor;
   int n_min_pre_force,n_min_post_force,n_min_energy;
   int n_post_force_omp;
@@ -53,6 +56,8 @@ class Modify : protected Pointers {
   int *fmask;                // bit mask for when each fix is applied
 
   int timing;                // 1 if fix calls are timed
+  int timing_hook;           // fix hook currently being timed
+  char *timing_file;         // file for timing breakdown, NULL if none
 
   int ncompute,maxcompute;   // list of computes
   class Compute **compute;
@@ -84,6 +89,16 @@ class Modify : protected Pointers {
   void post_force_respa(int, int, int);
   void final_integrate_respa(int, int);
 
+  // Verlet hooks of fixes without rRESPA counterpart,
+  // invoked by rRESPA at the outermost level
+
+  void setup_pre_force_outer(int);
+  void initial_integrate_outer(int);
+  void post_integrate_outer();
+  void pre_force_outer(int);
+  void post_force_outer(int);
+  void final_integrate_outer();
+
   void min_pre_exchange();
   void min_pre_neighbor();
   void min_pre_force(int);
@@ -159,6 +174,9 @@ class Modify : protected Pointers {
   int *list_initial_integrate_respa,*list_post_integrate_respa;
   int *list_pre_force_respa,*list_post_force_respa;
   int *list_final_integrate_respa;
+  int *list_initial_integrate_outer,*list_post_integrate_outer;
+  int *list_pre_force_outer,*list_post_force_outer;
+  int *list_final_integrate_outer;
   int *list_min_pre_exchange,*list_min_pre_neighbor;
   int *list_min_pre_force,*list_min_post_force;
   int *list_min_energy;
@@ -180,6 +198,7 @@ class Modify : protected Pointers {
   int index_permanent;        // fix/compute index returned to library call
 
   void list_init(int, int &, int *&);
+  void list_init_outer(int, int, int &, int *&);
   void list_init_end_of_step(int, int &, int *&);
   void list_init_thermo_energy(int, int &, int *&);
   void list_init_compute();
@@ -194,6 +213,22 @@ private:
   inline void call_respa_method_on_fixes(FixMethodRESPA2 method, int arg1, int arg2, int *& ilist, int & inum);
   inline void call_respa_method_on_fixes(FixMethodRESPA3 method, int arg1, int arg2, int arg3, int *& ilist, int & inum);
 
+  // timing and tracing of a single fix call
+
+  inline bool timed() const {
+    return timing || timer->tracing();
+  }
+
+  inline void begin_fix_call(int ifix) {
+    timer->trace_begin(fix[ifix]->id);
+    fix[ifix]->begin_time_recording();
+  }
+
+  inline void end_fix_call(int ifix, int hook) {
+    fix[ifix]->end_time_recording(hook);
+    timer->trace_end(fix[ifix]->id);
+  }
+
   typedef Compute *(*ComputeCreator)(LAMMPS *, int, char **);
   std::map<std::string,ComputeCreator> *compute_map;
 
@@ -91,6 +91,51 @@ namespace LAMMPS_NS
         bool decideRebuild();
         void storeNodePosRebuild();
 
+        // rigid frame mode for rigidly moving meshes
+        //   node_ stays at the last materialized position, the current
+        //   position is node_ transformed by one rigid body motion
+        void setRigidFrame(bool _rigidFrame);
+        void setFrameVelocity(const double *vel, const double *omega, const double *origin);
+        virtual void materialize();
+
+        inline bool rigidFrame()
+        { return rigidFrame_; }
+
+        // transform a point from space into the frame of node_
+        inline void pointToFrame(const double *p, double *pFrame)
+        {
+            double d[3];
+            vectorSubtract3D(p,frameRelT_,d);
+            MathExtra::transpose_matvec(frameRelR_,d,pFrame);
+        }
+
+        // rotate a vector from the frame of node_ into space
+        inline void vectorFromFrame(double *vec)
+        {
+            double tmp[3];
+            MathExtra::matvec(frameRelR_,vec,tmp);
+            vectorCopy3D(tmp,vec);
+        }
+
+        // velocity of the frame at point p in space
+        inline void frameVelocityAt(const double *p, double *v)
+        {
+            vectorCross3D(frameOmega_,p,v);
+            vectorAdd3D(v,frameVel_,v);
+        }
+
+        // velocity of the point given by barycentric coords on element i
+        inline void frameVelocity(int i, const double *bary, double *v)
+        {
+            double pFrame[3],p[3];
+            vectorZeroize3D(pFrame);
+            for(int j = 0; j < NUM_NODES; j++)
+                vectorAddMultiple3D(pFrame,bary[j],node_(i)[j],pFrame);
+            MathExtra::matvec(frameRelR_,pFrame,p);
+            vectorAdd3D(p,frameRelT_,p);
+            frameVelocityAt(p,v);
+        }
+
         // inline access
 
         inline bool isMoving()
@@ -209,6 +254,9 @@ namespace LAMMPS_NS
         inline FILE* elementExclusionList()
         { return element_exclusion_list_; }
 
+        // transform node_ -> current position, returns false if identity
+        bool frameRel(double *qRel, double *tRel);
+
       private:
 
         // mesh precision
@@ -236,6 +284,21 @@ namespace LAMMPS_NS
 
         inline double*** nodePtr()
         { return node_.begin(); }
+
+        //NP rigid frame mode, poses are w.r.t. node_orig_
+        void resetFrame();
+        void resetFramePose();
+        void updateFrameRel();
+        void frameTranslate(const double *vec);
+        void frameRotate(const double *q, const double *origin);
+
+        bool rigidFrame_;
+        double frameQ_[4], frameT_[3];          // current pose
+        double frameMatQ_[4], frameMatT_[3];    // pose of node_
+        double frameRelR_[3][3], frameRelT_[3]; // node_ -> current position
+        double frameReQ_[4], frameReT_[3];      // pose at last re-build
+        double frameReCenter_[3], frameReRadius_; // bounding sphere of owned nodes at last re-build
+        double frameVel_[3], frameOmega_[3];    // v(p) = frameVel_ + frameOmega_ x p
   };
 
   // *************************************
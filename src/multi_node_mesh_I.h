@@ -49,8 +49,14 @@
     nScale_(0),
     nTranslate_(0),
     nRotate_(0),
-    stepLastReset_(-1)
+    stepLastReset_(-1),
+    rigidFrame_(false),
+    frameReRadius_(0.)
   {
+    resetFrame();
+    vectorZeroize3D(frameReCenter_);
+    vectorZeroize3D(frameVel_);
+    vectorZeroize3D(frameOmega_);
   }
 
   /* ----------------------------------------------------------------------
@@ -408,6 +414,10 @@
             vectorCopy3D(node_(i)[j],node_orig(i)[j]);
             /*NL*/ //if (this->screen) printVec3D(this->screen,"node orig",node_orig(i)[j]);
         }
+
+    //NP node_ must have been materialized before
+    if(rigidFrame_)
+        resetFrame();
   }
 
   /* ----------------------------------------------------------------------
@@ -426,8 +436,16 @@
 
     if(stepLastReset_ < ntimestep)
     {
-        const int nall = sizeLocal() + sizeGhost();
         stepLastReset_ = ntimestep;
+
+        //NP rigid frame: only the pose is reset, node_ is not touched
+        if(rigidFrame_)
+        {
+            resetFramePose();
+            return true;
+        }
+
+        const int nall = sizeLocal() + sizeGhost();
         node_.copy_n(*node_orig_, nall);
         return true;
     }
@@ -448,6 +466,12 @@
     //NP original position before
     resetToOrig();
 
+    if(rigidFrame_)
+    {
+        frameTranslate(vecTotal);
+        return;
+    }
+
     //NP need only move owned elements
     //NP copy sizeLocal() + sizeGhost() since cannot be inlined in this class
     const int n = sizeLocal() + sizeGhost();
@@ -474,6 +498,12 @@
   template<int NUM_NODES>
   void MultiNodeMesh<NUM_NODES>::move(const double *vecIncremental)
   {
+    if(rigidFrame_)
+    {
+        frameTranslate(vecIncremental);
+        return;
+    }
+
     //NP copy sizeLocal() + sizeGhost() since cannot be inlined in this class
     const int n = sizeLocal() + sizeGhost();
 
@@ -554,6 +584,14 @@
       reset = true;
     }
 
+    if(rigidFrame_)
+    {
+        if(reset)
+            resetFramePose();
+        frameRotate(totalQ,origin);
+        return;
+    }
+
     //NP copy sizeLocal() + sizeGhost() since cannot be inlined in this class
     const int n = sizeLocal() + sizeGhost();
 
@@ -667,6 +705,12 @@
   template<int NUM_NODES>
   void MultiNodeMesh<NUM_NODES>::rotate(const double *dQ, const double *origin)
   {
+    if(rigidFrame_)
+    {
+        frameRotate(dQ,origin);
+        return;
+    }
+
     //NP copy sizeLocal() + sizeGhost() since cannot be inlined in this class
     const int n = sizeLocal() + sizeGhost();
 
@@ -700,6 +744,9 @@
   template<int NUM_NODES>
   void MultiNodeMesh<NUM_NODES>::scale(double factor)
   {
+    if(rigidFrame_)
+        this->error->all(FLERR,"Cannot scale a mesh in rigid frame mode");
+
     //NP copy sizeLocal() + sizeGhost() since cannot be inlined in this class
     int n = sizeLocal() + sizeGhost();
 
@@ -824,6 +871,28 @@
     int nlocal = sizeLocal();
     double triggersq = 0.25*this->neighbor->skin*this->neighbor->skin;
 
+    //NP rigid frame: bound the displacement of all owned nodes by
+    //NP the one of the bounding sphere, |R - 1| = 2 sin(phi/2)
+    if(rigidFrame_)
+    {
+        double qReC[4],q[4],R[3][3],d[3],c[3];
+        MathExtra::qconjugate(frameReQ_,qReC);
+        MathExtra::quatquat(frameQ_,qReC,q);
+        MathExtra::quat_to_mat(q,R);
+
+        vectorSubtract3D(frameReCenter_,frameReT_,d);
+        MathExtra::matvec(R,d,c);
+        vectorAdd3D(c,frameT_,c);
+        vectorSubtract3D(c,frameReCenter_,c);
+
+        const double dist = vectorMag3D(c) + 2.*sqrt(q[1]*q[1]+q[2]*q[2]+q[3]*q[3])*frameReRadius_;
+        if(nlocal > 0 && dist*dist > triggersq)
+            flag = 1;
+
+        MPI_Max_Scalar(flag,this->world);
+        return flag;
+    }
+
     if(nlocal != nodesLastRe_.size())
         this->error->one(FLERR,"Internal error in MultiNodeMesh::decide_rebuild()");
 
@@ -867,9 +936,159 @@
     int nlocal = sizeLocal();
     double ***node = node_.begin();
 
+    //NP rigid frame: store pose of node_ and bounding sphere of owned nodes
+    if(rigidFrame_)
+    {
+        vectorCopy4D(frameMatQ_,frameReQ_);
+        vectorCopy3D(frameMatT_,frameReT_);
+
+        double d[3];
+        vectorZeroize3D(frameReCenter_);
+        frameReRadius_ = 0.;
+        if(0 == nlocal) return;
+
+        BoundingBox box;
+        for(int i = 0; i < nlocal; i++)
+            extendToElem(box,i);
+        box.getCenter(frameReCenter_);
+
+        for(int i = 0; i < nlocal; i++)
+            for(int j = 0; j < NUM_NODES; j++)
+            {
+                vectorSubtract3D(node[i][j],frameReCenter_,d);
+                frameReRadius_ = MathExtraLiggghts::max(frameReRadius_,vectorMag3D(d));
+            }
+        return;
+    }
+
     nodesLastRe_.clearContainer();
     for(int i = 0; i < nlocal; i++)
         nodesLastRe_.add(node[i]);
   }
 
+  /* ----------------------------------------------------------------------
+   rigid frame mode
+   poses map node_orig_ to space, node_ is node_orig_ transformed by the
+   pose it was last materialized with
+  ------------------------------------------------------------------------- */
+
+  template<int NUM_NODES>
+  void MultiNodeMesh<NUM_NODES>::setRigidFrame(bool _rigidFrame)
+  {
+    if(rigidFrame_ == _rigidFrame) return;
+
+    //NP leave frame mode with nodes at their current position
+    if(rigidFrame_)
+        materialize();
+
+    rigidFrame_ = _rigidFrame;
+    resetFrame();
+  }
+
+  template<int NUM_NODES>
+  void MultiNodeMesh<NUM_NODES>::setFrameVelocity(const double *vel, const double *omega, const double *origin)
+  {
+    //NP v(p) = vel + omega x (p - origin)
+    double tmp[3];
+    vectorCopy3D(omega,frameOmega_);
+    vectorCross3D(omega,origin,tmp);
+    vectorSubtract3D(vel,tmp,frameVel_);
+  }
+
+  template<int NUM_NODES>
+  void MultiNodeMesh<NUM_NODES>::materialize()
+  {
+    double qRel[4],tRel[3];
+    if(!rigidFrame_ || !frameRel(qRel,tRel)) return;
+
+    //NP transform from node_orig_, avoids accumulation of round-off
+    double R[3][3];
+    MathExtra::quat_to_mat(frameQ_,R);
+
+    const int n = sizeLocal() + sizeGhost();
+
+    for(int i = 0; i < n; i++)
+    {
+        vectorZeroize3D(center_(i));
+        for(int j = 0; j < NUM_NODES; j++)
+        {
+            MathExtra::matvec(R,node_orig(i)[j],node_(i)[j]);
+            vectorAdd3D(node_(i)[j],frameT_,node_(i)[j]);
+            vectorAdd3D(node_(i)[j],center_(i),center_(i));
+        }
+        vectorScalarDiv3D(center_(i),static_cast<double>(NUM_NODES));
+    }
+
+    vectorCopy4D(frameQ_,frameMatQ_);
+    vectorCopy3D(frameT_,frameMatT_);
+    updateFrameRel();
+
+    bbox_.setDirty(true);
+  }
+
+  template<int NUM_NODES>
+  bool MultiNodeMesh<NUM_NODES>::frameRel(double *qRel, double *tRel)
+  {
+    double qMatC[4];
+    MathExtra::qconjugate(frameMatQ_,qMatC);
+    MathExtra::quatquat(frameQ_,qMatC,qRel);
+    vectorCopy3D(frameRelT_,tRel);
+
+    return !(vectorMag3DSquared(tRel) == 0. && qRel[1] == 0. && qRel[2] == 0. && qRel[3] == 0.);
+  }
+
+  template<int NUM_NODES>
+  void MultiNodeMesh<NUM_NODES>::resetFrame()
+  {
+    resetFramePose();
+    vectorCopy4D(frameQ_,frameMatQ_);
+    vectorCopy3D(frameT_,frameMatT_);
+    vectorCopy4D(frameQ_,frameReQ_);
+    vectorCopy3D(frameT_,frameReT_);
+    updateFrameRel();
+  }
+
+  template<int NUM_NODES>
+  void MultiNodeMesh<NUM_NODES>::resetFramePose()
+  {
+    frameQ_[0] = 1.;
+    frameQ_[1] = frameQ_[2] = frameQ_[3] = 0.;
+    vectorZeroize3D(frameT_);
+    updateFrameRel();
+  }
+
+  template<int NUM_NODES>
+  void MultiNodeMesh<NUM_NODES>::updateFrameRel()
+  {
+    //NP x = R_rel x_mat + t_rel with R_rel = R R_mat^T, t_rel = t - R_rel t_mat
+    double qMatC[4],qRel[4],tmp[3];
+    MathExtra::qconjugate(frameMatQ_,qMatC);
+    MathExtra::quatquat(frameQ_,qMatC,qRel);
+    MathExtra::quat_to_mat(qRel,frameRelR_);
+    MathExtra::matvec(frameRelR_,frameMatT_,tmp);
+    vectorSubtract3D(frameT_,tmp,frameRelT_);
+  }
+
+  template<int NUM_NODES>
+  void MultiNodeMesh<NUM_NODES>::frameTranslate(const double *vec)
+  {
+    vectorAdd3D(frameT_,vec,frameT_);
+    updateFrameRel();
+  }
+
+  template<int NUM_NODES>
+  void MultiNodeMesh<NUM_NODES>::frameRotate(const double *q, const double *origin)
+  {
+    //NP rotation about origin: R' = R_q R, t' = R_q (t - origin) + origin
+    double qNew[4],d[3];
+    MathExtra::quatquat(q,frameQ_,qNew);
+    MathExtra::qnormalize(qNew);
+    vectorCopy4D(qNew,frameQ_);
+
+    vectorSubtract3D(frameT_,origin,d);
+    MathExtraLiggghts::vec_quat_rotate(d,q);
+    vectorAdd3D(d,origin,frameT_);
+    updateFrameRel();
+  }
+
 #endif
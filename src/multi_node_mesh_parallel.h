@@ -126,6 +126,10 @@ namespace LAMMPS_NS
         void borders();
         void clearGhosts();
 
+        // update of existing ghosts if ghost lists did not change
+        bool bordersUnchanged();
+        void bordersUpdate();
+
         bool checkBorderElementLeft(int,int,double,double);
         bool checkBorderElementRight(int,int,double,double);
 
@@ -196,6 +200,12 @@ namespace LAMMPS_NS
 
         int *pbc_flag_;              // general flag for sending atoms thru PBC
         int **pbc_;                  // dimension flags for PBC adjustments
+
+        // state of last setup() and borders()
+        //NP used to decide if ghost lists can be re-used
+        bool bordersValid_;          // true if swaps match current elements
+        double sublo_last_[3],subhi_last_[3];
+        double cutneighmax_last_,skin_last_;
   };
 
   // *************************************
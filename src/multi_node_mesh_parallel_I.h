@@ -59,7 +59,10 @@
     sendlist_(0),
     maxsendlist_(0),
     pbc_flag_(0),
-    pbc_(0)
+    pbc_(0),
+    bordersValid_(false),
+    cutneighmax_last_(0.),
+    skin_last_(0.)
   {
       // initialize comm buffers & exchange memory
       //NP as in Comm constructor
@@ -111,6 +114,7 @@
 
     if(MultiNodeMesh<NUM_NODES>::addElement(nodeToAdd))
     {
+        bordersValid_ = false;
         nLocal_++;
         return true;
     }
@@ -127,6 +131,7 @@
         this->error->one(FLERR,"Illegal call to MultiNodeMeshParallel<NUM_NODES>::deleteElement");
 
     MultiNodeMesh<NUM_NODES>::deleteElement(n);
+    bordersValid_ = false;
 
     if(n >= nLocal_)
         nGhost_--;
@@ -283,6 +288,12 @@
        vectorCopy3D(this->domain->sublo,sublo);
        vectorCopy3D(this->domain->subhi,subhi);
 
+       // store what the swaps depend on
+       vectorCopy3D(sublo,sublo_last_);
+       vectorCopy3D(subhi,subhi_last_);
+       cutneighmax_last_ = this->neighbor->cutneighmax;
+       skin_last_ = this->neighbor->skin;
+
        this->memory->create(sublo_all,nprocs,3,"MultiNodeMeshParallel::setup() sublo_all");
        this->memory->create(subhi_all,nprocs,3,"MultiNodeMeshParallel::setup() subhi_all");
 
@@ -659,6 +670,19 @@
       //NP so need to refresh everything once
       if(!setupFlag && !this->isMoving() && !this->isDeforming() && !this->domain->box_change) return;
 
+      // moving mesh: if no element changes owner or ghost status, the
+      // swaps of the last borders() are still valid
+      //NP nodes of owned and ghost elements are moved by every proc itself,
+      //NP so only properties that owners change have to be sent
+      if(!setupFlag && bordersUnchanged())
+      {
+          refreshOwned(setupFlag);
+          bordersUpdate();
+          refreshGhosts(setupFlag);
+          postBorders();
+          return;
+      }
+
       // set-up mesh parallelism
       setup();
 
@@ -1019,12 +1043,160 @@
           if (max > maxsend_) grow_send(max,0);
           max = MAX(maxforward_*rmax,maxreverse_*smax);
           if (max > maxrecv_) grow_recv(max);
+
+          bordersValid_ = true;
       }
 
       // build global-local map
       this->generateMap();
   }
 
+  /* ----------------------------------------------------------------------
+   check if swaps of last borders() can be re-used
+   true if sub-domains, cutoff and comm sizes are unchanged, all owned
+   elements stay on their proc and each swap would send the same elements
+   same decision on all procs
+  ------------------------------------------------------------------------- */
+
+  template<int NUM_NODES>
+  bool MultiNodeMeshParallel<NUM_NODES>::bordersUnchanged()
+  {
+      if(!doParallellization_ || this->isScaling() || this->isDeforming())
+        return false;
+
+      bool scale = this->isScaling();
+      bool translate = this->isTranslating();
+      bool rotate = this->isRotating();
+
+      int changed = bordersValid_ ? 0 : 1;
+
+      // sub-domains and ghost cutoff as in setup()
+      //NP rBound of elements cannot change if not scaling or deforming
+
+      for(int dim = 0; !changed && dim < 3; dim++)
+          if(this->domain->sublo[dim] != sublo_last_[dim] || this->domain->subhi[dim] != subhi_last_[dim])
+            changed = 1;
+
+      if(this->neighbor->cutneighmax != cutneighmax_last_ || this->neighbor->skin != skin_last_)
+        changed = 1;
+
+      // properties might have been added since setup()
+
+      if(!changed &&
+         (elemBufSize(OPERATION_COMM_EXCHANGE,scale,translate,rotate) + 1 != size_exchange_ ||
+          elemBufSize(OPERATION_COMM_BORDERS,scale,translate,rotate) != size_border_ ||
+          elemBufSize(OPERATION_COMM_FORWARD,scale,translate,rotate) != size_forward_ ||
+          elemBufSize(OPERATION_COMM_REVERSE,scale,translate,rotate) != size_reverse_))
+        changed = 1;
+
+      // owned elements that pbc() or exchange() would move
+      //NP stricter than pushExchange(), so no element is missed
+
+      for(int i = 0; !changed && i < nLocal_; i++)
+          for(int dim = 0; dim < 3; dim++)
+              if(this->center_(i)[dim] < sublo_last_[dim] || this->center_(i)[dim] >= subhi_last_[dim])
+                changed = 1;
+
+      // elements borders() would send, in the same order as in borders()
+      //NP ghosts of swap iswap arrive in the same order if no proc changed
+
+      int iswap = 0, nfirst = 0, nlast = 0, nall = nLocal_;
+      for(int dim = 0; !changed && dim < 3; dim++)
+      {
+          nlast = 0;
+          for(int ineed = 0; !changed && ineed < 2*maxneed_[dim]; ineed++)
+          {
+              if (ineed % 2 == 0)
+              {
+                  nfirst = nlast;
+                  nlast = nall;
+              }
+
+              bool sendflag = true;
+              if(ineed % 2 == 0 && this->comm->myloc[dim] == 0)
+                sendflag = false;
+              if(ineed % 2 == 1 && this->comm->myloc[dim] == this->comm->procgrid[dim]-1)
+                sendflag = false;
+
+              int nsend = 0;
+              if(sendflag)
+              {
+                  for (int i = nfirst; !changed && i < nlast; i++)
+                  {
+                      if( ((ineed % 2 == 0) && checkBorderElementLeft(i,dim,slablo_[iswap],slabhi_[iswap]))  ||
+                          ((ineed % 2 != 0) && checkBorderElementRight(i,dim,slablo_[iswap],slabhi_[iswap]))  )
+                      {
+                          if(nsend >= sendnum_[iswap] || sendlist_[iswap][nsend] != i)
+                            changed = 1;
+                          nsend++;
+                      }
+                  }
+              }
+
+              if(nsend != sendnum_[iswap])
+                changed = 1;
+
+              nall += recvnum_[iswap];
+              iswap++;
+          }
+      }
+
+      if(!changed && nall != nLocal_+nGhost_)
+        changed = 1;
+
+      MPI_Max_Scalar(changed,this->world);
+      return changed == 0;
+  }
+
+  /* ----------------------------------------------------------------------
+   send properties of owned elements to existing ghosts along the
+   swaps of the last borders()
+  ------------------------------------------------------------------------- */
+
+  template<int NUM_NODES>
+  void MultiNodeMeshParallel<NUM_NODES>::bordersUpdate()
+  {
+      int n,size_update;
+      bool dummy = false;
+      MPI_Request request;
+      MPI_Status status;
+      int me = this->comm->me;
+
+      //NP same for all procs since same properties
+      size_update = elemBufSize(OPERATION_COMM_BORDERS_UPDATE,dummy,dummy,dummy);
+      if(size_update == 0)
+        return;
+
+      for (int iswap = 0; iswap < nswap_; iswap++)
+      {
+          if(sendnum_[iswap]*size_update > maxsend_)
+            grow_send(sendnum_[iswap]*size_update,0);
+          if(recvnum_[iswap]*size_update > maxrecv_)
+            grow_recv(recvnum_[iswap]*size_update);
+
+          if (sendproc_[iswap] != me)
+          {
+                if (recvnum_[iswap])
+                    MPI_Irecv(buf_recv_,recvnum_[iswap]*size_update,MPI_DOUBLE,recvproc_[iswap],0,this->world,&request);
+
+                n = pushElemListToBuffer(sendnum_[iswap],sendlist_[iswap],buf_send_,OPERATION_COMM_BORDERS_UPDATE,dummy,dummy,dummy);
+
+                if (n)
+                    MPI_Send(buf_send_,n,MPI_DOUBLE,sendproc_[iswap],0,this->world);
+
+                if (recvnum_[iswap])
+                    MPI_Wait(&request,&status);
+
+                n = popElemListFromBuffer(firstrecv_[iswap],recvnum_[iswap],buf_recv_,OPERATION_COMM_BORDERS_UPDATE,dummy,dummy,dummy);
+          }
+          else
+          {
+              n = pushElemListToBuffer(sendnum_[iswap],sendlist_[iswap],buf_send_,OPERATION_COMM_BORDERS_UPDATE,dummy,dummy,dummy);
+              n = popElemListFromBuffer(firstrecv_[iswap],recvnum_[iswap],buf_send_,OPERATION_COMM_BORDERS_UPDATE,dummy,dummy,dummy);
+          }
+      }
+  }
+
   /* ----------------------------------------------------------------------
    check if element qualifies as ghost
   ------------------------------------------------------------------------- */
@@ -311,6 +311,11 @@
           return nsend;
       }
 
+      //NP nodes, center and bounding radius of ghosts are updated by the
+      //NP procs themselves, so nothing to do for a ghost update
+      if(OPERATION_COMM_BORDERS_UPDATE == operation)
+          return nsend;
+
       if(OPERATION_COMM_FORWARD == operation)
       {
           /*NL*///if (this->screen) fprintf(this->screen,"comm forward, translate is %s\n",translate?"yes":"no");
@@ -350,6 +355,9 @@
           return nrecv;
       }
 
+      if(OPERATION_COMM_BORDERS_UPDATE == operation)
+          return nrecv;
+
       if(OPERATION_COMM_FORWARD == operation)
       {
           //NP node_orig cannot change during a run
@@ -440,6 +448,9 @@
 
       //NP OPERATION_COMM_FORWARD, OPERATION_COMM_REVSERSE are list operations, not per-element operations
       //NP need to implement this here since elemListBufSize() refers to here
+      if(OPERATION_COMM_BORDERS_UPDATE == operation)
+          return size_buf;
+
       if(OPERATION_COMM_FORWARD == operation)
       {
           //NP node_orig cannot change during a run
@@ -34,12 +34,38 @@
 #include "update.h"
 #include "fix_contact_history.h" //NP modified C.K.
 #include "error.h"
+#ifdef SUPERQUADRIC_ACTIVE_FLAG
+#include "math_extra_liggghts_superquadric.h"
+#endif
 
 using namespace LAMMPS_NS;
 
 //NP modified C.K. changed shearpartner to contacthistory throughout file
 //NP modified C.K. added contactHistoryDistanceFactor
 
+/* ----------------------------------------------------------------------
+   broad phase for superquadrics
+   true if the oriented bounding boxes of i and j, each inflated by half
+   the skin, overlap. check_distance() triggers a build before either
+   box can have moved or rotated out of its inflated version
+------------------------------------------------------------------------- */
+
+bool Neighbor::obb_neighbor(int i, int j)
+{
+#ifdef SUPERQUADRIC_ACTIVE_FLAG
+  double **shape = atom->shape;
+  double halfskin = 0.5*skin;
+  double shapei[3] = {shape[i][0]+halfskin, shape[i][1]+halfskin, shape[i][2]+halfskin};
+  double shapej[3] = {shape[j][0]+halfskin, shape[j][1]+halfskin, shape[j][2]+halfskin};
+
+  Superquadric particle_i(atom->x[i], atom->quaternion[i], shapei, atom->blockiness[i]);
+  Superquadric particle_j(atom->x[j], atom->quaternion[j], shapej, atom->blockiness[j]);
+  return MathExtraLiggghtsNonspherical::obb_intersect(&particle_i, &particle_j);
+#else
+  return true;
+#endif
+}
+
 /* ----------------------------------------------------------------------
    granular particles
    N^2 / 2 search for neighbor pairs with partial Newton's 3rd law
@@ -53,6 +79,7 @@ void Neighbor::granular_nsq_no_newton(NeighList *list)
   int i,j,m,n,nn=0,bitmask=0,d; //NP modified C.K.
   double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
   double radi,radsum,cutsq;
+  int ibody,ibody_bit;
   int *neighptr,*touchptr = NULL;
   double *shearptr = NULL;
 
@@ -116,12 +143,14 @@ void Neighbor::granular_nsq_no_newton(NeighList *list)
     ytmp = x[i][1];
     ztmp = x[i][2];
     radi = radius[i];
+    ibody_bit = ex_body ? (mask[i] & ex_body_bit) : 0;
+    ibody = ibody_bit ? molecule[i] : -1;
 
     // loop over remaining atoms, owned and ghost
 
     for (j = i+1; j < nall; j++) {
       if (includegroup && !(mask[j] & bitmask)) continue;
-      if (exclude && exclusion(i,j,type[i],type[j],mask,molecule)) continue;
+      if (exclusion_gran(i,j,ibody_bit,ibody,type,mask,molecule)) continue;
 
       delx = xtmp - x[j][0];
       dely = ytmp - x[j][1];
@@ -130,7 +159,7 @@ void Neighbor::granular_nsq_no_newton(NeighList *list)
       radsum = (radi + radius[j]) * contactDistanceFactor; //NP modified C.K.
       cutsq = (radsum+skin) * (radsum+skin);
 
-      if (rsq <= cutsq) {
+      if (rsq <= cutsq && (!obb_check || obb_neighbor(i,j))) {
         neighptr[n] = j;
 
         if (fix_history) {
@@ -192,6 +221,7 @@ void Neighbor::granular_nsq_newton(NeighList *list)
   int i,j,n,itag,jtag,bitmask=0;
   double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
   double radi,radsum,cutsq;
+  int ibody,ibody_bit;
   int *neighptr;
 
   double **x = atom->x;
@@ -225,6 +255,8 @@ void Neighbor::granular_nsq_newton(NeighList *list)
     ytmp = x[i][1];
     ztmp = x[i][2];
     radi = radius[i];
+    ibody_bit = ex_body ? (mask[i] & ex_body_bit) : 0;
+    ibody = ibody_bit ? molecule[i] : -1;
 
     // loop over remaining atoms, owned and ghost
 
@@ -246,7 +278,7 @@ void Neighbor::granular_nsq_newton(NeighList *list)
         }
       }
 
-      if (exclude && exclusion(i,j,type[i],type[j],mask,molecule)) continue;
+      if (exclusion_gran(i,j,ibody_bit,ibody,type,mask,molecule)) continue;
 
       delx = xtmp - x[j][0];
       dely = ytmp - x[j][1];
@@ -255,7 +287,7 @@ void Neighbor::granular_nsq_newton(NeighList *list)
       radsum = (radi + radius[j]) * contactDistanceFactor;
       cutsq = (radsum+skin) * (radsum+skin);
 
-      if (rsq <= cutsq) neighptr[n++] = j;
+      if (rsq <= cutsq && (!obb_check || obb_neighbor(i,j))) neighptr[n++] = j;
     }
 
     ilist[inum++] = i;
@@ -287,6 +319,7 @@ void Neighbor::granular_bin_no_newton_ghost(NeighList *list)
   double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
   int xbin,ybin,zbin,xbin2,ybin2,zbin2;
   double radi,radsum,cutsq;
+  int ibody,ibody_bit;
   int *neighptr,*touchptr = NULL;
   double *shearptr = NULL;
 
@@ -355,6 +388,8 @@ void Neighbor::granular_bin_no_newton_ghost(NeighList *list)
     ytmp = x[i][1];
     ztmp = x[i][2];
     radi = radius[i];
+    ibody_bit = ex_body ? (mask[i] & ex_body_bit) : 0;
+    ibody = ibody_bit ? molecule[i] : -1;
 
 
     /*NL*/ //if (screen) fprintf(screen,"looping atom tag %d, x %f %f %f\n",atom->tag[i],x[i][0],x[i][1],x[i][2]);
@@ -371,7 +406,7 @@ void Neighbor::granular_bin_no_newton_ghost(NeighList *list)
       for (k = 0; k < nstencil; k++) {
         for (j = binhead[ibin+stencil[k]]; j >= 0; j = bins[j]) {
           if (j <= i) continue;
-          if (exclude && exclusion(i,j,type[i],type[j],mask,molecule)) continue;
+          if (exclusion_gran(i,j,ibody_bit,ibody,type,mask,molecule)) continue;
 
           delx = xtmp - x[j][0];
           dely = ytmp - x[j][1];
@@ -381,7 +416,7 @@ void Neighbor::granular_bin_no_newton_ghost(NeighList *list)
           cutsq = (radsum+skin) * (radsum+skin);
           /*NL*/ //if (screen) fprintf(screen,"checking local indices %d %d\n",i,j);
 
-          if (rsq <= cutsq) {
+          if (rsq <= cutsq && (!obb_check || obb_neighbor(i,j))) {
             neighptr[n] = j;
             /*NL*/ //if (screen) fprintf(screen,"  found local indices %d %d\n",i,j);
             /*NL*/ //if (screen) printVec3D(screen,"  xi",x[i]);
@@ -426,7 +461,7 @@ void Neighbor::granular_bin_no_newton_ghost(NeighList *list)
         for (j = binhead[ibin+stencil[k]]; j >= 0; j = bins[j]) {
           if (j <= i) continue;
 
-          if (exclude && exclusion(i,j,type[i],type[j],mask,molecule)) continue;
+          if (exclusion_gran(i,j,ibody_bit,ibody,type,mask,molecule)) continue;
 
           delx = xtmp - x[j][0];
           dely = ytmp - x[j][1];
@@ -435,7 +470,7 @@ void Neighbor::granular_bin_no_newton_ghost(NeighList *list)
           radsum = (radi + radius[j]) * contactDistanceFactor; //NP modified C.K.
           cutsq = (radsum+skin) * (radsum+skin);
 
-          if (rsq <= cutsq) neighptr[n++] = j;
+          if (rsq <= cutsq && (!obb_check || obb_neighbor(i,j))) neighptr[n++] = j;
         }
       }
     }
@@ -474,6 +509,7 @@ void Neighbor::granular_bin_no_newton(NeighList *list)
   int i,j,k,m,n,nn=0,ibin,d;
   double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
   double radi,radsum,cutsq;
+  int ibody,ibody_bit;
   int *neighptr,*touchptr = NULL;
   double *shearptr = NULL;
 
@@ -541,6 +577,8 @@ void Neighbor::granular_bin_no_newton(NeighList *list)
     ytmp = x[i][1];
     ztmp = x[i][2];
     radi = radius[i];
+    ibody_bit = ex_body ? (mask[i] & ex_body_bit) : 0;
+    ibody = ibody_bit ? molecule[i] : -1;
     ibin = coord2bin(x[i]);
 
     /*NL*/ //if (screen) fprintf(screen,"step " BIGINT_FORMAT " looping atom tag %d, x %f %f %f\n",update->ntimestep,atom->tag[i],x[i][0],x[i][1],x[i][2]);
@@ -553,7 +591,7 @@ void Neighbor::granular_bin_no_newton(NeighList *list)
     for (k = 0; k < nstencil; k++) {
       for (j = binhead[ibin+stencil[k]]; j >= 0; j = bins[j]) {
         if (j <= i) continue;
-        if (exclude && exclusion(i,j,type[i],type[j],mask,molecule)) continue;
+        if (exclusion_gran(i,j,ibody_bit,ibody,type,mask,molecule)) continue;
 
         delx = xtmp - x[j][0];
         dely = ytmp - x[j][1];
@@ -563,7 +601,7 @@ void Neighbor::granular_bin_no_newton(NeighList *list)
         cutsq = (radsum+skin) * (radsum+skin);
         /*NL*/ //if (screen) fprintf(screen,"checking local indices %d %d\n",i,j);
 
-        if (rsq <= cutsq) {
+        if (rsq <= cutsq && (!obb_check || obb_neighbor(i,j))) {
           neighptr[n] = j;
           /*NL*/ //if (screen) fprintf(screen,"  found local indices %d %d\n",i,j);
           /*NL*/ //if (screen) printVec3D(screen,"  xi",x[i]);
@@ -627,6 +665,7 @@ void Neighbor::granular_bin_newton(NeighList *list)
   int i,j,k,n,ibin;
   double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
   double radi,radsum,cutsq;
+  int ibody,ibody_bit;
   int *neighptr;
 
   // bin local & ghost atoms
@@ -662,6 +701,8 @@ void Neighbor::granular_bin_newton(NeighList *list)
     ytmp = x[i][1];
     ztmp = x[i][2];
     radi = radius[i];
+    ibody_bit = ex_body ? (mask[i] & ex_body_bit) : 0;
+    ibody = ibody_bit ? molecule[i] : -1;
 
     // loop over rest of atoms in i's bin, ghosts are at end of linked list
     // if j is owned atom, store it, since j is beyond i in linked list
@@ -676,7 +717,7 @@ void Neighbor::granular_bin_newton(NeighList *list)
         }
       }
 
-      if (exclude && exclusion(i,j,type[i],type[j],mask,molecule)) continue;
+      if (exclusion_gran(i,j,ibody_bit,ibody,type,mask,molecule)) continue;
 
       delx = xtmp - x[j][0];
       dely = ytmp - x[j][1];
@@ -685,7 +726,7 @@ void Neighbor::granular_bin_newton(NeighList *list)
       radsum = (radi + radius[j]) * contactDistanceFactor; //NP modified C.K.
       cutsq = (radsum+skin) * (radsum+skin);
 
-      if (rsq <= cutsq) neighptr[n++] = j;
+      if (rsq <= cutsq && (!obb_check || obb_neighbor(i,j))) neighptr[n++] = j;
     }
 
     // loop over all atoms in other bins in stencil, store every pair
@@ -693,7 +734,7 @@ void Neighbor::granular_bin_newton(NeighList *list)
     ibin = coord2bin(x[i]);
     for (k = 0; k < nstencil; k++) {
       for (j = binhead[ibin+stencil[k]]; j >= 0; j = bins[j]) {
-        if (exclude && exclusion(i,j,type[i],type[j],mask,molecule)) continue;
+        if (exclusion_gran(i,j,ibody_bit,ibody,type,mask,molecule)) continue;
 
         delx = xtmp - x[j][0];
         dely = ytmp - x[j][1];
@@ -702,7 +743,7 @@ void Neighbor::granular_bin_newton(NeighList *list)
         radsum = radi + radius[j];
         cutsq = (radsum+skin) * (radsum+skin);
 
-        if (rsq <= cutsq) neighptr[n++] = j;
+        if (rsq <= cutsq && (!obb_check || obb_neighbor(i,j))) neighptr[n++] = j;
       }
     }
 
@@ -730,6 +771,7 @@ void Neighbor::granular_bin_newton_tri(NeighList *list)
   int i,j,k,n,ibin;
   double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
   double radi,radsum,cutsq;
+  int ibody,ibody_bit;
   int *neighptr;
 
   // bin local & ghost atoms
@@ -765,6 +807,8 @@ void Neighbor::granular_bin_newton_tri(NeighList *list)
     ytmp = x[i][1];
     ztmp = x[i][2];
     radi = radius[i];
+    ibody_bit = ex_body ? (mask[i] & ex_body_bit) : 0;
+    ibody = ibody_bit ? molecule[i] : -1;
 
     // loop over all atoms in bins in stencil
     // pairs for atoms j "below" i are excluded
@@ -784,7 +828,7 @@ void Neighbor::granular_bin_newton_tri(NeighList *list)
           }
         }
 
-        if (exclude && exclusion(i,j,type[i],type[j],mask,molecule)) continue;
+        if (exclusion_gran(i,j,ibody_bit,ibody,type,mask,molecule)) continue;
 
         delx = xtmp - x[j][0];
         dely = ytmp - x[j][1];
@@ -793,7 +837,7 @@ void Neighbor::granular_bin_newton_tri(NeighList *list)
         radsum = (radi + radius[j]) * contactDistanceFactor; //NP modified C.K.
         cutsq = (radsum+skin) * (radsum+skin);
 
-        if (rsq <= cutsq) neighptr[n++] = j;
+        if (rsq <= cutsq && (!obb_check || obb_neighbor(i,j))) neighptr[n++] = j;
       }
     }
 
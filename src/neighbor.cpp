@@ -110,6 +110,7 @@ Neighbor::Neighbor(LAMMPS *lmp) : Pointers(lmp)
   maxhold = 0;
   xhold = NULL;
   rhold = NULL; //NP modified C.K.
+  qhold = NULL;
 
   // binning
 
@@ -136,6 +137,10 @@ Neighbor::Neighbor(LAMMPS *lmp) : Pointers(lmp)
   nex_mol = maxex_mol = 0;
   ex_mol_group = ex_mol_bit = NULL;
 
+  ex_body = ex_body_bit = 0;
+
+  obb_check = 0;
+
   no_build = 0;
 
   // pair lists
@@ -187,6 +192,7 @@ Neighbor::~Neighbor()
 
   memory->destroy(xhold);
   memory->destroy(rhold); //NP modified C.K.
+  memory->destroy(qhold);
 
   memory->destroy(binhead);
   memory->destroy(bins);
@@ -393,9 +399,11 @@ void Neighbor::init()
   if (dist_check == 0) {
     memory->destroy(xhold);
     memory->destroy(rhold); //NP modified C.K.
+    memory->destroy(qhold);
     maxhold = 0;
     xhold = NULL;
     rhold = NULL; //NP modified C.K.
+    qhold = NULL;
   }
 
   if (style == NSQ) {
@@ -413,6 +421,7 @@ void Neighbor::init()
       maxhold = atom->nmax;
       memory->create(xhold,maxhold,3,"neigh:xhold");
       memory->create(rhold,maxhold,"neigh:rhold"); //NP modified C.K.
+      if (obb_check) memory->create(qhold,maxhold,4,"neigh:qhold");
     }
   }
 
@@ -468,6 +477,17 @@ void Neighbor::init()
       ex_mol_bit[i] = group->bitmask[ex_mol_group[i]];
   }
 
+  // a single molecule exclusion, as set by fix multisphere, is tested
+  // inline in the granular builds by comparing body IDs
+
+  ex_body = (nex_type == 0 && nex_group == 0 && nex_mol == 1);
+  ex_body_bit = ex_body ? ex_mol_bit[0] : 0;
+
+  if (obb_check && !atom->superquadric_flag)
+    error->all(FLERR,"Neigh_modify obb requires atom_style superquadric");
+  if (obb_check && dist_check && maxhold > 0 && !qhold)
+    memory->create(qhold,maxhold,4,"neigh:qhold");
+
   if (exclude && force->kspace && me == 0)
     error->warning(FLERR,"Neighbor exclusions used with KSpace solver "
                    "may give inconsistent Coulombic energies");
@@ -1449,6 +1469,23 @@ int Neighbor::check_distance()
       /*NL*///if (screen) fprintf(screen,"checking at step %d, result %d\n",update->ntimestep,flag);
   }
 
+  // with OBB filtering, rotation of elongated particles has to trigger
+  // a build as well: a surface point moves at most r*dtheta by rotation
+
+  if (obb_check && !flag) {
+    double **quat = atom->quaternion;
+    for (int i = 0; i < nlocal; i++) {
+      delx = x[i][0] - xhold[i][0];
+      dely = x[i][1] - xhold[i][1];
+      delz = x[i][2] - xhold[i][2];
+      const double qdot = fabs(quat[i][0]*qhold[i][0] + quat[i][1]*qhold[i][1] +
+                               quat[i][2]*qhold[i][2] + quat[i][3]*qhold[i][3]);
+      const double dtheta = 2.*acos(MIN(qdot,1.));
+      delr = sqrt(delx*delx + dely*dely + delz*delz) + radius[i]*dtheta;
+      if (delr > delta) flag = 1;
+    }
+  }
+
   int flagall;
   MPI_Allreduce(&flag,&flagall,1,MPI_INT,MPI_MAX,world);
   if (flagall && ago == MAX(every,delay)) ndanger++;
@@ -1484,6 +1521,10 @@ void Neighbor::build(int topoflag)
       memory->create(xhold,maxhold,3,"neigh:xhold");
       memory->destroy(rhold); //NP modified C.K.
       memory->create(rhold,maxhold,"neigh:rhold");  //NP modified C.K.
+      if (obb_check) {
+        memory->destroy(qhold);
+        memory->create(qhold,maxhold,4,"neigh:qhold");
+      }
     }
 
     //NP modified C.K.
@@ -1504,6 +1545,15 @@ void Neighbor::build(int topoflag)
           rhold[i] = radius[i];
         }
     }
+    if (obb_check) {
+        double **quat = atom->quaternion;
+        for (i = 0; i < nlocal; i++) {
+          qhold[i][0] = quat[i][0];
+          qhold[i][1] = quat[i][1];
+          qhold[i][2] = quat[i][2];
+          qhold[i][3] = quat[i][3];
+        }
+    }
     if (boxcheck) {
       if (triclinic == 0) {
         boxlo_hold[0] = bboxlo[0];
@@ -1990,6 +2040,16 @@ void Neighbor::modify_params(int narg, char **arg)
 
       } else error->all(FLERR,"Illegal neigh_modify command");
 
+    } else if (strcmp(arg[iarg],"obb") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal neigh_modify command");
+      if (strcmp(arg[iarg+1],"yes") == 0) obb_check = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) obb_check = 0;
+      else error->all(FLERR,"Illegal neigh_modify command");
+#ifndef SUPERQUADRIC_ACTIVE_FLAG
+      if (obb_check)
+        error->all(FLERR,"Neigh_modify obb requires compilation with superquadric support");
+#endif
+      iarg += 2;
     } else if (strcmp(arg[iarg],"no_build") == 0) {
         if (iarg+2 > narg) error->all(FLERR,"Illegal neigh_modify command");
         if (strcmp(arg[iarg+1],"yes") == 0) no_build = 1;
@@ -139,6 +139,7 @@ class Neighbor : protected Pointers {
   double **xhold;                      // atom coords at last neighbor build
   //NP modified C.K.
   double *rhold;                       // atom radii at last neighbor build
+  double **qhold;                      // quaternions at last neighbor build
   int maxhold;                         // size of xhold array
   int boxcheck;                        // 1 if need to store box size
   double boxlo_hold[3],boxhi_hold[3];  // box size at last neighbor build
@@ -198,6 +199,13 @@ class Neighbor : protected Pointers {
   int *ex_mol_group;               // molecule group #'s to exclude
   int *ex_mol_bit;                 // molecule group bits to exclude
 
+  int ex_body;                     // 1 if only molecules (multisphere bodies)
+                                   // of a single group are excluded
+  int ex_body_bit;                 // group bit of this body exclusion
+
+  int obb_check;                   // 1 if superquadric pairs are filtered
+                                   // by overlap of their skin-inflated OBBs
+
   int no_build;                    // no neigh lists are built, but exchange
                                    // of particles takes place
 
@@ -255,6 +263,8 @@ class Neighbor : protected Pointers {
   void skip_from_respa(class NeighList *);
   void copy_from(class NeighList *);
 
+  bool obb_neighbor(int, int);
+
   void granular_nsq_no_newton(class NeighList *);
   void granular_nsq_newton(class NeighList *);
   void granular_bin_no_newton(class NeighList *);
@@ -363,6 +373,17 @@ class Neighbor : protected Pointers {
     return 0;
   };
 
+  // exclusion_gran: test for pair exclusion in the granular builders
+  // a body exclusion replaces the other exclusions, ibody_bit and ibody
+  //   are those of atom i, 0 and -1 if it is not in the excluded group
+
+  inline int exclusion_gran(int i, int j, int ibody_bit, int ibody,
+                            int *type, int *mask, int *molecule) const {
+    if (ex_body)
+      return ibody_bit && (mask[j] & ibody_bit) && molecule[j] == ibody;
+    return exclude && exclusion(i,j,type[i],type[j],mask,molecule);
+  }
+
   //NP modified C.K.
   void register_contact_dist_factor(double cdf)
   { contactDistanceFactor = std::max(contactDistanceFactor,cdf); }
@@ -32,6 +32,7 @@
 #include "write_restart.h"
 #include "accelerator_cuda.h"
 #include "memory.h"
+#include "timer.h"
 #include "error.h"
 
 using namespace LAMMPS_NS;
@@ -191,7 +192,11 @@ void Output::setup(int memflag)
       if (last_dump[idump] < 0 && dump[idump]->first_flag == 1) writeflag = 1;
 
       if (writeflag) {
+        if (modify->timing) dump[idump]->begin_time_recording();
+        timer->trace_begin(dump[idump]->id);
         dump[idump]->write();
+        timer->trace_end(dump[idump]->id);
+        if (modify->timing) dump[idump]->end_time_recording();
         last_dump[idump] = ntimestep;
       }
       if (every_dump[idump])
@@ -300,7 +305,11 @@ void Output::write(bigint ntimestep)
         if (dump[idump]->clearstep || every_dump[idump] == 0)
           modify->clearstep_compute();
         if (last_dump[idump] != ntimestep) {
+          if (modify->timing) dump[idump]->begin_time_recording();
+          timer->trace_begin(dump[idump]->id);
           dump[idump]->write();
+          timer->trace_end(dump[idump]->id);
+          if (modify->timing) dump[idump]->end_time_recording();
           last_dump[idump] = ntimestep;
         }
         if (every_dump[idump]) next_dump[idump] += every_dump[idump];
@@ -403,7 +412,11 @@ void Output::write(bigint ntimestep)
 void Output::write_dump(bigint ntimestep)
 {
   for (int idump = 0; idump < ndump; idump++) {
+    if (modify->timing) dump[idump]->begin_time_recording();
+    timer->trace_begin(dump[idump]->id);
     dump[idump]->write();
+    timer->trace_end(dump[idump]->id);
+    if (modify->timing) dump[idump]->end_time_recording();
     last_dump[idump] = ntimestep;
   }
 }
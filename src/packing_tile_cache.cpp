@@ -0,0 +1,289 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#include "packing_tile_cache.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "comm.h"
+#include "error.h"
+#include "random_park.h"
+#include "math_const.h"
+
+using namespace LAMMPS_NS;
+using namespace LIGGGHTS;
+
+// random sequential addition jams at a volume fraction of about 0.38
+const double PackingTileCache::max_fill_fraction = 0.35;
+
+static const char TILE_MAGIC[8] = {'L','G','T','I','L','E','0','1'};
+static const int NCELL = 10;        // # of cells per tile edge, cell size = slot diameter
+static const int MAX_ATTEMPT = 1000; // attempts per slot in tile generation
+
+/**
+ * @brief Default constructor which will create an empty cache
+ */
+PackingTileCache::PackingTileCache(LAMMPS *lmp) : Pointers(lmp),
+  radius(0.),
+  fill_fraction(0.),
+  length(0.)
+{
+  for(int i = 0; i < 3; i++) {
+    perm[i] = i;
+    mirror[i] = false;
+    shift[i] = 0.;
+  }
+}
+
+/**
+ * @brief Load the tile for the given recipe from file or generate and store it
+ *
+ * Only process 0 accesses the file, the tile is broadcast to all processes.
+ *
+ * @param filename       binary tile library
+ * @param radius_        slot radius, i.e. largest bounding radius to be inserted
+ * @param fill_fraction_ slot volume fraction
+ * @param seed           random seed used if the tile has to be generated
+ */
+void PackingTileCache::setup(const char *filename, double radius_, double fill_fraction_, int seed)
+{
+  if(radius_ <= 0.)
+    error->all(FLERR,"Packing tile cache: slot radius must be > 0");
+  if(fill_fraction_ <= 0. || fill_fraction_ > max_fill_fraction) {
+    char errmsg[200];
+    sprintf(errmsg,"Packing tile cache: fill fraction must be > 0 and <= %f",max_fill_fraction);
+    error->all(FLERR,errmsg);
+  }
+
+  radius = radius_;
+  fill_fraction = fill_fraction_;
+  slots.clear();
+
+  if(comm->me == 0) {
+    if(!read(filename)) {
+      generate(seed);
+      write(filename);
+    } else if(screen) {
+      fprintf(screen,"Packing tile cache: loaded tile with %d slots from %s\n",nSlots(),filename);
+    }
+  }
+
+  int nslots = nSlots();
+  MPI_Bcast(&nslots,1,MPI_INT,0,world);
+  MPI_Bcast(&length,1,MPI_DOUBLE,0,world);
+  slots.resize(3*nslots);
+  if(nslots > 0)
+    MPI_Bcast(&slots[0],3*nslots,MPI_DOUBLE,0,world);
+
+  if(nslots == 0)
+    error->all(FLERR,"Packing tile cache: tile does not contain any slots");
+}
+
+/**
+ * @brief Search the tile library for the current recipe
+ * @return true if a matching tile was found
+ */
+bool PackingTileCache::read(const char *filename)
+{
+  FILE *fp = fopen(filename,"rb");
+  if(!fp) return false;
+
+  char magic[8];
+  if(fread(magic,sizeof(char),8,fp) != 8 || memcmp(magic,TILE_MAGIC,8)) {
+    fclose(fp);
+    error->one(FLERR,"Packing tile cache: file is not a valid tile library");
+  }
+
+  bool found = false;
+  double header[3];
+  int nslots;
+
+  while(!found && fread(header,sizeof(double),3,fp) == 3 && fread(&nslots,sizeof(int),1,fp) == 1) {
+    if(fabs(header[0]-radius) <= 1e-10*radius && fabs(header[1]-fill_fraction) <= 1e-10) {
+      length = header[2];
+      slots.resize(3*nslots);
+      if(nslots > 0 && fread(&slots[0],sizeof(double),3*nslots,fp) != static_cast<size_t>(3*nslots))
+        error->one(FLERR,"Packing tile cache: unexpected end of file");
+      found = true;
+    } else if(fseek(fp,3*nslots*sizeof(double),SEEK_CUR)) {
+      break;
+    }
+  }
+
+  fclose(fp);
+  return found;
+}
+
+/**
+ * @brief Append the current tile to the tile library
+ */
+void PackingTileCache::write(const char *filename) const
+{
+  FILE *fp = fopen(filename,"rb");
+  bool const is_new = (fp == NULL);
+  if(fp) fclose(fp);
+
+  fp = fopen(filename,"ab");
+  if(!fp) {
+    char errmsg[500];
+    snprintf(errmsg,499,"Packing tile cache: cannot open file %s for writing",filename);
+    error->warning(FLERR,errmsg);
+    return;
+  }
+
+  if(is_new)
+    fwrite(TILE_MAGIC,sizeof(char),8,fp);
+
+  double const header[3] = {radius,fill_fraction,length};
+  int const nslots = nSlots();
+  fwrite(header,sizeof(double),3,fp);
+  fwrite(&nslots,sizeof(int),1,fp);
+  if(nslots > 0)
+    fwrite(&slots[0],sizeof(double),3*nslots,fp);
+  fclose(fp);
+}
+
+/**
+ * @brief Generate a periodic tile by random sequential addition
+ * @param seed random seed
+ */
+void PackingTileCache::generate(int seed)
+{
+  RanPark random(lmp,seed);
+
+  double const diameter = 2.*radius;
+  double const diameter_sq = diameter*diameter;
+  length = NCELL*diameter;
+
+  int const ntarget = static_cast<int>(fill_fraction*length*length*length/(MathConst::MY_4PI3*radius*radius*radius));
+  int const maxtry = MAX_ATTEMPT*ntarget;
+
+  // slots binned into cells of size slot diameter
+  std::vector<std::vector<int> > cells(NCELL*NCELL*NCELL);
+
+  double x[3],del[3];
+  int c[3];
+
+  for(int ntry = 0; ntry < maxtry && nSlots() < ntarget; ntry++) {
+    for(int d = 0; d < 3; d++) {
+      x[d] = random.uniform()*length;
+      c[d] = static_cast<int>(x[d]/diameter);
+      if(c[d] >= NCELL) c[d] = NCELL-1;
+    }
+
+    bool overlap = false;
+    for(int k = -1; k <= 1 && !overlap; k++)
+      for(int j = -1; j <= 1 && !overlap; j++)
+        for(int i = -1; i <= 1 && !overlap; i++) {
+          int const ic = (c[0]+i+NCELL)%NCELL;
+          int const jc = (c[1]+j+NCELL)%NCELL;
+          int const kc = (c[2]+k+NCELL)%NCELL;
+          std::vector<int> const &cell = cells[(kc*NCELL+jc)*NCELL+ic];
+          for(size_t n = 0; n < cell.size(); n++) {
+            // minimum image distance
+            for(int d = 0; d < 3; d++) {
+              del[d] = x[d]-slots[3*cell[n]+d];
+              if(del[d] > 0.5*length) del[d] -= length;
+              else if(del[d] < -0.5*length) del[d] += length;
+            }
+            if(del[0]*del[0]+del[1]*del[1]+del[2]*del[2] < diameter_sq) {
+              overlap = true;
+              break;
+            }
+          }
+        }
+
+    if(overlap) continue;
+
+    cells[(c[2]*NCELL+c[1])*NCELL+c[0]].push_back(nSlots());
+    slots.insert(slots.end(),x,x+3);
+  }
+
+  if(nSlots() < ntarget) {
+    char errmsg[300];
+    sprintf(errmsg,"Packing tile cache: could only place %d of %d slots, fill fraction is %f instead of %f",
+            nSlots(),ntarget,nSlots()*MathConst::MY_4PI3*radius*radius*radius/(length*length*length),fill_fraction);
+    error->warning(FLERR,errmsg);
+  }
+
+  if(screen)
+    fprintf(screen,"Packing tile cache: generated tile with %d slots\n",nSlots());
+}
+
+/**
+ * @brief Draw a new random transform for all tile copies
+ *
+ * Must be called with a random generator which is synchronized across
+ * processes, so that the tiling is consistent.
+ *
+ * @param random random generator
+ */
+void PackingTileCache::randomTransform(RanPark *random)
+{
+  // random permutation of the axes
+  int const iperm = static_cast<int>(6.*random->uniform()) % 6;
+  static const int perms[6][3] = {{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}};
+  for(int d = 0; d < 3; d++) {
+    perm[d] = perms[iperm][d];
+    mirror[d] = random->uniform() < 0.5;
+    shift[d] = random->uniform()*length;
+  }
+}
+
+/**
+ * @brief Collect all slot positions of the transformed tiling inside a box
+ * @param bbox      box to be filled
+ * @param positions slot positions inside bbox, 3 entries per slot
+ */
+void PackingTileCache::getSlotPositions(BoundingBox &bbox, std::vector<double> &positions) const
+{
+  positions.clear();
+  if(!bbox.hasVolume() || slots.empty()) return;
+
+  double lo[3],hi[3];
+  bbox.getBoxBounds(lo,hi);
+
+  int tlo[3],thi[3];
+  for(int d = 0; d < 3; d++) {
+    tlo[d] = static_cast<int>(floor((lo[d]-shift[d])/length));
+    thi[d] = static_cast<int>(floor((hi[d]-shift[d])/length));
+  }
+
+  int const nslots = nSlots();
+  double pos[3];
+
+  for(int k = tlo[2]; k <= thi[2]; k++)
+    for(int j = tlo[1]; j <= thi[1]; j++)
+      for(int i = tlo[0]; i <= thi[0]; i++) {
+        int const t[3] = {i,j,k};
+        for(int n = 0; n < nslots; n++) {
+          for(int d = 0; d < 3; d++) {
+            double c = slots[3*n+perm[d]];
+            if(mirror[d]) c = length-c;
+            pos[d] = shift[d]+t[d]*length+c;
+          }
+          if(bbox.isInside(pos))
+            positions.insert(positions.end(),pos,pos+3);
+        }
+      }
+}
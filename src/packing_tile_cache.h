@@ -0,0 +1,80 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#ifndef PACKING_TILE_CACHE_H
+#define PACKING_TILE_CACHE_H
+
+#include <vector>
+#include "bounding_box.h"
+#include "pointers.h"
+
+namespace LAMMPS_NS {
+class RanPark;
+}
+
+namespace LIGGGHTS {
+
+/**
+ * @brief A cache of periodic packing tiles used for particle insertion
+ *
+ * A tile is a cube holding non-overlapping slots of equal radius, generated
+ * by random sequential addition with periodic images. Copies of a tile can
+ * therefore be stacked seamlessly and slots never overlap each other, also
+ * across tile and processor boundaries. Tiles are keyed by slot radius and
+ * slot volume fraction and stored in a binary file, so that repeated
+ * insertions of the same recipe do not have to generate them again.
+ */
+class PackingTileCache : protected LAMMPS_NS::Pointers
+{
+public:
+  PackingTileCache(LAMMPS_NS::LAMMPS *lmp);
+
+  void setup(const char *filename, double radius, double fill_fraction, int seed);
+  bool isSetup() const { return !slots.empty(); }
+
+  void randomTransform(LAMMPS_NS::RanPark *random);
+  void getSlotPositions(LAMMPS_NS::BoundingBox &bbox, std::vector<double> &positions) const;
+
+  int nSlots() const { return static_cast<int>(slots.size()/3); }
+  double slotRadius() const { return radius; }
+
+  static const double max_fill_fraction;
+
+private:
+  std::vector<double> slots;  // slot positions in [0,length)^3
+  double radius;              // slot radius
+  double fill_fraction;       // slot volume fraction
+  double length;              // tile edge length
+
+  // transform applied to all tile copies: permutation and mirroring
+  // of the axes plus a shift
+  int perm[3];
+  bool mirror[3];
+  double shift[3];
+
+  bool read(const char *filename);
+  void write(const char *filename) const;
+  void generate(int seed);
+};
+
+}
+
+#endif // PACKING_TILE_CACHE_H
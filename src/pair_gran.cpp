@@ -29,6 +29,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 #include "atom.h"
 #include "atom_vec.h"
 #include "domain.h"
@@ -46,6 +47,7 @@
 #include "error.h"
 #include "properties.h"
 #include "fix_rigid.h"
+#include "fix_sleep.h"
 #include "fix_pour.h"
 #include "fix_particledistribution_discrete.h"
 #include "fix_pour.h"
@@ -82,6 +84,8 @@ PairGran::PairGran(LAMMPS *lmp) : Pair(lmp)
 
   nmax = 0;
 
+  fix_sleep_ = NULL;
+
   cpl_enable = 1;
   cpl_ = NULL;
 
@@ -225,6 +229,9 @@ void PairGran::init_style()
 
   //NP modified C.K. end
 
+  // pairs of sleeping particles are skipped
+  fix_sleep_ = static_cast<FixSleep*>(modify->find_fix_style_strict("sleep",0));
+
   dt = update->dt;
 
   // if shear history is stored:
@@ -507,6 +514,23 @@ void PairGran::unregister_compute_pair_local(ComputePairGranLocal *ptr)
    cpl_ = NULL;
 }
 
+/* ----------------------------------------------------------------------
+   register and unregister per-contact callbacks
+------------------------------------------------------------------------- */
+
+void PairGran::register_contact_consumer(PairGranContactConsumer *ptr)
+{
+   if(std::find(contact_consumers_.begin(),contact_consumers_.end(),ptr) == contact_consumers_.end())
+     contact_consumers_.push_back(ptr);
+}
+
+void PairGran::unregister_contact_consumer(PairGranContactConsumer *ptr)
+{
+   std::vector<PairGranContactConsumer*>::iterator it = std::find(contact_consumers_.begin(),contact_consumers_.end(),ptr);
+   if(it != contact_consumers_.end())
+     contact_consumers_.erase(it);
+}
+
 /* ----------------------------------------------------------------------
    return index for extra dnum
 ------------------------------------------------------------------------- */
@@ -522,6 +546,13 @@ int PairGran::fix_extra_dnum_index(class Fix *fix)
     return 0;
 }
 
+/* ---------------------------------------------------------------------- */
+
+double * PairGran::sleep_state()
+{
+    return fix_sleep_ ? fix_sleep_->state() : NULL;
+}
+
 /* ----------------------------------------------------------------------
    neighbor callback to inform pair style of neighbor list to use
    optional granular history list
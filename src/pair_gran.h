@@ -42,6 +42,19 @@ namespace LCM = LIGGGHTS::ContactModels;
 
 namespace LAMMPS_NS {
 
+/* ----------------------------------------------------------------------
+   interface for classes that evaluate per-contact quantities (e.g. heat
+   conduction) inside the pair loop instead of walking the neighbor list
+   again. called once per contact of each force evaluation, with the
+   collision data as computed by the contact models
+------------------------------------------------------------------------- */
+
+class PairGranContactConsumer {
+public:
+  virtual ~PairGranContactConsumer() {}
+  virtual void pair_contact_eval(const LCM::CollisionData & cdata, const LCM::ForceData & i_forces, const LCM::ForceData & j_forces) = 0;
+};
+
 class PairGran : public Pair, public LIGGGHTS::IContactHistorySetup {
 public:
 
@@ -79,6 +92,18 @@ public:
   void register_compute_pair_local(class ComputePairGranLocal *,int&);
   void unregister_compute_pair_local(class ComputePairGranLocal *ptr);
 
+  void register_contact_consumer(PairGranContactConsumer *ptr);
+  void unregister_contact_consumer(PairGranContactConsumer *ptr);
+
+  inline bool has_contact_consumers() const
+  { return !contact_consumers_.empty(); }
+
+  inline void contact_consumers_eval(LCM::CollisionData & cdata, LCM::ForceData & i_forces, LCM::ForceData & j_forces)
+  {
+    for(std::vector<PairGranContactConsumer*>::iterator it = contact_consumers_.begin(); it != contact_consumers_.end(); ++it)
+      (*it)->pair_contact_eval(cdata, i_forces, j_forces);
+  }
+
   inline void cpl_add_pair(LCM::CollisionData & cdata, LCM::ForceData & i_forces)
   {
     const double fx = i_forces.delta_F[0];
@@ -131,6 +156,9 @@ public:
   double * mr_pair()
   { return mass_rigid; }
 
+  // per-atom state of fix sleep, NULL if none
+  double * sleep_state();
+
   virtual double stressStrainExponent() = 0;
 
   class Properties* get_properties()
@@ -206,6 +234,9 @@ public:
   int cpl_enable;
   class ComputePairGranLocal *cpl_;
 
+  // per-contact callbacks from within the pair loop
+  std::vector<PairGranContactConsumer*> contact_consumers_;
+
   // storage for per-contact forces
   bool store_contact_forces_;
   class FixContactPropertyAtom *fix_contact_forces_;
@@ -216,6 +247,8 @@ public:
   double *mass_rigid;        // rigid mass for owned+ghost atoms
   int nmax;                  // allocated size of mass_rigid
 
+  class FixSleep *fix_sleep_; // ptr to fix sleep, NULL if none
+
   double dt;
   int freeze_group_bit_;
 
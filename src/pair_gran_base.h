@@ -38,6 +38,7 @@
 #include "neighbor.h"
 #include "neigh_list.h"
 #include "fix_contact_property_atom.h"
+#include "fix_sleep.h"
 #include "os_specific.h"
 
 #include "granular_pair_style.h"
@@ -85,6 +86,7 @@ public:
     Settings settings(lmp);
     cmodel.registerSettings(settings);
     bool success = settings.parseArguments(nargs, args);
+    if(success) cmodel.postSettings();
 
 #ifdef LIGGGHTS_DEBUG
     if(comm->me == 0) {
@@ -187,6 +189,8 @@ public:
     const int dnum = pg->dnum();
     const bool store_contact_forces = pg->storeContactForces();
     const int freeze_group_bit = pg->freeze_group_bit();
+    const bool contact_consumers = pg->has_contact_consumers();
+    const double * const sleep = pg->sleep_state();
 
     // clear data, just to be safe
     memset((void*)aligned_cdata, 0, sizeof(CollisionData));
@@ -230,6 +234,36 @@ public:
       for (int jj = 0; jj < jnum; jj++) {
         const int j = jlist[jj] & NEIGHMASK;
 
+        // both asleep: no force and no history update, keep touch flag and
+        // contact history, but contact consumers (e.g. heat conduction) still
+        // see the contact
+        if (sleep && sleep[i] == FixSleep::SLEEP_ASLEEP && sleep[j] == FixSleep::SLEEP_ASLEEP) {
+          if (contact_consumers && cdata.computeflag) {
+            const double delx = xtmp - x[j][0];
+            const double dely = ytmp - x[j][1];
+            const double delz = ztmp - x[j][2];
+            const double rsq = delx * delx + dely * dely + delz * delz;
+            const double radsum = radi + radius[j];
+            if (rsq < radsum * radsum) {
+              cdata.j = j;
+              cdata.delta[0] = delx;
+              cdata.delta[1] = dely;
+              cdata.delta[2] = delz;
+              cdata.rsq = rsq;
+              cdata.radj = radius[j];
+              cdata.radsum = radsum;
+              cdata.itype = type[i];
+              cdata.jtype = type[j];
+              cdata.touch = touch ? &touch[jj] : NULL;
+              cdata.contact_history = allshear ? &allshear[dnum*jj] : NULL;
+              i_forces.reset();
+              j_forces.reset();
+              pg->contact_consumers_eval(cdata, i_forces, j_forces);
+            }
+          }
+          continue;
+        }
+
         const double delx = xtmp - x[j][0];
         const double dely = ytmp - x[j][1];
         const double delz = ztmp - x[j][2];
@@ -331,6 +365,9 @@ public:
           // if there is a collision, there will always be a force
           cdata.has_force_update = true;
 
+          if (contact_consumers && cdata.computeflag)
+            pg->contact_consumers_eval(cdata, i_forces, j_forces);
+
         } else {
           // apply force update only if selected contact models have requested it
           cdata.has_force_update = false;
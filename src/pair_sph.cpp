@@ -67,6 +67,7 @@ PairSph::PairSph(LAMMPS *lmp) : Pair(lmp)
     fppaSlType = NULL;
     sl = NULL;
     slComType = NULL;
+    sl_const = 0;
 
     fix_fgradP_ = NULL;
 
@@ -246,7 +247,15 @@ void PairSph::init_style()
         slComType[i][j] = slComType[j][i] = interpDist(sli,slj);;
 }
 
+    // allows kernel loops with smoothing length fixed at loop entry
+
+    sl_const = 1;
+    for (i = 1; i <= ntypes; i++)
+      for (j = 1; j <= ntypes; j++)
+        if (slComType[i][j] != slComType[1][1]) sl_const = 0;
+
   } else {
+    sl_const = 0;
     // register per-particle property smoothing length
 
     if (fppaSl == NULL) {
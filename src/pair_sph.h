@@ -87,6 +87,7 @@ class PairSph : public Pair {
   double *maxrad;
 
   int mass_type; // flag defined in atom_vec*
+  int sl_const;  // 1 if common smoothing length is the same for all type pairs
 
   int pairStyle_;
   double viscosity_;
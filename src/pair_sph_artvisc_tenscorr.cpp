@@ -50,6 +50,8 @@ andreas.aigner@jku.at
 
 using namespace LAMMPS_NS;
 
+#define NBLOCK 64     // neighbors per block of kernel evaluations
+
 /* ---------------------------------------------------------------------- */
 
 PairSphArtviscTenscorr::PairSphArtviscTenscorr(LAMMPS *lmp) : PairSph(lmp),
@@ -253,8 +255,26 @@ void PairSphArtviscTenscorr::allocate_properties(int size)
 
 void PairSphArtviscTenscorr::compute(int eflag, int vflag)
 {
-  if (mass_type) compute_eval<1>(eflag,vflag);
-  else compute_eval<0>(eflag,vflag);
+  if (mass_type && sl_const) compute_kernel<1,1>(eflag,vflag);
+  else if (mass_type) compute_kernel<1,0>(eflag,vflag);
+  else compute_kernel<0,0>(eflag,vflag);
+}
+
+/* ----------------------------------------------------------------------
+   resolve kernel id to a template parameter
+------------------------------------------------------------------------- */
+
+template <int MASSFLAG, int CONSTSL>
+void PairSphArtviscTenscorr::compute_kernel(int eflag, int vflag)
+{
+  if (0) return;
+  #define SPH_KERNEL_CLASS
+  #define SPHKernel(id,kernelstyle,SPHKernelCalculation,SPHKernelCalculationDer,SPHKernelCalculationCut) \
+  else if (kernel_id == id) compute_eval<MASSFLAG,CONSTSL,id>(eflag,vflag);
+  #include "style_sph_kernel.h"
+  #undef SPH_KERNEL_CLASS
+  #undef SPHKernel
+  else error->all(FLERR,"Illegal pair_style sph/artVisc/tensCorr command, unknown sph kernel");
 }
 
 /* ----------------------------------------------------------------------
@@ -315,17 +335,26 @@ void PairSphArtviscTenscorr::read_restart_settings(FILE *fp)
 
 /* ----------------------------------------------------------------------
    template compute
+   neighbors are processed in blocks of NBLOCK
+   (1) collect neighbors within cutoff
+   (2) evaluate kernel derivative (and kernel for tensile correction)
+       for all of them in one loop
+   (3) calculate and apply forces
 ------------------------------------------------------------------------- */
 
-template <int MASSFLAG>
+template <int MASSFLAG, int CONSTSL, int KERNEL>
 void PairSphArtviscTenscorr::compute_eval(int eflag, int vflag)
 {
-  double sli,slCom,imass,jmass;
+  double sli=0.,slCom,imass,jmass;
   double artVisc,fAB4,rAB;
   double rA,rB;
   double wDeltaPinv;
 
-  double radi,rcom;
+  double radi=0.,rcom=0.;
+
+  int jblock[NBLOCK];
+  double delblock[NBLOCK][3],rsqblock[NBLOCK],slblock[NBLOCK];
+  double rinvblock[NBLOCK],sblock[NBLOCK],dwblock[NBLOCK],wblock[NBLOCK];
 
   double **x = atom->x;
   double **v = atom->vest;
@@ -360,6 +389,15 @@ void PairSphArtviscTenscorr::compute_eval(int eflag, int vflag)
     updatePtrs(); // get sl
   }
 
+  // common smoothing length and cutoff if same for all types
+
+  double slConst = 0.,slConstInv = 0.,cutsqConst = 0.;
+  if (CONSTSL) {
+    slConst = slComType[1][1];
+    slConstInv = 1./slConst;
+    cutsqConst = cutsq[1][1];
+  }
+
   for (int ii = 0; ii < inum; ii++) {
     const int i = ilist[ii];
     const int itype = type[i];
@@ -380,50 +418,86 @@ void PairSphArtviscTenscorr::compute_eval(int eflag, int vflag)
       imass = rmass[i];
     }
 
-    // derivative of kernel must be 0 at s = 0
-    // so particle itself is not contributing
-
-    for (int jj = 0; jj < jnum; jj++) {
-      const int j = jlist[jj];
-      const int jtype = type[j];
+    for (int jstart = 0; jstart < jnum; jstart += NBLOCK) {
+      const int jend = MIN(jstart+NBLOCK,jnum);
 
-      const double delx = xtmp - x[j][0];
-      const double dely = ytmp - x[j][1];
-      const double delz = ztmp - x[j][2];
-      const double rsq = delx*delx + dely*dely + delz*delz;
+      // collect neighbors within cutoff
 
-      if (!MASSFLAG) {
-        const double radj = radius[j];
-        rcom = interpDist(radi,radj);
-      }
+      int nblock = 0;
+      for (int jj = jstart; jj < jend; jj++) {
+        const int j = jlist[jj];
 
-      if ((MASSFLAG && rsq < cutsq[itype][jtype]) || (!MASSFLAG && rsq < rcom*rcom)) {
+        const double delx = xtmp - x[j][0];
+        const double dely = ytmp - x[j][1];
+        const double delz = ztmp - x[j][2];
+        const double rsq = delx*delx + dely*dely + delz*delz;
 
-        if (MASSFLAG) {
-          jmass = mass[jtype];
+        if (CONSTSL) {
+          if (rsq >= cutsqConst) continue;
+          slCom = slConst;
+        } else if (MASSFLAG) {
+          const int jtype = type[j];
+          if (rsq >= cutsq[itype][jtype]) continue;
           slCom = slComType[itype][jtype];
         } else {
-          jmass = rmass[j];
+          const double radj = radius[j];
+          rcom = interpDist(radi,radj);
+          if (rsq >= rcom*rcom) continue;
           const double slj = sl[j];
           slCom = interpDist(sli,slj);
         }
 
-        const double pj = p[j];
-        const double rhoj = rho[j];
-        const double slComInv = 1./slCom;
-        //cut = slCom*SPH_KERNEL_NS::sph_kernel_cut(kernel_id);
-
-        // get distance and normalized distance
-        const double r = sqrt(rsq);
-        if (r == 0.) {
+        if (rsq == 0.) {
           printf("Particle %i and %i are at same position (%f, %f, %f)",i,j,xtmp,ytmp,ztmp);
           error->one(FLERR,"Zero distance between SPH particles!");
         }
-        const double rinv = 1./r;
-        const double s = r * slComInv;
 
-        // calculate value for magnitude of grad W
-        const double gradWmag = SPH_KERNEL_NS::sph_kernel_der(kernel_id,s,slCom,slComInv);
+        jblock[nblock] = j;
+        delblock[nblock][0] = delx;
+        delblock[nblock][1] = dely;
+        delblock[nblock][2] = delz;
+        rsqblock[nblock] = rsq;
+        slblock[nblock] = slCom;
+        nblock++;
+      }
+
+      // get distance, normalized distance and kernel values for whole block
+      // derivative of kernel must be 0 at s = 0
+      // so particle itself is not contributing
+
+      for (int k = 0; k < nblock; k++) {
+        const double slComInv = CONSTSL ? slConstInv : 1./slblock[k];
+        const double r = sqrt(rsqblock[k]);
+        rinvblock[k] = 1./r;
+        sblock[k] = r * slComInv;
+        dwblock[k] = SPH_KERNEL_NS::SPHKernelStatic<KERNEL>::der(sblock[k],slblock[k],slComInv);
+      }
+
+      if (tensCorr_flag) {
+        for (int k = 0; k < nblock; k++) {
+          const double slComInv = CONSTSL ? slConstInv : 1./slblock[k];
+          wblock[k] = SPH_KERNEL_NS::SPHKernelStatic<KERNEL>::value(sblock[k],slblock[k],slComInv);
+        }
+      }
+
+      // calculate and apply forces
+
+      for (int k = 0; k < nblock; k++) {
+        const int j = jblock[k];
+        const int jtype = type[j];
+        const double delx = delblock[k][0];
+        const double dely = delblock[k][1];
+        const double delz = delblock[k][2];
+        const double rsq = rsqblock[k];
+        const double rinv = rinvblock[k];
+        const double gradWmag = dwblock[k];
+        slCom = slblock[k];
+
+        if (MASSFLAG) jmass = mass[jtype];
+        else jmass = rmass[j];
+
+        const double pj = p[j];
+        const double rhoj = rho[j];
 
         // artificial viscosity
         artVisc = 0.0;
@@ -440,9 +514,6 @@ void PairSphArtviscTenscorr::compute_eval(int eflag, int vflag)
             const double rhoMeanInv = 2/(rhoi+rhoj);
             artVisc = ((- alphaMean[itype][jtype] * csmean[itype][jtype] * muAB + betaMean[itype][jtype] * muAB * muAB) * rhoMeanInv);
           }
-
-          //version with function
-          //artVisc = artificialViscosity(i,j,itype,jtype,r,slCom,delx,dely,delz,rhoi,rhoj,v); //XXX: function call is slower :-/
         }
 
         // tensile correction
@@ -463,12 +534,13 @@ void PairSphArtviscTenscorr::compute_eval(int eflag, int vflag)
             wDeltaPinv = wDeltaPTypeinv[itype][jtype];
           } else {
             // assumption that deltaP = sl / 1.2
+            const double slComInv = 1./slCom;
             const double deltaPOne = slCom/1.2;
-            wDeltaPinv = 1./SPH_KERNEL_NS::sph_kernel(kernel_id,deltaPOne * slComInv,slCom,slComInv);
+            wDeltaPinv = 1./SPH_KERNEL_NS::SPHKernelStatic<KERNEL>::value(deltaPOne * slComInv,slCom,slComInv);
           }
 
           //TODO: Is fAB4 in this form ok?!
-          const double fAB =  SPH_KERNEL_NS::sph_kernel(kernel_id,s,slCom,slComInv) * wDeltaPinv;
+          const double fAB = wblock[k] * wDeltaPinv;
           const double fAB2 = fAB * fAB;
           fAB4 = fAB2 * fAB2;
         }
@@ -57,7 +57,8 @@ class PairSphArtviscTenscorr : public PairSph {
 
  protected:
   void allocate();
-  template <int> void compute_eval(int, int);
+  template <int,int> void compute_kernel(int, int);
+  template <int,int,int> void compute_eval(int, int);
 
   int     artVisc_flag, tensCorr_flag; // flags for additional styles
 
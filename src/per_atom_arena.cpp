@@ -0,0 +1,373 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#include <stdlib.h>
+#include <string.h>
+#include "per_atom_arena.h"
+#include "atom.h"
+#include "comm.h"
+#include "memory.h"
+#include "error.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+using namespace LAMMPS_NS;
+
+#define ALIGNMENT 64                 // column blocks start on cache lines
+#define HUGEPAGE (2*1024*1024)
+
+/* ---------------------------------------------------------------------- */
+
+PerAtomArena::PerAtomArena(LAMMPS *lmp) : Pointers(lmp),
+  nmax_(0),
+  frozen_(0),
+  hugepages_(false),
+  block_(NULL),
+  nbytes_(0),
+  nexchange_(0),
+  batch_(false),
+  packbuf_(NULL)
+{
+}
+
+/* ---------------------------------------------------------------------- */
+
+PerAtomArena::~PerAtomArena()
+{
+  for (size_t f = 0; f < fields_.size(); f++) {
+    memory->sfree(fields_[f].rows);
+    memory->sfree(fields_[f].own);
+  }
+  memory->sfree(block_);
+}
+
+/* ----------------------------------------------------------------------
+   register a field, storage is allocated immediately
+------------------------------------------------------------------------- */
+
+void PerAtomArena::add_field(const char *name, double **vector, int flags)
+{
+  add(name,ARENA_DOUBLE,1,false,vector,flags);
+}
+
+void PerAtomArena::add_field(const char *name, double ***array, int width, int flags)
+{
+  add(name,ARENA_DOUBLE,width,true,array,flags);
+}
+
+void PerAtomArena::add_field(const char *name, int **vector, int flags)
+{
+  add(name,ARENA_INT,1,false,vector,flags);
+}
+
+void PerAtomArena::add_field(const char *name, int ***array, int width, int flags)
+{
+  add(name,ARENA_INT,width,true,array,flags);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PerAtomArena::add(const char *name, int type, int width, bool array, void *address, int flags)
+{
+  if (width < 1)
+    error->all(FLERR,"Per-atom field must have at least one value per atom");
+
+  for (size_t f = 0; f < fields_.size(); f++)
+    if (fields_[f].address == address)
+      error->all(FLERR,"Per-atom field registered twice");
+
+  Field field;
+  strncpy(field.name,name,sizeof(field.name)-1);
+  field.name[sizeof(field.name)-1] = '\0';
+  field.type = type;
+  field.width = width;
+  field.flags = flags;
+  field.array = array;
+  field.address = address;
+  field.rows = NULL;
+  field.rowbytes = width * (type == ARENA_INT ? sizeof(int) : sizeof(double));
+  field.base = NULL;
+  field.own = NULL;
+  fields_.push_back(field);
+  if (flags & ARENA_EXCHANGE) nexchange_ += width;
+
+  //NP new field is zeroed by reallocate()
+  if (atom->nmax > nmax_) {
+    reallocate(atom->nmax);
+    return;
+  }
+
+  //NP other fields stay where they are, merged into the block by next grow()
+  Field &added = fields_.back();
+  if (nmax_) {
+    added.own = static_cast<char*>(allocate(nmax_*added.rowbytes));
+    memset(added.own,0,nmax_*added.rowbytes);
+  }
+  place(added,added.own,nmax_);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PerAtomArena::remove_field(void *address)
+{
+  for (size_t f = 0; f < fields_.size(); f++) {
+    if (fields_[f].address != address) continue;
+
+    //NP a column in the block stays unused until the next grow()
+    memory->sfree(fields_[f].rows);
+    memory->sfree(fields_[f].own);
+    if (fields_[f].flags & ARENA_EXCHANGE) nexchange_ -= fields_[f].width;
+    if (fields_[f].array) *static_cast<void ***>(address) = NULL;
+    else *static_cast<void **>(address) = NULL;
+    fields_.erase(fields_.begin()+f);
+    return;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   called by AtomVec::grow() when per-atom arrays are re-allocated
+------------------------------------------------------------------------- */
+
+void PerAtomArena::grow(int nmax)
+{
+  if (!frozen_ && nmax != nmax_) reallocate(nmax);
+}
+
+/* ----------------------------------------------------------------------
+   move all fields into a new block for nmax atoms
+   one allocation and one memcpy per field, values beyond the old nmax
+   are uninitialized as with memory->grow(), new fields are zeroed
+------------------------------------------------------------------------- */
+
+void PerAtomArena::reallocate(int nmax)
+{
+  const int nfield = fields_.size();
+
+  std::vector<size_t> offset(nfield);
+  size_t nbytes = 0;
+  for (int f = 0; f < nfield; f++) {
+    offset[f] = nbytes;
+    nbytes += ((nmax*fields_[f].rowbytes + ALIGNMENT-1) / ALIGNMENT) * ALIGNMENT;
+  }
+
+  char *block = static_cast<char*>(allocate(nbytes));
+  const int ncopy = nmax < nmax_ ? nmax : nmax_;
+
+  for (int f = 0; f < nfield; f++) {
+    Field &field = fields_[f];
+    char *base = block + offset[f];
+
+    if (field.base) memcpy(base,field.base,ncopy*field.rowbytes);
+    else if (nmax) memset(base,0,nmax*field.rowbytes);
+    memory->sfree(field.own);
+    field.own = NULL;
+    place(field,base,nmax);
+  }
+
+  memory->sfree(block_);
+  block_ = block;
+  nbytes_ = nbytes;
+  nmax_ = nmax;
+}
+
+/* ----------------------------------------------------------------------
+   point field and the address it was registered with to its storage
+------------------------------------------------------------------------- */
+
+void PerAtomArena::place(Field &field, char *base, int nmax)
+{
+  field.base = nmax ? base : NULL;
+
+  if (field.array) {
+    field.rows = static_cast<void **>(memory->srealloc(field.rows,nmax*sizeof(void *),"arena:rows"));
+    for (int i = 0; i < nmax; i++)
+      field.rows[i] = base + i*field.rowbytes;
+    *static_cast<void ***>(field.address) = field.rows;
+  } else
+    *static_cast<void **>(field.address) = field.base;
+}
+
+/* ----------------------------------------------------------------------
+   large blocks optionally go to transparent huge pages
+------------------------------------------------------------------------- */
+
+void* PerAtomArena::allocate(size_t nbytes)
+{
+  if (nbytes == 0) return NULL;
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (hugepages_ && nbytes >= HUGEPAGE) {
+    void *ptr;
+    nbytes = ((nbytes + HUGEPAGE-1) / HUGEPAGE) * HUGEPAGE;
+    if (posix_memalign(&ptr,HUGEPAGE,nbytes) == 0) {
+      //NP only a hint, kernel may still use small pages
+      madvise(ptr,nbytes,MADV_HUGEPAGE);
+      return ptr;
+    }
+  }
+#endif
+
+  return memory->smalloc(nbytes,"arena:block");
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PerAtomArena::set_hugepages(bool flag)
+{
+#if !defined(__linux__) || !defined(MADV_HUGEPAGE)
+  if (flag && comm->me == 0)
+    error->warning(FLERR,"Huge pages not supported on this platform, ignored");
+#endif
+  hugepages_ = flag;
+}
+
+/* ----------------------------------------------------------------------
+   re-order first n atoms in all fields
+   permute[I] = J means Ith new atom is Jth old atom
+------------------------------------------------------------------------- */
+
+void PerAtomArena::permute(const int *permute, int n)
+{
+  const int nfield = fields_.size();
+
+  for (int f = 0; f < nfield; f++) {
+    const size_t rb = fields_[f].rowbytes;
+    char *base = fields_[f].base;
+
+    if (scratch_.size() < n*rb) scratch_.resize(n*rb);
+    char *scratch = scratch_.empty() ? NULL : &scratch_[0];
+
+    //NP gather whole column, then copy back in one go
+    for (int i = 0; i < n; i++)
+      memcpy(scratch + i*rb, base + permute[i]*rb, rb);
+    if (n) memcpy(base,scratch,n*rb);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   pack fields of atom i carried along on migration
+------------------------------------------------------------------------- */
+
+int PerAtomArena::pack_exchange(int i, double *buf)
+{
+  if (frozen_) return 0;
+
+  if (batch_) {
+    packatom_.push_back(i);
+    packoffset_.push_back(buf-packbuf_);
+    return nexchange_;
+  }
+
+  const int nfield = fields_.size();
+  int m = 0;
+
+  for (int f = 0; f < nfield; f++) {
+    const Field &field = fields_[f];
+    if (!(field.flags & ARENA_EXCHANGE)) continue;
+
+    const int w = field.width;
+    if (field.type == ARENA_DOUBLE) {
+      const double *val = reinterpret_cast<const double*>(field.base) + i*w;
+      for (int k = 0; k < w; k++) buf[m++] = val[k];
+    } else {
+      const int *val = reinterpret_cast<const int*>(field.base) + i*w;
+      for (int k = 0; k < w; k++) buf[m++] = ubuf(val[k]).d;
+    }
+  }
+  return m;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PerAtomArena::begin_pack_exchange(double *buf)
+{
+  packatom_.clear();
+  packoffset_.clear();
+  packbuf_ = buf;
+  batch_ = true;
+}
+
+/* ----------------------------------------------------------------------
+   fill reserved sections of all atoms packed since begin_pack_exchange()
+   loops over fields outside, so each column block is read in one sweep
+------------------------------------------------------------------------- */
+
+void PerAtomArena::end_pack_exchange()
+{
+  batch_ = false;
+
+  const int nfield = fields_.size();
+  const int npack = packatom_.size();
+  int pos = 0;
+
+  for (int f = 0; f < nfield; f++) {
+    const Field &field = fields_[f];
+    if (!(field.flags & ARENA_EXCHANGE)) continue;
+
+    const int w = field.width;
+    if (field.type == ARENA_DOUBLE) {
+      const double *col = reinterpret_cast<const double*>(field.base);
+      for (int k = 0; k < npack; k++) {
+        const double *val = col + packatom_[k]*w;
+        double *dst = packbuf_ + packoffset_[k] + pos;
+        for (int d = 0; d < w; d++) dst[d] = val[d];
+      }
+    } else {
+      const int *col = reinterpret_cast<const int*>(field.base);
+      for (int k = 0; k < npack; k++) {
+        const int *val = col + packatom_[k]*w;
+        double *dst = packbuf_ + packoffset_[k] + pos;
+        for (int d = 0; d < w; d++) dst[d] = ubuf(val[d]).d;
+      }
+    }
+    pos += w;
+  }
+
+  packatom_.clear();
+  packoffset_.clear();
+}
+
+/* ---------------------------------------------------------------------- */
+
+int PerAtomArena::unpack_exchange(int nlocal, double *buf)
+{
+  if (frozen_) return 0;
+
+  const int nfield = fields_.size();
+  int m = 0;
+
+  for (int f = 0; f < nfield; f++) {
+    const Field &field = fields_[f];
+    if (!(field.flags & ARENA_EXCHANGE)) continue;
+
+    const int w = field.width;
+    if (field.type == ARENA_DOUBLE) {
+      double *val = reinterpret_cast<double*>(field.base) + nlocal*w;
+      for (int k = 0; k < w; k++) val[k] = buf[m++];
+    } else {
+      int *val = reinterpret_cast<int*>(field.base) + nlocal*w;
+      for (int k = 0; k < w; k++) val[k] = (int) ubuf(buf[m++]).i;
+    }
+  }
+  return m;
+}
@@ -0,0 +1,163 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_PER_ATOM_ARENA_H
+#define LMP_PER_ATOM_ARENA_H
+
+#include <string.h>
+#include <vector>
+#include "pointers.h"
+
+namespace LAMMPS_NS {
+
+enum
+{
+    ARENA_DOUBLE = 0,
+    ARENA_INT = 1
+};
+
+// field semantics, may be or'ed
+
+enum
+{
+    ARENA_EXCHANGE = 1        // carried along when atom migrates to another proc
+};
+
+/* ----------------------------------------------------------------------
+   per-atom fields of fixes stored in one allocation
+
+   each field is a column block of nmax x width values. the arena writes
+   the current location of a field to the address it was registered with
+   (vector or 2d array of the owner), so owners access their data as before
+
+   grow, copy, permutation and exchange packing are done for all fields
+   at once instead of through one virtual call per fix
+
+   fields only move when nmax changes, as with memory->grow(). adding or
+   removing a field leaves all other fields in place, a field added later
+   gets its own allocation until the next grow() merges it into the block
+------------------------------------------------------------------------- */
+
+class PerAtomArena : protected Pointers {
+ public:
+  PerAtomArena(class LAMMPS *);
+  ~PerAtomArena();
+
+  // register vector or 2d array, allocated to current atom->nmax
+  void add_field(const char *name, double **vector, int flags);
+  void add_field(const char *name, double ***array, int width, int flags);
+  void add_field(const char *name, int **vector, int flags);
+  void add_field(const char *name, int ***array, int width, int flags);
+
+  // unregister and free field, address is set to NULL
+  void remove_field(void *address);
+
+  void grow(int nmax);
+  inline void copy(int i, int j);
+  void permute(const int *permute, int n);
+
+  // ignore calls from AtomVec, used while atoms are re-ordered via
+  // permute() and by hybrid atom styles around calls to their sub-styles
+  // calls nest
+  void freeze()
+  { frozen_++; }
+  void thaw()
+  { frozen_--; }
+
+  int pack_exchange(int i, double *buf);
+  int unpack_exchange(int nlocal, double *buf);
+
+  // batched packing for Comm::exchange()
+  // between begin and end, pack_exchange() only reserves its section in
+  // the send buffer, end_pack_exchange() fills all sections field by field
+  // the send buffer must be passed again whenever it is re-allocated
+  void begin_pack_exchange(double *buf);
+  void pack_exchange_buffer(double *buf)
+  { packbuf_ = buf; }
+  void end_pack_exchange();
+
+  void set_hugepages(bool flag);
+  int nfields()
+  { return fields_.size(); }
+
+ private:
+
+  struct Field
+  {
+    char name[64];
+    int type;
+    int width;
+    int flags;
+    bool array;               // address is 2d array, else vector
+    void *address;
+    void **rows;              // row pointers of 2d array
+    size_t rowbytes;          // bytes per atom
+    char *base;               // start of column block
+    char *own;                // own allocation if added after last reallocate()
+  };
+
+  void add(const char *name, int type, int width, bool array, void *address, int flags);
+  void reallocate(int nmax);
+  void place(Field &field, char *base, int nmax);
+  void* allocate(size_t nbytes);
+
+  union ubuf {
+    double d;
+    int64_t i;
+    ubuf(double arg) : d(arg) {}
+    ubuf(int64_t arg) : i(arg) {}
+    ubuf(int arg) : i(arg) {}
+  };
+
+  std::vector<Field> fields_;
+  int nmax_;
+  int frozen_;
+  bool hugepages_;
+
+  char *block_;
+  size_t nbytes_;
+  std::vector<char> scratch_;
+
+  int nexchange_;                     // # values per atom in exchange
+  bool batch_;
+  double *packbuf_;
+  std::vector<int> packatom_;         // atoms packed in batch
+  std::vector<bigint> packoffset_;    // start of their section in packbuf_
+};
+
+/* ----------------------------------------------------------------------
+   copy atom i to atom j in all fields
+------------------------------------------------------------------------- */
+
+inline void PerAtomArena::copy(int i, int j)
+{
+  if (frozen_) return;
+
+  const int n = fields_.size();
+  for (int f = 0; f < n; f++) {
+    const size_t rb = fields_[f].rowbytes;
+    memcpy(fields_[f].base + j*rb, fields_[f].base + i*rb, rb);
+  }
+}
+
+}
+
+#endif
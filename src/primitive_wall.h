@@ -30,6 +30,7 @@
 
 #include "container.h"
 #include "neighbor.h"
+#include "atom.h"
 #include "primitive_wall_definitions.h"
 
 namespace LAMMPS_NS
@@ -63,15 +64,26 @@ namespace LAMMPS_NS
 
         inline void buildNeighList(double neighCutoff, double **x, double *r, int nPart);
 
-        inline double resolveContact(double *x, double r, double *delta);
-        inline bool resolveSameSide(double *x0, double *x1);
-        inline bool resolveNeighlist(double *x, double r, double treshold);
+        //NP virtual so walls that are not described analytically can derive
+        virtual double resolveContact(double *x, double r, double *delta);
+        virtual bool resolveSameSide(double *x0, double *x1);
+        virtual bool resolveNeighlist(double *x, double r, double treshold);
+
+        // called on every re-neighboring, collectively
+        virtual void preNeighbor() {}
 
         inline int axis();
         inline double calcRadialDistance(double *pos, double *distvec);
 
         inline int isNear(int iPart,double treshold);
 
+      protected:
+
+        // wall without analytic description
+        PrimitiveWall(LAMMPS *lmp)
+        : Pointers(lmp), neighlist("neighlist"), wType(PRIMITIVE_WALL_DEFINITIONS::NUM_WTYPE), param(0), nParam(0)
+        {}
+
       private:
         ScalarContainer<int> neighlist;
         PRIMITIVE_WALL_DEFINITIONS::WallType wType;
@@ -87,12 +99,12 @@ namespace LAMMPS_NS
 
 
 
-  double PrimitiveWall::resolveContact(double *x, double r, double *delta)
+  inline double PrimitiveWall::resolveContact(double *x, double r, double *delta)
   {
     return PRIMITIVE_WALL_DEFINITIONS::chooseContactTemplate(x, r, delta, param, wType);
   }
 
-  bool PrimitiveWall::resolveSameSide(double *x0, double *x1)
+  inline bool PrimitiveWall::resolveSameSide(double *x0, double *x1)
   {
     return PRIMITIVE_WALL_DEFINITIONS::chooseSameSideTemplate(x0, x1, param, wType);
   }
@@ -107,7 +119,7 @@ namespace LAMMPS_NS
     return PRIMITIVE_WALL_DEFINITIONS::chooseCalcRadialDistance(pos, param, distvec[0],distvec[1],distvec[2], wType);
   }
 
-  bool PrimitiveWall::resolveNeighlist(double *x, double r, double treshold)
+  inline bool PrimitiveWall::resolveNeighlist(double *x, double r, double treshold)
   {
     return PRIMITIVE_WALL_DEFINITIONS::chooseNeighlistTemplate(x,r,treshold,param,wType);
   }
@@ -0,0 +1,573 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#include <math.h>
+#include <string.h>
+#include "primitive_wall_distance_field.h"
+#include "tri_mesh.h"
+#include "input_mesh_tri.h"
+#include "domain.h"
+#include "comm.h"
+#include "error.h"
+#include "mpi_liggghts.h"
+#include "vector_liggghts.h"
+
+#define LARGE_DISTFIELD 1000000.
+
+using namespace LAMMPS_NS;
+
+/* ----------------------------------------------------------------------
+   closest point cp on triangle a,b,c to point p
+------------------------------------------------------------------------- */
+
+static inline void closestPointTriangle(const double *p, const double *a, const double *b,
+                                        const double *c, double *cp)
+{
+    double ab[3],ac[3],ap[3];
+    vectorSubtract3D(b,a,ab);
+    vectorSubtract3D(c,a,ac);
+    vectorSubtract3D(p,a,ap);
+
+    const double d1 = vectorDot3D(ab,ap);
+    const double d2 = vectorDot3D(ac,ap);
+    if(d1 <= 0. && d2 <= 0.)
+    {
+        vectorCopy3D(a,cp);
+        return;
+    }
+
+    double bp[3];
+    vectorSubtract3D(p,b,bp);
+    const double d3 = vectorDot3D(ab,bp);
+    const double d4 = vectorDot3D(ac,bp);
+    if(d3 >= 0. && d4 <= d3)
+    {
+        vectorCopy3D(b,cp);
+        return;
+    }
+
+    const double vc = d1*d4 - d3*d2;
+    if(vc <= 0. && d1 >= 0. && d3 <= 0.)
+    {
+        vectorAddMultiple3D(a,d1/(d1-d3),ab,cp);
+        return;
+    }
+
+    double pc[3];
+    vectorSubtract3D(p,c,pc);
+    const double d5 = vectorDot3D(ab,pc);
+    const double d6 = vectorDot3D(ac,pc);
+    if(d6 >= 0. && d5 <= d6)
+    {
+        vectorCopy3D(c,cp);
+        return;
+    }
+
+    const double vb = d5*d2 - d1*d6;
+    if(vb <= 0. && d2 >= 0. && d6 <= 0.)
+    {
+        vectorAddMultiple3D(a,d2/(d2-d6),ac,cp);
+        return;
+    }
+
+    const double va = d3*d6 - d5*d4;
+    if(va <= 0. && (d4-d3) >= 0. && (d5-d6) >= 0.)
+    {
+        double bc[3];
+        vectorSubtract3D(c,b,bc);
+        vectorAddMultiple3D(b,(d4-d3)/((d4-d3)+(d5-d6)),bc,cp);
+        return;
+    }
+
+    // inside face
+    const double denom = 1./(va+vb+vc);
+    const double v = vb*denom, w = vc*denom;
+    for(int i = 0; i < 3; i++)
+        cp[i] = a[i] + ab[i]*v + ac[i]*w;
+}
+
+/* ----------------------------------------------------------------------
+   signed distance of p to triangle a,b,c with unit normal n
+
+   of several triangles at the same distance (shared edge or corner), the
+   one whose normal is best aligned with the distance vector decides the
+   sign. dist and align hold the best match so far, returns true if the
+   triangle is a better match
+------------------------------------------------------------------------- */
+
+static inline bool closerTriangle(const double *p, const double *tri, const double *n,
+                                  double eps, double &dist, double &align, double &d, double *grad)
+{
+    double cp[3],v[3];
+    closestPointTriangle(p,&tri[0],&tri[3],&tri[6],cp);
+    vectorSubtract3D(p,cp,v);
+    const double dst = vectorMag3D(v);
+    if(dst > dist + eps)
+        return false;
+
+    const double vn = vectorDot3D(v,n);
+    const double aln = dst > eps ? fabs(vn)/dst : 1.;
+    if(dst > dist - eps && aln <= align)
+        return false;
+
+    dist = dst;
+    align = aln;
+    const double sign = vn < 0. ? -1. : 1.;
+    d = sign*dst;
+
+    //NP gradient of the signed distance
+    if(dst > eps)
+        vectorScalarMult3D(v,sign/dst,grad);
+    else
+        vectorCopy3D(n,grad);
+    return true;
+}
+
+/* ----------------------------------------------------------------------
+   constructor, destructor
+------------------------------------------------------------------------- */
+
+PrimitiveWallDistanceField::PrimitiveWallDistanceField(LAMMPS *lmp, const char *filename,
+                           double spacing, double band, double scale, double refineAngle)
+: PrimitiveWall(lmp),
+  dx_(spacing),
+  invdx_(1./spacing),
+  band_(band),
+  scale_(scale),
+  cosRefine_(cos(refineAngle*M_PI/180.)),
+  built_(false)
+{
+    filename_ = new char[strlen(filename)+1];
+    strcpy(filename_,filename);
+
+    if(domain->triclinic)
+        error->all(FLERR,"Distance field wall can not be used with triclinic box");
+
+    vectorZeroize3D(origin_);
+    vectorZeroize3D(lo_);
+    vectorZeroize3D(hi_);
+    nBlocks_[0] = nBlocks_[1] = nBlocks_[2] = 0;
+}
+
+PrimitiveWallDistanceField::~PrimitiveWallDistanceField()
+{
+    delete []filename_;
+}
+
+/* ----------------------------------------------------------------------
+   field is built for the first run and re-built if sub-domain changed,
+   e.g. by load-balancing or by a growing box
+------------------------------------------------------------------------- */
+
+void PrimitiveWallDistanceField::preNeighbor()
+{
+    const double halfskin = 0.5*neighbor->skin;
+
+    int rebuild = built_ ? 0 : 1;
+    for(int dim = 0; dim < 3; dim++)
+    {
+        if(domain->sublo[dim] - halfskin < lo_[dim] || domain->subhi[dim] + halfskin > hi_[dim])
+            rebuild = 1;
+    }
+
+    //NP reading the file is collective
+    MPI_Max_Scalar(rebuild,world);
+    if(rebuild)
+        build();
+}
+
+/* ----------------------------------------------------------------------
+   read all triangles of the surface, 9 values per triangle
+------------------------------------------------------------------------- */
+
+void PrimitiveWallDistanceField::readTriangles(std::vector<double> &tris)
+{
+    //NP temporary mesh, only the nodes are used
+    TriMesh *mesh = new TriMesh(lmp);
+    mesh->setMeshID("distance_field");
+
+    InputMeshTri *mesh_input = new InputMeshTri(lmp,0,NULL);
+    mesh_input->meshtrifile(filename_,mesh,false,0,NULL);
+    delete mesh_input;
+
+    const int nTri = mesh->sizeLocal();
+    tris.resize(9*nTri);
+    for(int iTri = 0; iTri < nTri; iTri++)
+    {
+        for(int iNode = 0; iNode < 3; iNode++)
+        {
+            double *node = &tris[9*iTri+3*iNode];
+            mesh->node(iTri,iNode,node);
+            vectorScalarMult3D(node,scale_);
+        }
+    }
+
+    delete mesh;
+}
+
+/* ----------------------------------------------------------------------
+   build field covering sub-domain plus skin
+------------------------------------------------------------------------- */
+
+void PrimitiveWallDistanceField::build()
+{
+    std::vector<double> tris;
+    readTriangles(tris);
+    const int nTri = tris.size()/9;
+
+    // lattice covering sub-domain, anchored at the origin so that
+    // procs sample the field at identical nodes
+
+    const double margin = neighbor->skin;
+    double nTotal = 1.;
+    for(int dim = 0; dim < 3; dim++)
+    {
+        lo_[dim] = domain->sublo[dim] - margin;
+        hi_[dim] = domain->subhi[dim] + margin;
+        origin_[dim] = floor(lo_[dim]*invdx_)*dx_;
+        const int nCells = static_cast<int>(ceil((hi_[dim]-origin_[dim])*invdx_));
+        nBlocks_[dim] = nCells/BLOCK + 1;
+        nTotal *= nBlocks_[dim];
+    }
+
+    if(nTotal > 2.e9)
+        error->one(FLERR,"Distance field wall: too many blocks, increase spacing");
+
+    blockIndex_.assign(nBlocks_[0]*nBlocks_[1]*nBlocks_[2],-1);
+
+    // bin triangles to the blocks within band width
+
+    std::vector<std::vector<int> > blockTris;
+    std::vector<int> blockLo;
+    const double blockLen = BLOCK*dx_;
+
+    for(int iTri = 0; iTri < nTri; iTri++)
+    {
+        const double *tri = &tris[9*iTri];
+        int bmin[3],bmax[3];
+        bool overlap = true;
+
+        //NP one cell beyond hi_ so nodes of the outermost cells are correct
+        for(int dim = 0; dim < 3; dim++)
+        {
+            const double tmin = fmin(fmin(tri[dim],tri[3+dim]),tri[6+dim]) - band_;
+            const double tmax = fmax(fmax(tri[dim],tri[3+dim]),tri[6+dim]) + band_;
+            if(tmax < origin_[dim] || tmin > hi_[dim] + dx_)
+            {
+                overlap = false;
+                break;
+            }
+            bmin[dim] = static_cast<int>(floor((fmax(tmin,origin_[dim])-origin_[dim])/blockLen));
+            bmax[dim] = static_cast<int>(floor((fmin(tmax,hi_[dim]+dx_)-origin_[dim])/blockLen));
+            if(bmin[dim] < 0) bmin[dim] = 0;
+            if(bmax[dim] > nBlocks_[dim]-1) bmax[dim] = nBlocks_[dim]-1;
+        }
+        if(!overlap) continue;
+
+        for(int k = bmin[2]; k <= bmax[2]; k++)
+          for(int j = bmin[1]; j <= bmax[1]; j++)
+            for(int i = bmin[0]; i <= bmax[0]; i++)
+            {
+                int &iBlock = blockIndex_[i + nBlocks_[0]*(j + nBlocks_[1]*k)];
+                if(iBlock < 0)
+                {
+                    iBlock = blockTris.size();
+                    blockTris.push_back(std::vector<int>());
+                    blockLo.push_back(i*BLOCK);
+                    blockLo.push_back(j*BLOCK);
+                    blockLo.push_back(k*BLOCK);
+                }
+                blockTris[iBlock].push_back(iTri);
+            }
+    }
+
+    // sample distance and gradient per block
+    // blocks with sharp features keep their triangles for exact evaluation
+
+    const int nPayload = blockTris.size();
+    field_.assign(static_cast<size_t>(nPayload)*NODES*4,0.f);
+    refineStart_.assign(nPayload+1,0);
+    refineTris_.clear();
+    refineGeom_.clear();
+
+    std::vector<int> localTri(nTri,-1);
+    std::vector<double> nodeData(6*NODES);
+    int nRefined = 0;
+
+    for(int iBlock = 0; iBlock < nPayload; iBlock++)
+    {
+        evalBlockNodes(iBlock,&blockLo[3*iBlock],blockTris[iBlock],tris,&nodeData[0]);
+
+        float *data = &field_[static_cast<size_t>(iBlock)*NODES*4];
+        for(int iNode = 0; iNode < NODES; iNode++)
+        {
+            const double *nd = &nodeData[6*iNode];
+            data[4*iNode] = static_cast<float>(nd[0] < band_ ? nd[2] : band_);
+            data[4*iNode+1] = static_cast<float>(nd[3]);
+            data[4*iNode+2] = static_cast<float>(nd[4]);
+            data[4*iNode+3] = static_cast<float>(nd[5]);
+        }
+
+        if(isSharp(&nodeData[0]))
+        {
+            nRefined++;
+            const std::vector<int> &list = blockTris[iBlock];
+            for(size_t it = 0; it < list.size(); it++)
+            {
+                const int iTri = list[it];
+                if(localTri[iTri] < 0)
+                {
+                    localTri[iTri] = refineGeom_.size()/12;
+                    const double *tri = &tris[9*iTri];
+                    for(int m = 0; m < 9; m++)
+                        refineGeom_.push_back(tri[m]);
+                    double e1[3],e2[3],n[3];
+                    vectorSubtract3D(&tri[3],&tri[0],e1);
+                    vectorSubtract3D(&tri[6],&tri[0],e2);
+                    vectorCross3D(e1,e2,n);
+                    const double mag = vectorMag3D(n);
+                    if(mag > 0.) vectorScalarMult3D(n,1./mag);
+                    for(int m = 0; m < 3; m++)
+                        refineGeom_.push_back(n[m]);
+                }
+                refineTris_.push_back(localTri[iTri]);
+            }
+        }
+        refineStart_[iBlock+1] = refineTris_.size();
+
+        //NP triangle lists not needed any more
+        std::vector<int>().swap(blockTris[iBlock]);
+    }
+
+    built_ = true;
+
+    // output statistics
+
+    int nBlocksAll = nPayload, nRefinedAll = nRefined;
+    double mem = static_cast<double>(blockIndex_.size()*sizeof(int) + field_.size()*sizeof(float) +
+                 (refineStart_.size()+refineTris_.size())*sizeof(int) + refineGeom_.size()*sizeof(double));
+    MPI_Sum_Scalar(nBlocksAll,world);
+    MPI_Sum_Scalar(nRefinedAll,world);
+    MPI_Sum_Scalar(mem,world);
+
+    if(comm->me == 0)
+    {
+        if(screen)
+            fprintf(screen,"Distance field for '%s': %d triangles, %d blocks (%d refined), %.1f MB\n",
+                    filename_,nTri,nBlocksAll,nRefinedAll,mem/1048576.);
+        if(logfile)
+            fprintf(logfile,"Distance field for '%s': %d triangles, %d blocks (%d refined), %.1f MB\n",
+                    filename_,nTri,nBlocksAll,nRefinedAll,mem/1048576.);
+    }
+}
+
+/* ----------------------------------------------------------------------
+   distance of the nodes of a block to the triangles close to it
+   per node: unsigned distance, alignment, signed distance, gradient
+------------------------------------------------------------------------- */
+
+void PrimitiveWallDistanceField::evalBlockNodes(int iBlock, const int *blockLo,
+                        const std::vector<int> &blockTris, const std::vector<double> &tris,
+                        double *nodeData)
+{
+    const double eps = 1.e-6*dx_;
+
+    for(int iNode = 0; iNode < NODES; iNode++)
+    {
+        double *nd = &nodeData[6*iNode];
+        nd[0] = band_;
+        nd[1] = -1.;
+        nd[2] = band_;
+        nd[3] = nd[4] = nd[5] = 0.;
+    }
+
+    for(size_t it = 0; it < blockTris.size(); it++)
+    {
+        const double *tri = &tris[9*blockTris[it]];
+
+        double e1[3],e2[3],n[3];
+        vectorSubtract3D(&tri[3],&tri[0],e1);
+        vectorSubtract3D(&tri[6],&tri[0],e2);
+        vectorCross3D(e1,e2,n);
+        const double mag = vectorMag3D(n);
+        if(mag > 0.) vectorScalarMult3D(n,1./mag);
+
+        // nodes of this block within band width of the triangle's bounding box
+        int nmin[3],nmax[3];
+        for(int dim = 0; dim < 3; dim++)
+        {
+            const double tmin = fmin(fmin(tri[dim],tri[3+dim]),tri[6+dim]) - band_;
+            const double tmax = fmax(fmax(tri[dim],tri[3+dim]),tri[6+dim]) + band_;
+            nmin[dim] = static_cast<int>(ceil((tmin-origin_[dim])*invdx_)) - blockLo[dim];
+            nmax[dim] = static_cast<int>(floor((tmax-origin_[dim])*invdx_)) - blockLo[dim];
+            if(nmin[dim] < 0) nmin[dim] = 0;
+            if(nmax[dim] > BLOCK) nmax[dim] = BLOCK;
+        }
+
+        double p[3];
+        for(int k = nmin[2]; k <= nmax[2]; k++)
+          for(int j = nmin[1]; j <= nmax[1]; j++)
+            for(int i = nmin[0]; i <= nmax[0]; i++)
+            {
+                p[0] = origin_[0] + (blockLo[0]+i)*dx_;
+                p[1] = origin_[1] + (blockLo[1]+j)*dx_;
+                p[2] = origin_[2] + (blockLo[2]+k)*dx_;
+                double *nd = &nodeData[6*nodeIndex(i,j,k)];
+                closerTriangle(p,tri,n,eps,nd[0],nd[1],nd[2],&nd[3]);
+            }
+    }
+}
+
+/* ----------------------------------------------------------------------
+   true if the gradient turns by more than the refinement angle
+   between adjacent nodes within band width
+------------------------------------------------------------------------- */
+
+bool PrimitiveWallDistanceField::isSharp(const double *nodeData)
+{
+    for(int k = 0; k <= BLOCK; k++)
+      for(int j = 0; j <= BLOCK; j++)
+        for(int i = 0; i <= BLOCK; i++)
+        {
+            const double *nd = &nodeData[6*nodeIndex(i,j,k)];
+            if(nd[0] >= band_) continue;
+
+            const int neigh[3] = { i < BLOCK ? nodeIndex(i+1,j,k) : -1,
+                                   j < BLOCK ? nodeIndex(i,j+1,k) : -1,
+                                   k < BLOCK ? nodeIndex(i,j,k+1) : -1 };
+            for(int m = 0; m < 3; m++)
+            {
+                if(neigh[m] < 0) continue;
+                const double *nn = &nodeData[6*neigh[m]];
+                if(nn[0] < band_ && vectorDot3D(&nd[3],&nn[3]) < cosRefine_)
+                    return true;
+            }
+        }
+    return false;
+}
+
+/* ----------------------------------------------------------------------
+   signed distance d and its gradient at x
+   returns false if x is not within band width of the surface
+------------------------------------------------------------------------- */
+
+bool PrimitiveWallDistanceField::query(const double *x, double &d, double *grad)
+{
+    double g[3];
+    int c[3],b[3];
+    for(int dim = 0; dim < 3; dim++)
+    {
+        g[dim] = (x[dim]-origin_[dim])*invdx_;
+        if(g[dim] < 0.) return false;
+        c[dim] = static_cast<int>(g[dim]);
+        b[dim] = c[dim]/BLOCK;
+        if(b[dim] >= nBlocks_[dim]) return false;
+    }
+
+    const int iBlock = blockIndex_[b[0] + nBlocks_[0]*(b[1] + nBlocks_[1]*b[2])];
+    if(iBlock < 0) return false;
+
+    if(refineStart_[iBlock+1] > refineStart_[iBlock])
+        return queryExact(iBlock,x,d,grad);
+
+    // trilinear interpolation within cell
+
+    const int i = c[0]-b[0]*BLOCK, j = c[1]-b[1]*BLOCK, k = c[2]-b[2]*BLOCK;
+    const double fx = g[0]-c[0], fy = g[1]-c[1], fz = g[2]-c[2];
+    const float *data = &field_[static_cast<size_t>(iBlock)*NODES*4];
+
+    d = 0.;
+    vectorZeroize3D(grad);
+    for(int corner = 0; corner < 8; corner++)
+    {
+        const int di = corner & 1, dj = (corner >> 1) & 1, dk = (corner >> 2) & 1;
+        const float *nd = &data[4*nodeIndex(i+di,j+dj,k+dk)];
+
+        //NP corner outside band width, no reliable value
+        if(fabs(nd[0]) >= band_) return false;
+
+        const double w = (di ? fx : 1.-fx)*(dj ? fy : 1.-fy)*(dk ? fz : 1.-fz);
+        d += w*nd[0];
+        grad[0] += w*nd[1];
+        grad[1] += w*nd[2];
+        grad[2] += w*nd[3];
+    }
+
+    const double mag = vectorMag3D(grad);
+    if(mag < 1.e-6) return false;
+    vectorScalarMult3D(grad,1./mag);
+    return true;
+}
+
+/* ---------------------------------------------------------------------- */
+
+bool PrimitiveWallDistanceField::queryExact(int iBlock, const double *x, double &d, double *grad)
+{
+    const double eps = 1.e-6*dx_;
+    double dist = band_, align = -1.;
+    bool found = false;
+
+    for(int it = refineStart_[iBlock]; it < refineStart_[iBlock+1]; it++)
+    {
+        const double *geom = &refineGeom_[12*refineTris_[it]];
+        if(closerTriangle(x,geom,&geom[9],eps,dist,align,d,grad))
+            found = true;
+    }
+    return found && dist < band_;
+}
+
+/* ----------------------------------------------------------------------
+   interface as for analytic primitive walls
+   delta points from particle center to closest point on surface
+------------------------------------------------------------------------- */
+
+double PrimitiveWallDistanceField::resolveContact(double *x, double r, double *delta)
+{
+    double d,grad[3];
+    if(!query(x,d,grad))
+    {
+        vectorZeroize3D(delta);
+        return LARGE_DISTFIELD;
+    }
+
+    vectorScalarMult3D(grad,-d,delta);
+    return fabs(d) - r;
+}
+
+/* ---------------------------------------------------------------------- */
+
+bool PrimitiveWallDistanceField::resolveSameSide(double *x0, double *x1)
+{
+    double d0,d1,grad[3];
+    if(!query(x0,d0,grad) || !query(x1,d1,grad))
+        return true;
+    return (d0 < 0.) == (d1 < 0.);
+}
+
+/* ---------------------------------------------------------------------- */
+
+bool PrimitiveWallDistanceField::resolveNeighlist(double *x, double r, double treshold)
+{
+    double d,grad[3];
+    if(!query(x,d,grad))
+        return false;
+    return fabs(d) <= r + treshold;
+}
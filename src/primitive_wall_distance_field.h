@@ -0,0 +1,109 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_PRIMITIVE_WALL_DISTANCE_FIELD
+#define LMP_PRIMITIVE_WALL_DISTANCE_FIELD
+
+#include <math.h>
+#include <vector>
+#include "primitive_wall.h"
+
+namespace LAMMPS_NS
+{
+
+  /*
+   * class PrimitiveWallDistanceField resolves contacts with a static
+   * triangulated surface via a precomputed narrow-band signed distance field
+   *
+   * the field is sampled on a lattice of spacing dx anchored at the origin,
+   * lattice nodes are grouped into blocks of BLOCK^3 cells that are only
+   * allocated where the surface is closer than the band width. each proc
+   * holds the blocks covering its sub-domain plus skin
+   *
+   * distance and gradient are interpolated trilinearly. in blocks where
+   * the gradient turns by more than the refinement angle between adjacent
+   * nodes (edges, corners, narrow gaps) the distance is evaluated exactly
+   * from the triangles close to that block instead
+   */
+
+  class PrimitiveWallDistanceField : public PrimitiveWall
+  {
+      public:
+
+        PrimitiveWallDistanceField(LAMMPS *lmp, const char *filename,
+                                   double spacing, double band, double scale, double refineAngle);
+        virtual ~PrimitiveWallDistanceField();
+
+        virtual double resolveContact(double *x, double r, double *delta);
+        virtual bool resolveSameSide(double *x0, double *x1);
+        virtual bool resolveNeighlist(double *x, double r, double treshold);
+
+        // (re-)build field if sub-domain not covered, collective
+        virtual void preNeighbor();
+
+        // band width needed so no contact within the neighbor skin is missed
+        inline double requiredBand(double maxrad, double skin) const
+        { return maxrad + skin + sqrt(3.)*dx_; }
+
+        inline double band() const
+        { return band_; }
+
+      private:
+
+        static const int BLOCK = 8;                           // cells per block edge
+        static const int NODES = (BLOCK+1)*(BLOCK+1)*(BLOCK+1); // nodes per block
+
+        void build();
+        void readTriangles(std::vector<double> &tris);
+        void evalBlockNodes(int iBlock, const int *blockLo, const std::vector<int> &blockTris,
+                            const std::vector<double> &tris, double *nodeData);
+        bool isSharp(const double *nodeData);
+        bool query(const double *x, double &d, double *grad);
+        bool queryExact(int iBlock, const double *x, double &d, double *grad);
+
+        inline int nodeIndex(int i, int j, int k)
+        { return i + (BLOCK+1)*(j + (BLOCK+1)*k); }
+
+        char *filename_;
+        double dx_, invdx_;
+        double band_;
+        double scale_;
+        double cosRefine_;
+
+        // lattice of this proc
+        bool built_;
+        double origin_[3];
+        double lo_[3], hi_[3];                  // covered region
+        int nBlocks_[3];
+        std::vector<int> blockIndex_;           // block -> payload index, -1 if empty
+
+        // payload: signed distance and gradient per node
+        std::vector<float> field_;
+
+        // exact evaluation: triangles of block b are
+        // refineTris_[refineStart_[b]] ... refineTris_[refineStart_[b+1]-1]
+        std::vector<int> refineStart_;
+        std::vector<int> refineTris_;
+        std::vector<double> refineGeom_;       // nodes and normal, 12 values per tri
+  };
+
+} /* namespace LAMMPS_NS */
+#endif /* LMP_PRIMITIVE_WALL_DISTANCE_FIELD */
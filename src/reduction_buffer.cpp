@@ -0,0 +1,101 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#include "reduction_buffer.h"
+
+using namespace LAMMPS_NS;
+
+  /* ----------------------------------------------------------------------
+   constructor, destructor
+  ------------------------------------------------------------------------- */
+
+  ReductionBuffer::ReductionBuffer(ContainerBase *target, int nthreads)
+  : target_(target),
+    nthreads_(nthreads > 0 ? nthreads : 1),
+    len_(target->nVec()*target->lenVec()),
+    slot_(nthreads_),
+    touched_(nthreads_),
+    values_(nthreads_)
+  {
+  }
+
+  ReductionBuffer::~ReductionBuffer()
+  {
+  }
+
+  /* ----------------------------------------------------------------------
+   add contributions of all threads to the target property and clear
+   each thread adds up the contributions to its own range of elements
+  ------------------------------------------------------------------------- */
+
+  void ReductionBuffer::reduce()
+  {
+      const int n = target_->size();
+
+      #if defined(_OPENMP)
+      #pragma omp parallel
+      #endif
+      {
+          #if defined(_OPENMP)
+          const int me = omp_get_thread_num();
+          const int nth = omp_get_num_threads();
+          #else
+          const int me = 0;
+          const int nth = 1;
+          #endif
+
+          const int ifrom = static_cast<int>((static_cast<long>(n)*me)/nth);
+          const int ito = static_cast<int>((static_cast<long>(n)*(me+1))/nth);
+
+          for(int tid = 0; tid < nthreads_; tid++)
+          {
+              const std::vector<int> &touched = touched_[tid];
+              const int ntouched = touched.size();
+              for(int s = 0; s < ntouched; s++)
+              {
+                  const int i = touched[s];
+                  if(i >= ifrom && i < ito)
+                    target_->addToElement(i,&(values_[tid][s*len_]));
+              }
+          }
+      }
+
+      clear();
+  }
+
+  /* ----------------------------------------------------------------------
+   discard all contributions
+  ------------------------------------------------------------------------- */
+
+  void ReductionBuffer::clear()
+  {
+      for(int tid = 0; tid < nthreads_; tid++)
+      {
+          std::vector<int> &slot = slot_[tid];
+          const std::vector<int> &touched = touched_[tid];
+          const int ntouched = touched.size();
+          for(int s = 0; s < ntouched; s++)
+            slot[touched[s]] = -1;
+
+          touched_[tid].clear();
+          values_[tid].clear();
+      }
+  }
@@ -0,0 +1,102 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_REDUCTION_BUFFER_H
+#define LMP_REDUCTION_BUFFER_H
+
+#include <vector>
+#include "container_base.h"
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace LAMMPS_NS
+{
+  /* ----------------------------------------------------------------------
+   per-thread sparse accumulation of contributions to an element property
+
+   each thread adds to its own slots, only elements a thread touches get
+   a slot. reduce() adds all slots to the property, in thread order so
+   that the result does not depend on scheduling
+  ------------------------------------------------------------------------- */
+
+  class ReductionBuffer
+  {
+      public:
+
+        ReductionBuffer(ContainerBase *target, int nthreads);
+        ~ReductionBuffer();
+
+        // zero-initialized slot of element i for thread tid
+        //NP pointer is valid until the next call by the same thread
+        inline double* get(int tid, int i);
+
+        void reduce();
+        void clear();
+
+        inline ContainerBase* target()
+        { return target_; }
+
+        inline int nThreads()
+        { return nthreads_; }
+
+        // thread id within a parallel region, 0 otherwise
+        static inline int threadNum()
+        {
+            #if defined(_OPENMP)
+            return omp_get_thread_num();
+            #else
+            return 0;
+            #endif
+        }
+
+      private:
+
+        ContainerBase *target_;
+        int nthreads_;
+        int len_;                           // # values per element
+
+        std::vector<std::vector<int> > slot_;       // per thread: element -> slot, -1 if none
+        std::vector<std::vector<int> > touched_;    // per thread: element of each slot
+        std::vector<std::vector<double> > values_;  // per thread: len_ values per slot
+  };
+
+  /* ---------------------------------------------------------------------- */
+
+  inline double* ReductionBuffer::get(int tid, int i)
+  {
+      std::vector<int> &slot = slot_[tid];
+      if(i >= static_cast<int>(slot.size()))
+        slot.resize(i < target_->size() ? target_->size() : i+1,-1);
+
+      int s = slot[i];
+      if(s < 0)
+      {
+          s = slot[i] = touched_[tid].size();
+          touched_[tid].push_back(i);
+          values_[tid].resize(values_[tid].size()+len_,0.);
+      }
+      return &(values_[tid][s*len_]);
+  }
+
+} /* LAMMPS_NS */
+#endif /* LMP_REDUCTION_BUFFER_H */
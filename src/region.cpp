@@ -32,6 +32,7 @@
 #include "variable.h"
 #include "error.h"
 #include "force.h"
+#include "memory.h"
 #include "random_park.h"
 #include "vector_liggghts.h" //NP modified C.K.
 #include "mpi_liggghts.h"  //NP modified C.K.
@@ -61,6 +62,10 @@ Region::Region(LAMMPS *lmp, int narg, char **arg) : Pointers(lmp)
   lastshape = lastdynamic = -1;
 
   random = NULL; //NP modified C.K.
+
+  nbatch = 0;
+  xbatch = NULL;
+  ibatch = fbatch = NULL;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -76,6 +81,10 @@ Region::~Region()
   delete [] tstr;
 
   delete random;
+
+  memory->sfree(xbatch);
+  memory->destroy(ibatch);
+  memory->destroy(fbatch);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -211,6 +220,110 @@ int Region::surface(double x, double y, double z, double cutoff)
   return ncontact;
 }
 
+/* ----------------------------------------------------------------------
+   match() for first n points of x in one call
+   primitive regions test all points in one loop without virtual calls
+   dynamic regions are transformed point by point via match()
+------------------------------------------------------------------------- */
+
+void Region::match_batch(int n, double **x, int *flag)
+{
+  if (dynamic) {
+    for (int i = 0; i < n; i++)
+      flag[i] = match(x[i][0],x[i][1],x[i][2]);
+    return;
+  }
+
+  if (varshape && update->ntimestep != lastshape) {
+    shape_update();
+    lastshape = update->ntimestep;
+  }
+
+  inside_batch(n,x,flag);
+  if (!interior)
+    for (int i = 0; i < n; i++) flag[i] = !flag[i];
+}
+
+/* ----------------------------------------------------------------------
+   distance to closest contact within cutoff for first n points of x
+   dist = -1.0 if surface() would find no contact
+------------------------------------------------------------------------- */
+
+void Region::surface_batch(int n, double **x, double cutoff, double *dist)
+{
+  if (dynamic) {
+    for (int i = 0; i < n; i++) {
+      const int ncontact = surface(x[i][0],x[i][1],x[i][2],cutoff);
+      dist[i] = -1.0;
+      for (int m = 0; m < ncontact; m++)
+        if (dist[i] < 0.0 || contact[m].r < dist[i]) dist[i] = contact[m].r;
+    }
+    return;
+  }
+
+  if (varshape && update->ntimestep != lastshape) {
+    shape_update();
+    lastshape = update->ntimestep;
+  }
+
+  if (interior) surface_interior_batch(n,x,cutoff,dist);
+  else surface_exterior_batch(n,x,cutoff,dist);
+}
+
+/* ----------------------------------------------------------------------
+   default batched queries, regions override them with loops that
+   the compiler can vectorize
+------------------------------------------------------------------------- */
+
+void Region::inside_batch(int n, double **x, int *flag)
+{
+  for (int i = 0; i < n; i++)
+    flag[i] = inside(x[i][0],x[i][1],x[i][2]);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Region::surface_interior_batch(int n, double **x, double cutoff, double *dist)
+{
+  double xnear[3];
+
+  for (int i = 0; i < n; i++) {
+    vectorCopy3D(x[i],xnear);
+    const int ncontact = surface_interior(xnear,cutoff);
+    dist[i] = -1.0;
+    for (int m = 0; m < ncontact; m++)
+      if (dist[i] < 0.0 || contact[m].r < dist[i]) dist[i] = contact[m].r;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Region::surface_exterior_batch(int n, double **x, double cutoff, double *dist)
+{
+  double xnear[3];
+
+  for (int i = 0; i < n; i++) {
+    vectorCopy3D(x[i],xnear);
+    const int ncontact = surface_exterior(xnear,cutoff);
+    dist[i] = -1.0;
+    for (int m = 0; m < ncontact; m++)
+      if (dist[i] < 0.0 || contact[m].r < dist[i]) dist[i] = contact[m].r;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   grow scratch used to pass a subset of points to sub-regions
+------------------------------------------------------------------------- */
+
+void Region::grow_batch(int n)
+{
+  if (n <= nbatch) return;
+  nbatch = n;
+  xbatch = (double **) memory->srealloc(xbatch,nbatch*sizeof(double *),"region:xbatch");
+  memory->grow(ibatch,nbatch,"region:ibatch");
+  memory->grow(fbatch,nbatch,"region:fbatch");
+}
+
 /* ----------------------------------------------------------------------
    add a single contact at Nth location in contact array
    x = particle position
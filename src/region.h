@@ -66,6 +66,12 @@ class Region : protected Pointers {
   int match(double, double, double);
   int surface(double, double, double, double);
 
+  // batched versions for first n points of x
+  // flag[i] = match() of x[i]
+  // dist[i] = distance of x[i] to closest contact, -1.0 if no contact
+  void match_batch(int n, double **x, int *flag);
+  void surface_batch(int n, double **x, double cutoff, double *dist);
+
   //NP modified C.K. begin
 
   // reset random gen - is called out of restart by fix that uses region
@@ -104,15 +110,34 @@ class Region : protected Pointers {
   virtual int inside(double, double, double) = 0;
   virtual int surface_interior(double *, double) = 0;
   virtual int surface_exterior(double *, double) = 0;
+  virtual void inside_batch(int, double **, int *);
+  virtual void surface_interior_batch(int, double **, double, double *);
+  virtual void surface_exterior_batch(int, double **, double, double *);
   virtual void shape_update() {}
   virtual void pretransform();
 
   void transformed_extents(double *,double *);
 
+  // 1 if x may match region, 0 if it is safely outside
+  // used by union/intersect to skip sub-regions
+  int extent_cull(const double *x)
+  {
+    if (!bboxflag || !interior || varshape) return 1;
+    return x[0] >= extent_xlo && x[0] <= extent_xhi &&
+           x[1] >= extent_ylo && x[1] <= extent_yhi &&
+           x[2] >= extent_zlo && x[2] <= extent_zhi;
+  }
+
  protected:
   void add_contact(int, double *, double, double, double);
   void options(int, char **);
 
+  // scratch for passing subsets of points to sub-regions
+  int nbatch;
+  double **xbatch;
+  int *ibatch,*fbatch;
+  void grow_batch(int);
+
   //NP modified C.K.
   int seed;
   class RanPark *random;
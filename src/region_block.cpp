@@ -11,6 +11,7 @@
    See the README file in the top-level LAMMPS directory.
 ------------------------------------------------------------------------- */
 
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 #include "region_block.h"
@@ -118,6 +119,63 @@ int RegBlock::inside(double x, double y, double z)
   return 0;
 }
 
+/* ----------------------------------------------------------------------
+   inside() for n points, loop without branches
+------------------------------------------------------------------------- */
+
+void RegBlock::inside_batch(int n, double **x, int *flag)
+{
+  for (int i = 0; i < n; i++) {
+    const double *xi = x[i];
+    flag[i] = (xi[0] >= xlo) & (xi[0] <= xhi) & (xi[1] >= ylo) &
+              (xi[1] <= yhi) & (xi[2] >= zlo) & (xi[2] <= zhi);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   distance to closest inner face for n points, -1.0 if no contact
+   closest face is the closest contact of surface_interior()
+------------------------------------------------------------------------- */
+
+void RegBlock::surface_interior_batch(int n, double **x, double cutoff, double *dist)
+{
+  for (int i = 0; i < n; i++) {
+    const double *xi = x[i];
+    const int in = (xi[0] >= xlo) & (xi[0] <= xhi) & (xi[1] >= ylo) &
+                   (xi[1] <= yhi) & (xi[2] >= zlo) & (xi[2] <= zhi);
+
+    double delta = MIN(xi[0]-xlo,xhi-xi[0]);
+    delta = MIN(delta,MIN(xi[1]-ylo,yhi-xi[1]));
+    delta = MIN(delta,MIN(xi[2]-zlo,zhi-xi[2]));
+
+    dist[i] = (in && delta < cutoff) ? delta : -1.0;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   distance to outer surface for n points, -1.0 if no contact
+   same tests as surface_exterior()
+------------------------------------------------------------------------- */
+
+void RegBlock::surface_exterior_batch(int n, double **x, double cutoff, double *dist)
+{
+  for (int i = 0; i < n; i++) {
+    const double *xi = x[i];
+    const int far = (xi[0] <= xlo-cutoff) | (xi[0] >= xhi+cutoff) |
+                    (xi[1] <= ylo-cutoff) | (xi[1] >= yhi+cutoff) |
+                    (xi[2] <= zlo-cutoff) | (xi[2] >= zhi+cutoff);
+    const int in = (xi[0] > xlo) & (xi[0] < xhi) & (xi[1] > ylo) &
+                   (xi[1] < yhi) & (xi[2] > zlo) & (xi[2] < zhi);
+
+    const double delx = xi[0] - MIN(MAX(xi[0],xlo),xhi);
+    const double dely = xi[1] - MIN(MAX(xi[1],ylo),yhi);
+    const double delz = xi[2] - MIN(MAX(xi[2],zlo),zhi);
+    const double r = sqrt(delx*delx + dely*dely + delz*delz);
+
+    dist[i] = (!far && !in && r < cutoff) ? r : -1.0;
+  }
+}
+
 /* ----------------------------------------------------------------------
    contact if 0 <= x < cutoff from one or more inner surfaces of block
    can be one contact for each of 6 faces
@@ -33,6 +33,9 @@ class RegBlock : public Region {
   int inside(double, double, double);
   int surface_interior(double *, double);
   int surface_exterior(double *, double);
+  void inside_batch(int, double **, int *);
+  void surface_interior_batch(int, double **, double, double *);
+  void surface_exterior_batch(int, double **, double, double *);
 
  private:
   double xlo,xhi,ylo,yhi,zlo,zhi;
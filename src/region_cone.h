@@ -31,6 +31,7 @@ class RegCone : public Region {
   int inside(double, double, double);
   int surface_interior(double *, double);
   int surface_exterior(double *, double);
+  void inside_batch(int, double **, int *);
 
  private:
   char axis;
@@ -204,6 +204,25 @@ int RegCylinder::inside(double x, double y, double z)
   return inside;
 }
 
+/* ----------------------------------------------------------------------
+   inside() for n points
+   axis is resolved once, loop over points has no branches
+------------------------------------------------------------------------- */
+
+void RegCylinder::inside_batch(int n, double **x, int *flag)
+{
+  const int ia = (axis == 'x') ? 0 : ((axis == 'y') ? 1 : 2);
+  const int i1 = (axis == 'x') ? 1 : 0;
+  const int i2 = (axis == 'z') ? 1 : 2;
+
+  for (int i = 0; i < n; i++) {
+    const double del1 = x[i][i1] - c1;
+    const double del2 = x[i][i2] - c2;
+    const double xa = x[i][ia];
+    flag[i] = (sqrt(del1*del1 + del2*del2) <= radius) & (xa >= lo) & (xa <= hi);
+  }
+}
+
 /* ----------------------------------------------------------------------
    contact if 0 <= x < cutoff from one or more inner surfaces of cylinder
    can be one contact for each of 3 cylinder surfaces
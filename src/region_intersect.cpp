@@ -157,6 +157,40 @@ int RegIntersect::inside(double x, double y, double z)
   return 0;
 }
 
+/* ----------------------------------------------------------------------
+   inside() for n points
+   points outside the bounding box of a sub-region are dropped without
+   querying it, each sub-region gets the remaining points in one call
+------------------------------------------------------------------------- */
+
+void RegIntersect::inside_batch(int n, double **x, int *flag)
+{
+  Region **regions = domain->regions;
+  grow_batch(n);
+
+  for (int i = 0; i < n; i++) flag[i] = 1;
+
+  for (int ilist = 0; ilist < nregion; ilist++) {
+    Region *sub = regions[list[ilist]];
+
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+      if (!flag[i]) continue;
+      if (!sub->extent_cull(x[i])) {
+        flag[i] = 0;
+        continue;
+      }
+      ibatch[m] = i;
+      xbatch[m++] = x[i];
+    }
+    if (m == 0) break;
+
+    sub->inside_batch(m,xbatch,fbatch);
+    for (int k = 0; k < m; k++)
+      if (fbatch[k] ^ sub->interior) flag[ibatch[k]] = 0;
+  }
+}
+
 /* ----------------------------------------------------------------------
    compute contacts with interior of intersection of sub-regions
    (1) compute contacts in each sub-region
@@ -209,6 +209,43 @@ int RegTetMesh::inside(double x, double y, double z)
   return tree_is_inside(pos);
 }
 
+/* ----------------------------------------------------------------------
+   inside() for n points
+   walks the search tree once for all points instead of once per point
+------------------------------------------------------------------------- */
+
+void RegTetMesh::inside_batch(int n, double **x, int *flag)
+{
+  grow_batch(n);
+
+  int m = 0;
+  for (int i = 0; i < n; i++) {
+    flag[i] = 0;
+    if(!domain->is_in_subdomain(x[i])) continue;
+    if(bboxflag &&
+       (x[i][0] < extent_xlo || x[i][0] > extent_xhi ||
+        x[i][1] < extent_ylo || x[i][1] > extent_yhi ||
+        x[i][2] < extent_zlo || x[i][2] > extent_zhi)) continue;
+    ibatch[m] = i;
+    xbatch[m] = x[i];
+    fbatch[m] = 0;
+    m++;
+  }
+  if(m == 0 || tree_size() == 0) return;
+
+  //NP root candidates are all points, one list per tree level below
+  if(static_cast<int>(tree_batch.size()) < tree_max_depth+2)
+    tree_batch.resize(tree_max_depth+2);
+  std::vector<int> &root = tree_batch[0];
+  root.resize(m);
+  for (int k = 0; k < m; k++) root[k] = k;
+
+  tree_inside_batch(0,1,&root[0],m);
+
+  for (int k = 0; k < m; k++)
+    flag[ibatch[k]] = fbatch[k];
+}
+
 /* ---------------------------------------------------------------------- */
 
 int RegTetMesh::surface_interior(double *x, double cutoff)
@@ -635,6 +672,40 @@ bool RegTetMesh::tree_is_inside(double *x)
   return false;
 }
 
+/* ----------------------------------------------------------------------
+   keep candidates within bbox of tree node, test them against the tets
+   of a leaf tet by tet, or pass them on to both children
+   points of xbatch found inside a tet are flagged in fbatch
+------------------------------------------------------------------------- */
+
+void RegTetMesh::tree_inside_batch(int node, int level, const int *cand, int ncand)
+{
+  if(tree_data[node].empty()) return;
+
+  std::vector<int> &sub = tree_batch[level];
+  sub.clear();
+  for (int k = 0; k < ncand; k++)
+    if(!fbatch[cand[k]] && tree_key[node].isInside(xbatch[cand[k]]))
+      sub.push_back(cand[k]);
+
+  const int nsub = sub.size();
+  if(nsub == 0) return;
+
+  if(tree_is_leaf(node)) {
+    TreeBin const &data = tree_data[node];
+    for(TreeBin::const_iterator it = data.begin(); it != data.end(); ++it)
+      for (int k = 0; k < nsub; k++)
+        if(!fbatch[sub[k]] && is_inside_tet(*it,xbatch[sub[k]]))
+          fbatch[sub[k]] = 1;
+    return;
+  }
+
+  const int index_left = tree_left(node);
+  const int index_right = tree_right(node);
+  if(index_left < tree_size()) tree_inside_batch(index_left,level+1,&sub[0],nsub);
+  if(index_right < tree_size()) tree_inside_batch(index_right,level+1,&sub[0],nsub);
+}
+
 bool RegTetMesh::tree_is_inside_bin(double *x, TreeBin const &data)
 {
   if(data.empty())
@@ -47,6 +47,7 @@ class RegTetMesh : public Region {
   int inside(double, double, double);
   int surface_interior(double *, double);
   int surface_exterior(double *, double);
+  void inside_batch(int, double **, int *);
   void rebuild();
 
   void add_tet(double **n);
@@ -116,6 +117,10 @@ class RegTetMesh : public Region {
   bool tree_is_inside(double *x);
   int tree_is_inside(double *x, double r);
 
+  // batched point location, candidates are filtered level by level
+  std::vector< std::vector<int> > tree_batch;
+  void tree_inside_batch(int node, int level, const int *cand, int ncand);
+
   int tree_left(int const i) {return 2*i+1;}
   int tree_right(int const i) {return 2*i+2;}
   int tree_parent(int const i) {return (i-1)/2;}
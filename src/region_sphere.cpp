@@ -159,6 +159,60 @@ int RegSphere::surface_exterior(double *x, double cutoff)
   return 0;
 }
 
+/* ----------------------------------------------------------------------
+   inside() for n points, loop without branches
+------------------------------------------------------------------------- */
+
+void RegSphere::inside_batch(int n, double **x, int *flag)
+{
+  const double radsq = radius*radius;
+
+  for (int i = 0; i < n; i++) {
+    const double delx = x[i][0] - xc;
+    const double dely = x[i][1] - yc;
+    const double delz = x[i][2] - zc;
+    flag[i] = (delx*delx + dely*dely + delz*delz) <= radsq;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   distance to inner surface for n points, -1.0 if no contact
+   same tests as surface_interior()
+------------------------------------------------------------------------- */
+
+void RegSphere::surface_interior_batch(int n, double **x, double cutoff, double *dist)
+{
+  const double radsq = radius*radius;
+
+  for (int i = 0; i < n; i++) {
+    const double delx = x[i][0] - xc;
+    const double dely = x[i][1] - yc;
+    const double delz = x[i][2] - zc;
+    const double rsq = delx*delx + dely*dely + delz*delz;
+    const double delta = radius - sqrt(rsq);
+    dist[i] = (rsq <= radsq && rsq != 0.0 && delta < cutoff) ? delta : -1.0;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   distance to outer surface for n points, -1.0 if no contact
+   same tests as surface_exterior()
+------------------------------------------------------------------------- */
+
+void RegSphere::surface_exterior_batch(int n, double **x, double cutoff, double *dist)
+{
+  const double radsq = radius*radius;
+
+  for (int i = 0; i < n; i++) {
+    const double delx = x[i][0] - xc;
+    const double dely = x[i][1] - yc;
+    const double delz = x[i][2] - zc;
+    const double rsq = delx*delx + dely*dely + delz*delz;
+    const double delta = sqrt(rsq) - radius;
+    dist[i] = (rsq >= radsq && delta < cutoff) ? delta : -1.0;
+  }
+}
+
 /* ----------------------------------------------------------------------
    change region shape via variable evaluation
 ------------------------------------------------------------------------- */
@@ -32,6 +32,9 @@ class RegSphere : public Region {
   int inside(double, double, double);
   int surface_interior(double *, double);
   int surface_exterior(double *, double);
+  void inside_batch(int, double **, int *);
+  void surface_interior_batch(int, double **, double, double *);
+  void surface_exterior_batch(int, double **, double, double *);
   void shape_update();
 
  private:
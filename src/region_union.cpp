@@ -147,6 +147,36 @@ int RegUnion::inside(double x, double y, double z)
   return 1;
 }
 
+/* ----------------------------------------------------------------------
+   inside() for n points
+   each sub-region only gets the points not matched so far which lie
+   within its bounding box, in one batched call
+------------------------------------------------------------------------- */
+
+void RegUnion::inside_batch(int n, double **x, int *flag)
+{
+  Region **regions = domain->regions;
+  grow_batch(n);
+
+  for (int i = 0; i < n; i++) flag[i] = 0;
+
+  for (int ilist = 0; ilist < nregion; ilist++) {
+    Region *sub = regions[list[ilist]];
+
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+      if (flag[i] || !sub->extent_cull(x[i])) continue;
+      ibatch[m] = i;
+      xbatch[m++] = x[i];
+    }
+    if (m == 0) continue;
+
+    sub->inside_batch(m,xbatch,fbatch);
+    for (int k = 0; k < m; k++)
+      if (!(fbatch[k] ^ sub->interior)) flag[ibatch[k]] = 1;
+  }
+}
+
 /* ----------------------------------------------------------------------
    compute contacts with interior of union of sub-regions
    (1) compute contacts in each sub-region
@@ -32,6 +32,7 @@ class RegUnion : public Region {
   int inside(double, double, double);
   int surface_interior(double *, double);
   int surface_exterior(double *, double);
+  void inside_batch(int, double **, int *);
   void shape_update();
   void pretransform();
 
@@ -39,6 +39,7 @@
 #include "error.h"
 
 using namespace LAMMPS_NS;
+using namespace FixConst;
 
 /* ---------------------------------------------------------------------- */
 
@@ -253,17 +254,31 @@ void Respa::init()
   // create fix needed for storing atom-based respa level forces
   // will delete it at end of run
 
-  char **fixarg = new char*[4];
+  // granular styles need torque at each level as well
+
+  char **fixarg = new char*[5];
   fixarg[0] = (char *) "RESPA";
   fixarg[1] = (char *) "all";
   fixarg[2] = (char *) "RESPA";
   fixarg[3] = new char[8];
   sprintf(fixarg[3],"%d",nlevels);
-  modify->add_fix(4,fixarg);
+  fixarg[4] = (char *) "torque";
+  modify->add_fix(atom->torque_flag ? 5 : 4,fixarg);
   delete [] fixarg[3];
   delete [] fixarg;
   fix_respa = (FixRespa *) modify->fix[modify->nfix-1];
 
+  // time integration at the outermost level only would see the
+  //   forces of the outermost level only
+
+  for (int i = 0; i < modify->nfix; i++)
+    if (modify->fix[i]->time_integrate &&
+        !(modify->fmask[i] & (INITIAL_INTEGRATE_RESPA | FINAL_INTEGRATE_RESPA))) {
+      char str[128];
+      sprintf(str,"Fix %s does not support run_style respa",modify->fix[i]->style);
+      error->all(FLERR,str);
+    }
+
   // insure respa inner/middle/outer is using Pair class that supports it
 
   if (level_inner >= 0)
@@ -357,6 +372,11 @@ void Respa::setup()
 
   ev_set(update->ntimestep);
 
+  // fixes without rRESPA support are set up before all levels,
+  //   e.g. neighbor lists of mesh walls evaluated at inner levels
+
+  modify->setup_pre_force_outer(vflag);
+
   for (int ilevel = 0; ilevel < nlevels; ilevel++) {
     force_clear(newton[ilevel]);
     modify->setup_pre_force_respa(vflag,ilevel);
@@ -425,6 +445,11 @@ void Respa::setup_minimal(int flag)
 
   ev_set(update->ntimestep);
 
+  // fixes without rRESPA support are set up before all levels,
+  //   e.g. neighbor lists of mesh walls evaluated at inner levels
+
+  modify->setup_pre_force_outer(vflag);
+
   for (int ilevel = 0; ilevel < nlevels; ilevel++) {
     force_clear(newton[ilevel]);
     modify->setup_pre_force_respa(vflag,ilevel);
@@ -508,13 +533,23 @@ void Respa::reset_dt()
 
 void Respa::recurse(int ilevel)
 {
+  // history-dependent contact and bond models integrate over update->dt,
+  //   so it is the step of the level they are evaluated at
+
+  const double dt_saved = update->dt;
+  update->dt = step[ilevel];
+
   copy_flevel_f(ilevel);
 
   for (int iloop = 0; iloop < loop[ilevel]; iloop++) {
 
     modify->initial_integrate_respa(vflag,ilevel,iloop);
+    if (ilevel == nlevels-1 && modify->n_initial_integrate_outer)
+      modify->initial_integrate_outer(vflag);
     if (modify->n_post_integrate_respa)
       modify->post_integrate_respa(ilevel,iloop);
+    if (ilevel == nlevels-1 && modify->n_post_integrate_outer)
+      modify->post_integrate_outer();
 
     if (ilevel) recurse(ilevel-1);
 
@@ -563,6 +598,8 @@ void Respa::recurse(int ilevel)
     force_clear(newton[ilevel]);
     if (modify->n_pre_force_respa)
       modify->pre_force_respa(vflag,ilevel,iloop);
+    if (ilevel == nlevels-1 && modify->n_pre_force_outer)
+      modify->pre_force_outer(vflag);
 
     timer->stamp();
     if (level_pair == ilevel && pair_compute_flag) {
@@ -609,10 +646,15 @@ void Respa::recurse(int ilevel)
 
     if (modify->n_post_force_respa)
       modify->post_force_respa(vflag,ilevel,iloop);
+    if (ilevel == nlevels-1 && modify->n_post_force_outer)
+      modify->post_force_outer(vflag);
     modify->final_integrate_respa(ilevel,iloop);
+    if (ilevel == nlevels-1 && modify->n_final_integrate_outer)
+      modify->final_integrate_outer();
   }
 
   copy_f_flevel(ilevel);
+  update->dt = dt_saved;
 }
 
 /* ----------------------------------------------------------------------
@@ -656,6 +698,17 @@ void Respa::copy_f_flevel(int ilevel)
     f_level[i][ilevel][1] = f[i][1];
     f_level[i][ilevel][2] = f[i][2];
   }
+
+  if (!fix_respa->store_torque) return;
+
+  double ***t_level = fix_respa->t_level;
+  double **torque = atom->torque;
+
+  for (int i = 0; i < n; i++) {
+    t_level[i][ilevel][0] = torque[i][0];
+    t_level[i][ilevel][1] = torque[i][1];
+    t_level[i][ilevel][2] = torque[i][2];
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -673,6 +726,17 @@ void Respa::copy_flevel_f(int ilevel)
     f[i][1] = f_level[i][ilevel][1];
     f[i][2] = f_level[i][ilevel][2];
   }
+
+  if (!fix_respa->store_torque) return;
+
+  double ***t_level = fix_respa->t_level;
+  double **torque = atom->torque;
+
+  for (int i = 0; i < n; i++) {
+    torque[i][0] = t_level[i][ilevel][0];
+    torque[i][1] = t_level[i][ilevel][1];
+    torque[i][2] = t_level[i][ilevel][2];
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -694,4 +758,17 @@ void Respa::sum_flevel_f()
       f[i][2] += f_level[i][ilevel][2];
     }
   }
+
+  if (!fix_respa->store_torque) return;
+
+  double ***t_level = fix_respa->t_level;
+  double **torque = atom->torque;
+
+  for (int ilevel = 1; ilevel < nlevels; ilevel++) {
+    for (int i = 0; i < n; i++) {
+      torque[i][0] += t_level[i][ilevel][0];
+      torque[i][1] += t_level[i][ilevel][1];
+      torque[i][2] += t_level[i][ilevel][2];
+    }
+  }
 }
@@ -36,8 +36,33 @@ namespace SPH_KERNEL_NS {
   inline double sph_kernel(int id,double s,double h,double hinv);
   inline double sph_kernel_der(int id,double s,double h,double hinv);
   inline double sph_kernel_cut(int id);
+
+  // kernel resolved at compile time, specialized below for each kernel
+  template<int KERNEL> struct SPHKernelStatic;
 }
 
+/* ----------------------------------------------------------------------
+   SPHKernelStatic<kernel_id> calls the kernel functions directly
+   loops templated on the kernel id get the kernel inlined instead of
+   comparing the id for every pair as sph_kernel() does
+------------------------------------------------------------------------- */
+
+#define SPH_KERNEL_CLASS
+#define SPHKernel(kernel_id,kernelstyle,SPHKernelCalculation,SPHKernelCalculationDer,SPHKernelCalculationCut) \
+namespace SPH_KERNEL_NS { \
+  template<> struct SPHKernelStatic<kernel_id> { \
+    static inline double value(double s,double h,double hinv) \
+    { return SPHKernelCalculation(s,h,hinv); } \
+    static inline double der(double s,double h,double hinv) \
+    { return SPHKernelCalculationDer(s,h,hinv); } \
+    static inline double cut() \
+    { return SPHKernelCalculationCut(); } \
+  }; \
+}
+#include "style_sph_kernel.h"
+#undef SPH_KERNEL_CLASS
+#undef SPHKernel
+
 /* ---------------------------------------------------------------------- */
 
 inline int SPH_KERNEL_NS::sph_kernels_unique_id()
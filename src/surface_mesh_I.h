@@ -78,6 +78,13 @@ SurfaceMesh<NUM_NODES,NUM_NEIGH_MAX>::SurfaceMesh(LAMMPS *lmp)
     areaMesh_.add(0.);
     areaMesh_.add(0.);
     areaMesh_.add(0.);
+
+    //NP neigh topology is created once and never changed
+    nNeighs_.setConstant();
+    neighFaces_.setConstant();
+    hasNonCoplanarSharedNode_.setConstant();
+    edgeActive_.setConstant();
+    cornerActive_.setConstant();
     /*NL*///this->error->all(FLERR,"check: use ID instead of index for neigh list, areCoplanar etc");
 }
 
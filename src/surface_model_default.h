@@ -50,6 +50,7 @@ namespace ContactModels
     }
 
     inline void registerSettings(Settings&) {}
+    inline void postSettings() {}
     inline void connectToProperties(PropertyRegistry&) {}
 
     inline bool checkSurfaceIntersect(CollisionData & cdata)
@@ -59,6 +59,7 @@ namespace ContactModels
     }
 
     inline void registerSettings(Settings&) {}
+    inline void postSettings() {}
 
     inline void connectToProperties(PropertyRegistry &)
     {
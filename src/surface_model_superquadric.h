@@ -55,8 +55,11 @@ namespace ContactModels
     int inequality_start_offset;
     int particles_were_in_contact_offset;
     int contact_point_offset;
+    int contact_point_flag_offset;
     int alpha1_offset;
     int alpha2_offset;
+    int motion_offset;
+    IContactHistorySetup * hsetup_;
     Superquadric particle_i;
     Superquadric particle_j;
     enum {SURFACES_FAR, SURFACES_CLOSE, SURFACES_INTERSECT};
@@ -65,7 +68,9 @@ namespace ContactModels
     static const int MASK = CM_COLLISION;
 
     SurfaceModel(LAMMPS * lmp, IContactHistorySetup* hsetup) :
-        Pointers(lmp)
+        Pointers(lmp),
+        motion_offset(-1),
+        hsetup_(hsetup)
     {
       if(!atom->superquadric_flag)
         error->one(FLERR,"Applying surface model superquadric to a non-superquadric particle!");
@@ -77,6 +82,7 @@ namespace ContactModels
       hsetup->add_history_value("cpz", "0");
       alpha1_offset = hsetup->add_history_value("a1", "0");
       alpha2_offset = hsetup->add_history_value("a2", "0");
+      contact_point_flag_offset = hsetup->add_history_value("cpflag", "0");
     }
 
     inline void registerSettings(Settings& settings)
@@ -84,14 +90,27 @@ namespace ContactModels
       settings.registerDoubleSetting("curvatureLimitFactor",curvatureLimitFactor, 0.0);
       settings.registerYesNo("meanCurvature", meanCurvature, false);
       settings.registerYesNo("gaussianCurvature", gaussianCurvature, false);
+      settings.registerDoubleSetting("contactPointTolerance", contactPointTolerance, 1e-10);
+      settings.registerDoubleSetting("contactPointReuseFactor", contactPointReuseFactor, 0.0);
       if(curvatureLimitFactor < 0.0)
         error->one(FLERR,"Curvature limiter cannot be negative!");
+      if(contactPointTolerance <= 0.0)
+        error->one(FLERR,"contactPointTolerance must be positive!");
+      if(contactPointReuseFactor < 0.0)
+        error->one(FLERR,"contactPointReuseFactor cannot be negative!");
       if(!meanCurvature && !gaussianCurvature)
         curvatureLimitFactor = 0.0;
       if(meanCurvature && gaussianCurvature)
         error->one(FLERR,"meanCurvature and gaussianCurvature cannot be simultaneously yes !");
     }
 
+    inline void postSettings()
+    {
+      // accumulated motion is only tracked if contact points may be reused
+      if(contactPointReuseFactor > 0.0 && motion_offset < 0)
+        motion_offset = hsetup_->add_history_value("cpmotion", "0");
+    }
+
     inline void connectToProperties(PropertyRegistry&) {}
 
     inline bool checkSurfaceIntersect(CollisionData & cdata)
@@ -99,6 +118,7 @@ namespace ContactModels
       cdata.is_non_spherical = true;
       bool particles_in_contact = false;
       double *const prev_step_point = &cdata.contact_history[contact_point_offset]; //contact points
+      double *const prev_step_point_flag = &cdata.contact_history[contact_point_flag_offset]; //1 if contact point was stored
       double *const inequality_start = &cdata.contact_history[inequality_start_offset];
       double *const particles_were_in_contact = &cdata.contact_history[particles_were_in_contact_offset];
 
@@ -123,11 +143,42 @@ namespace ContactModels
         const double rj = cbrt(particle_j.shape[0]*particle_j.shape[1]*particle_j.shape[2]);
         double ratio = ri / (ri + rj);
 
-        if(*particles_were_in_contact == SURFACES_FAR)
-          MathExtraLiggghtsNonspherical::calc_contact_point_if_no_previous_point_avaialable(cdata, &particle_i, &particle_j, cdata.contact_point, fi, fj, this->error);
-        else
-          MathExtraLiggghtsNonspherical::calc_contact_point_using_prev_step(cdata, &particle_i, &particle_j, ratio, update->dt, prev_step_point, cdata.contact_point, fi, fj, this->error);
+        double *const motion = motion_offset >= 0 ? &cdata.contact_history[motion_offset] : NULL;
+        bool solved = false;
+
+        if(*particles_were_in_contact != SURFACES_FAR && motion) {
+          // accumulated relative motion since the last solution; if it is small compared to
+          // the particle size, the previous contact point is only moved and not iterated
+          double dv[3];
+          vectorSubtract3D(cdata.v_i, cdata.v_j, dv);
+          *motion += (vectorMag3D(dv) + vectorMag3D(cdata.omega_i)*cdata.radi + vectorMag3D(cdata.omega_j)*cdata.radj)*update->dt;
+          const double size = std::min(MathExtraLiggghts::min(particle_i.shape[0],particle_i.shape[1],particle_i.shape[2]),
+                                       MathExtraLiggghts::min(particle_j.shape[0],particle_j.shape[1],particle_j.shape[2]));
+          if(*motion < contactPointReuseFactor*size) {
+            MathExtraLiggghtsNonspherical::estimate_contact_point_using_prev_step(cdata, &particle_i, &particle_j, update->dt, prev_step_point, cdata.contact_point);
+            MathExtraLiggghtsNonspherical::contact_point_props(&particle_i, &particle_j, cdata.contact_point, fi, fj);
+            solved = true;
+          }
+        }
+
+        if(!solved) {
+          if(*particles_were_in_contact == SURFACES_FAR) {
+            // a pair re-entering the OBB check still holds its last contact point,
+            // only fall back to the continuation from spheres if warm start does not converge
+            bool fail = true;
+            if(*prev_step_point_flag > 0.5) {
+              double merit = 1.0;
+              fail = MathExtraLiggghtsNonspherical::calc_contact_point_using_prev_step(cdata, &particle_i, &particle_j, ratio, update->dt, prev_step_point, cdata.contact_point, fi, fj, this->error, contactPointTolerance, &merit);
+              fail = fail || !(merit < contactPointTolerance);
+            }
+            if(fail)
+              MathExtraLiggghtsNonspherical::calc_contact_point_if_no_previous_point_avaialable(cdata, &particle_i, &particle_j, cdata.contact_point, fi, fj, this->error);
+          } else
+            MathExtraLiggghtsNonspherical::calc_contact_point_using_prev_step(cdata, &particle_i, &particle_j, ratio, update->dt, prev_step_point, cdata.contact_point, fi, fj, this->error, contactPointTolerance);
+          if(motion) *motion = 0.0;
+        }
         vectorCopy3D(cdata.contact_point, prev_step_point); //store contact point in contact history for the next DEM time step
+        *prev_step_point_flag = 1.0;
 
         particles_in_contact = std::max(fi, fj) < 0.0;
 
@@ -182,6 +233,8 @@ namespace ContactModels
      double curvatureLimitFactor;
      bool meanCurvature;
      bool gaussianCurvature;
+     double contactPointTolerance;   // merit at which the contact point iteration terminates
+     double contactPointReuseFactor; // relative motion (in units of the smallest semi-axis) below which the contact point is not iterated
   };
 }
 }
@@ -207,6 +260,7 @@ public:
     inline void beginPass(CollisionData& , ForceData& , ForceData& ) {}
     inline void endPass(CollisionData& , ForceData& , ForceData& ) {}
     inline void registerSettings(Settings&) {}
+    inline void postSettings() {}
     inline void connectToProperties(PropertyRegistry&) {}
     inline bool checkSurfaceIntersect(CollisionData&) { return false; }
     inline void collision(CollisionData&, ForceData&, ForceData&) {}
@@ -0,0 +1,159 @@
+#include "gtest/gtest.h"
+#include <mpi.h>
+#include <string>
+#include <vector>
+#include "atom.h"
+#include "input.h"
+#include "lammps.h"
+
+using namespace LAMMPS_NS;
+
+class AtomMapTest : public ::testing::Test {
+protected:
+  AtomMapTest() : lammps(1, const_cast<char**>(argv), MPI_COMM_WORLD) {}
+
+  void setup(const char *map_style) {
+    if (map_style) {
+      std::string command = std::string("atom_modify map ") + map_style;
+      lammps.input->one(command.c_str());
+    }
+    lammps.input->file("scripts/in.atoms");
+  }
+
+  static const char * argv[1];
+  LAMMPS lammps;
+};
+
+const char * AtomMapTest::argv[1] = {"liggghts"};
+
+TEST_F(AtomMapTest, hashInsertFind) {
+  setup("hash");
+  Atom *atom = lammps.atom;
+  ASSERT_EQ(2, atom->map_style);
+
+  // sparse tags, far more than would fit into the table without collisions
+  atom->map_init();
+  const int n = 1500;
+  for (int k = 0; k < n; k++)
+    atom->map_one(1 + 7919*k, k);
+
+  for (int k = 0; k < n; k++)
+    EXPECT_EQ(k, atom->map(1 + 7919*k)) << "tag " << 1 + 7919*k;
+  EXPECT_EQ(-1, atom->map(2));
+  EXPECT_EQ(-1, atom->map(1 + 7919*n));
+}
+
+TEST_F(AtomMapTest, hashCollisions) {
+  setup("hash");
+  Atom *atom = lammps.atom;
+
+  // clusters of consecutive tags, inserted backwards, so that entries
+  // are displaced from their home slots and swapped on insertion
+  atom->map_init();
+  std::vector<int> tags;
+  for (int k = 1; k <= 200; k++) {
+    tags.push_back(k);
+    tags.push_back(k + (1 << 20));
+    tags.push_back(k + (1 << 24));
+  }
+  for (int k = tags.size()-1; k >= 0; k--)
+    atom->map_one(tags[k], k);
+
+  for (size_t k = 0; k < tags.size(); k++)
+    EXPECT_EQ((int)k, atom->map(tags[k])) << "tag " << tags[k];
+}
+
+TEST_F(AtomMapTest, hashOverwrite) {
+  setup("hash");
+  Atom *atom = lammps.atom;
+
+  atom->map_init();
+  for (int k = 1; k <= 100; k++)
+    atom->map_one(k, k);
+  for (int k = 1; k <= 100; k += 2)
+    atom->map_one(k, 1000+k);
+
+  for (int k = 1; k <= 100; k++)
+    EXPECT_EQ(k % 2 ? 1000+k : k, atom->map(k));
+}
+
+TEST_F(AtomMapTest, hashClearAndSet) {
+  setup("hash");
+  Atom *atom = lammps.atom;
+  const int nlocal = atom->nlocal;
+
+  atom->map_init();
+  atom->map_set();
+  for (int i = 0; i < nlocal; i++)
+    EXPECT_EQ(i, atom->map(atom->tag[i]));
+
+  atom->map_clear();
+  for (int i = 0; i < nlocal; i++)
+    EXPECT_EQ(-1, atom->map(atom->tag[i]));
+
+  // table is re-used after clearing
+  atom->map_set();
+  for (int i = 0; i < nlocal; i++)
+    EXPECT_EQ(i, atom->map(atom->tag[i]));
+}
+
+TEST_F(AtomMapTest, autoDenseTagsUseArray) {
+  setup("auto");
+  Atom *atom = lammps.atom;
+
+  atom->map_init();
+  atom->map_set();
+  EXPECT_EQ(1, atom->map_style);
+  for (int i = 0; i < atom->nlocal; i++)
+    EXPECT_EQ(i, atom->map(atom->tag[i]));
+}
+
+TEST_F(AtomMapTest, autoSparseTagsUseHash) {
+  setup("auto");
+  Atom *atom = lammps.atom;
+
+  atom->tag[0] = 5000000;
+  atom->map_init();
+  atom->map_set();
+  EXPECT_EQ(2, atom->map_style);
+  for (int i = 0; i < atom->nlocal; i++)
+    EXPECT_EQ(i, atom->map(atom->tag[i]));
+
+  // tags dense again
+  atom->tag[0] = atom->nlocal + 1;
+  atom->map_init();
+  atom->map_set();
+  EXPECT_EQ(1, atom->map_style);
+  EXPECT_EQ(0, atom->map(atom->nlocal + 1));
+}
+
+TEST_F(AtomMapTest, requireArrayPinsStyle) {
+  setup("auto");
+  Atom *atom = lammps.atom;
+
+  atom->tag[0] = 5000000;
+  atom->map_init();
+  atom->map_set();
+  ASSERT_EQ(2, atom->map_style);
+
+  atom->map_require_array();
+  EXPECT_EQ(1, atom->map_style);
+  EXPECT_EQ(0, atom->get_map_array()[5000000]);
+
+  // sparse tags no longer switch the map to the hash table
+  atom->map_init();
+  atom->map_set();
+  EXPECT_EQ(1, atom->map_style);
+  EXPECT_EQ(1, atom->map(atom->tag[1]));
+}
+
+TEST_F(AtomMapTest, userArrayIsKept) {
+  setup("array");
+  Atom *atom = lammps.atom;
+
+  atom->tag[0] = 5000000;
+  atom->map_init();
+  atom->map_set();
+  EXPECT_EQ(1, atom->map_style);
+  EXPECT_EQ(0, atom->map(5000000));
+}
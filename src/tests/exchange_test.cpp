@@ -0,0 +1,140 @@
+#include "gtest/gtest.h"
+#include <mpi.h>
+#include <algorithm>
+#include <vector>
+#include "atom.h"
+#include "atom_vec.h"
+#include "comm.h"
+#include "domain.h"
+#include "input.h"
+#include "lammps.h"
+#include "per_atom_arena.h"
+
+using namespace LAMMPS_NS;
+
+// per-atom fields in the arena of Atom hold values derived from the tag,
+// so that they can be checked after atoms are packed or moved around
+
+class ExchangeTest : public ::testing::Test {
+protected:
+  ExchangeTest() :
+    lammps(3, const_cast<char**>(argv), MPI_COMM_WORLD),
+    dval(NULL), ival(NULL), dlocal(NULL)
+  {
+    lammps.input->file();
+    Atom *atom = lammps.atom;
+    atom->arena->add_field("dval",&dval,ARENA_EXCHANGE);
+    atom->arena->add_field("ival",&ival,2,ARENA_EXCHANGE);
+    atom->arena->add_field("dlocal",&dlocal,0);
+    for (int i = 0; i < atom->nlocal; i++) {
+      dval[i] = 0.5*atom->tag[i];
+      ival[i][0] = 10*atom->tag[i];
+      ival[i][1] = 10*atom->tag[i] + 1;
+      dlocal[i] = -1.0*atom->tag[i];
+    }
+  }
+
+  ~ExchangeTest() {
+    lammps.atom->arena->remove_field(&dval);
+    lammps.atom->arena->remove_field(&ival);
+    lammps.atom->arena->remove_field(&dlocal);
+  }
+
+  void expect_values(int i, int tag) {
+    EXPECT_EQ(tag, lammps.atom->tag[i]);
+    EXPECT_EQ(0.5*tag, dval[i]) << "tag " << tag;
+    EXPECT_EQ(10*tag, ival[i][0]) << "tag " << tag;
+    EXPECT_EQ(10*tag + 1, ival[i][1]) << "tag " << tag;
+  }
+
+  static const char * argv[3];
+  LAMMPS lammps;
+
+  double *dval;
+  int **ival;
+  double *dlocal;
+};
+
+const char * ExchangeTest::argv[3] = {"liggghts", "-in", "scripts/in.atoms"};
+
+TEST_F(ExchangeTest, batchedPackMatchesPerAtom) {
+  Atom *atom = lammps.atom;
+  AtomVec *avec = atom->avec;
+  const int nlocal = atom->nlocal;
+
+  std::vector<int> leaving;
+  leaving.push_back(0);
+  leaving.push_back(5);
+  leaving.push_back(17);
+  leaving.push_back(nlocal-1);
+
+  // reference, one atom after the other
+  std::vector<double> ref(leaving.size()*1000);
+  int nref = 0;
+  for (size_t k = 0; k < leaving.size(); k++)
+    nref += avec->pack_exchange(leaving[k],&ref[nref]);
+  const int nrecord = static_cast<int>(ref[0]);
+  ASSERT_EQ(nref, static_cast<int>(leaving.size())*nrecord);
+
+  // batched as in Comm::exchange(), the buffer moves after every atom
+  std::vector<double> buf(nrecord);
+  int nsend = 0;
+  atom->arena->begin_pack_exchange(&buf[0]);
+  for (size_t k = 0; k < leaving.size(); k++) {
+    std::vector<double> bigger(nsend+nrecord);
+    std::copy(buf.begin(),buf.begin()+nsend,bigger.begin());
+    buf.swap(bigger);
+    atom->arena->pack_exchange_buffer(&buf[0]);
+    nsend += avec->pack_exchange(leaving[k],&buf[nsend]);
+  }
+  atom->arena->end_pack_exchange();
+
+  ASSERT_EQ(nref, nsend);
+  for (int m = 0; m < nsend; m++)
+    EXPECT_EQ(ref[m], buf[m]) << "value " << m;
+
+  // records unpack to copies of the leaving atoms
+  int m = 0;
+  for (size_t k = 0; k < leaving.size(); k++) {
+    m += avec->unpack_exchange(&buf[m]);
+    expect_values(atom->nlocal-1,atom->tag[leaving[k]]);
+    EXPECT_EQ(atom->x[leaving[k]][0], atom->x[atom->nlocal-1][0]);
+    EXPECT_EQ(atom->radius[leaving[k]], atom->radius[atom->nlocal-1]);
+  }
+  EXPECT_EQ(nlocal + static_cast<int>(leaving.size()), atom->nlocal);
+}
+
+TEST_F(ExchangeTest, leavingAtomsAreRemoved) {
+  Atom *atom = lammps.atom;
+  Domain *domain = lammps.domain;
+
+  // with a single proc, atoms outside the box are lost
+  for (int i = 0; i < atom->nlocal; i += 7)
+    atom->x[i][i % 3] = 2.0;
+
+  std::vector<int> remaining;
+  int maxtag = 0;
+  for (int i = 0; i < atom->nlocal; i++) {
+    maxtag = std::max(maxtag,atom->tag[i]);
+    bool inside = true;
+    for (int dim = 0; dim < 3; dim++)
+      if (atom->x[i][dim] < domain->sublo[dim] || atom->x[i][dim] >= domain->subhi[dim])
+        inside = false;
+    if (inside) remaining.push_back(atom->tag[i]);
+  }
+
+  // as at the start of a run
+  lammps.comm->init();
+  lammps.comm->exchange();
+
+  ASSERT_EQ(static_cast<int>(remaining.size()), atom->nlocal);
+
+  // order of remaining atoms changes, values must still match the tag
+  std::vector<bool> found(maxtag+1,false);
+  for (int i = 0; i < atom->nlocal; i++) {
+    expect_values(i,atom->tag[i]);
+    found[atom->tag[i]] = true;
+  }
+  for (size_t k = 0; k < remaining.size(); k++)
+    EXPECT_TRUE(found[remaining[k]]) << "tag " << remaining[k];
+}
@@ -0,0 +1,175 @@
+#include "gtest/gtest.h"
+#include <mpi.h>
+#include <vector>
+#include "atom.h"
+#include "input.h"
+#include "lammps.h"
+#include "per_atom_arena.h"
+
+using namespace LAMMPS_NS;
+
+// fields are registered with a stand-alone arena, so that the arena of
+// Atom, which is driven by AtomVec, is not touched
+
+class PerAtomArenaTest : public ::testing::Test {
+protected:
+  PerAtomArenaTest() :
+    lammps(3, const_cast<char**>(argv), MPI_COMM_WORLD),
+    arena(&lammps),
+    dvec(NULL), darray(NULL), ivec(NULL), iarray(NULL)
+  {
+    lammps.input->file();
+    nmax = lammps.atom->nmax;
+  }
+
+  void add_all_fields() {
+    arena.add_field("dvec",&dvec,ARENA_EXCHANGE);
+    arena.add_field("darray",&darray,3,ARENA_EXCHANGE);
+    arena.add_field("ivec",&ivec,0);
+    arena.add_field("iarray",&iarray,2,ARENA_EXCHANGE);
+  }
+
+  // values are unique per atom and field
+  void fill(int n) {
+    for (int i = 0; i < n; i++) {
+      dvec[i] = 0.5 + i;
+      for (int k = 0; k < 3; k++) darray[i][k] = -1.0*i - 0.25*k;
+      ivec[i] = 7*i;
+      for (int k = 0; k < 2; k++) iarray[i][k] = 1000*i + k;
+    }
+  }
+
+  // atom i holds the values filled in for atom j
+  void expect_values(int i, int j) {
+    EXPECT_EQ(0.5 + j, dvec[i]) << "atom " << i;
+    for (int k = 0; k < 3; k++) EXPECT_EQ(-1.0*j - 0.25*k, darray[i][k]) << "atom " << i;
+    EXPECT_EQ(7*j, ivec[i]) << "atom " << i;
+    for (int k = 0; k < 2; k++) EXPECT_EQ(1000*j + k, iarray[i][k]) << "atom " << i;
+  }
+
+  static const char * argv[3];
+  LAMMPS lammps;
+  PerAtomArena arena;
+  int nmax;
+
+  double *dvec;
+  double **darray;
+  int *ivec;
+  int **iarray;
+};
+
+const char * PerAtomArenaTest::argv[3] = {"liggghts", "-in", "scripts/in.atoms"};
+
+TEST_F(PerAtomArenaTest, addAllocatesZeroed) {
+  add_all_fields();
+  EXPECT_EQ(4, arena.nfields());
+  ASSERT_TRUE(dvec && darray && ivec && iarray);
+
+  for (int i = 0; i < nmax; i++) {
+    EXPECT_EQ(0.0, dvec[i]);
+    EXPECT_EQ(0, ivec[i]);
+    for (int k = 0; k < 3; k++) EXPECT_EQ(0.0, darray[i][k]);
+    for (int k = 0; k < 2; k++) EXPECT_EQ(0, iarray[i][k]);
+  }
+}
+
+TEST_F(PerAtomArenaTest, growKeepsValues) {
+  add_all_fields();
+  fill(nmax);
+
+  arena.grow(2*nmax);
+  for (int i = 0; i < nmax; i++) expect_values(i,i);
+
+  // rows of 2d arrays are writable up to the new nmax
+  darray[2*nmax-1][2] = 1.0;
+  iarray[2*nmax-1][1] = 1;
+
+  arena.grow(nmax/2);
+  for (int i = 0; i < nmax/2; i++) expect_values(i,i);
+}
+
+TEST_F(PerAtomArenaTest, addRemoveKeepsOtherFields) {
+  arena.add_field("dvec",&dvec,ARENA_EXCHANGE);
+  arena.add_field("darray",&darray,3,ARENA_EXCHANGE);
+  for (int i = 0; i < nmax; i++) {
+    dvec[i] = 0.5 + i;
+    for (int k = 0; k < 3; k++) darray[i][k] = -1.0*i - 0.25*k;
+  }
+  double *dvec_before = dvec;
+  double **darray_before = darray;
+
+  // a field added later does not move the others
+  arena.add_field("ivec",&ivec,0);
+  arena.add_field("iarray",&iarray,2,ARENA_EXCHANGE);
+  EXPECT_EQ(dvec_before, dvec);
+  EXPECT_EQ(darray_before, darray);
+  for (int i = 0; i < nmax; i++) {
+    EXPECT_EQ(0, ivec[i]);
+    ivec[i] = 7*i;
+    for (int k = 0; k < 2; k++) iarray[i][k] = 1000*i + k;
+  }
+
+  // neither does removing one
+  arena.remove_field(&darray);
+  EXPECT_TRUE(darray == NULL);
+  EXPECT_EQ(3, arena.nfields());
+  EXPECT_EQ(dvec_before, dvec);
+
+  // grow merges all fields into one block
+  arena.grow(nmax+10);
+  for (int i = 0; i < nmax; i++) {
+    EXPECT_EQ(0.5 + i, dvec[i]);
+    EXPECT_EQ(7*i, ivec[i]);
+    for (int k = 0; k < 2; k++) EXPECT_EQ(1000*i + k, iarray[i][k]);
+  }
+}
+
+TEST_F(PerAtomArenaTest, copy) {
+  add_all_fields();
+  fill(nmax);
+
+  arena.copy(3,5);
+  expect_values(5,3);
+  expect_values(3,3);
+
+  // calls from AtomVec are ignored while frozen
+  arena.freeze();
+  arena.copy(4,6);
+  arena.thaw();
+  expect_values(6,6);
+}
+
+TEST_F(PerAtomArenaTest, permute) {
+  add_all_fields();
+  const int n = nmax < 100 ? nmax : 100;
+  fill(n);
+
+  // reverse order, new atom i is old atom n-1-i
+  std::vector<int> permute(n);
+  for (int i = 0; i < n; i++) permute[i] = n-1-i;
+  arena.permute(&permute[0],n);
+
+  for (int i = 0; i < n; i++) expect_values(i,n-1-i);
+}
+
+TEST_F(PerAtomArenaTest, packUnpackExchange) {
+  add_all_fields();
+  fill(nmax-1);
+
+  // ivec is not exchanged
+  std::vector<double> buf(16,0.0);
+  const int m = arena.pack_exchange(3,&buf[0]);
+  EXPECT_EQ(1+3+2, m);
+
+  ivec[nmax-1] = -1;
+  EXPECT_EQ(m, arena.unpack_exchange(nmax-1,&buf[0]));
+  EXPECT_EQ(0.5 + 3, dvec[nmax-1]);
+  for (int k = 0; k < 3; k++) EXPECT_EQ(-3.0 - 0.25*k, darray[nmax-1][k]);
+  for (int k = 0; k < 2; k++) EXPECT_EQ(3000 + k, iarray[nmax-1][k]);
+  EXPECT_EQ(-1, ivec[nmax-1]);
+
+  // nothing is packed while frozen
+  arena.freeze();
+  EXPECT_EQ(0, arena.pack_exchange(3,&buf[0]));
+  arena.thaw();
+}
@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+#include <mpi.h>
+#include <string>
+#include <vector>
+#include "atom.h"
+#include "group.h"
+#include "input.h"
+#include "lammps.h"
+#include "variable.h"
+
+using namespace LAMMPS_NS;
+
+// atom-style variables with chunkable trees are evaluated for blocks of
+// atoms at a time. the reference formula appends a term that is 0 for all
+// atoms but keeps the tree from being chunked (the right operand of || may
+// raise an error), so it is evaluated atom by atom via eval_tree()
+
+static void expect_chunked_equals_tree(LAMMPS &lammps, const std::string &formula,
+                                       const char *group)
+{
+  const std::string chunked = "variable chunked atom " + formula;
+  const std::string tree = "variable tree atom (" + formula + ")+0*(1||sqrt(x))";
+  lammps.input->one(chunked.c_str());
+  lammps.input->one(tree.c_str());
+
+  Variable *variable = lammps.input->variable;
+  const int igroup = lammps.group->find(group);
+  const int nlocal = lammps.atom->nlocal;
+  ASSERT_GE(igroup, 0);
+
+  std::vector<double> result_chunked(nlocal, -1.);
+  std::vector<double> result_tree(nlocal, -2.);
+  variable->compute_atom(variable->find("chunked"), igroup, &result_chunked[0], 1, 0);
+  variable->compute_atom(variable->find("tree"), igroup, &result_tree[0], 1, 0);
+
+  for (int i = 0; i < nlocal; i++)
+    EXPECT_DOUBLE_EQ(result_tree[i], result_chunked[i]) << formula << " atom " << i;
+}
+
+class AtomVariableTest : public ::testing::Test {
+protected:
+  AtomVariableTest() : lammps(3, const_cast<char**>(argv), MPI_COMM_WORLD) {
+    lammps.input->file();
+    lammps.input->one("region lower block 0.0 1.0 0.0 1.0 0.0 0.5 units box");
+    lammps.input->one("group lower region lower");
+  }
+
+  static const char * argv[3];
+  LAMMPS lammps;
+};
+
+const char * AtomVariableTest::argv[3] = {"liggghts", "-in", "scripts/in.atoms"};
+
+TEST_F(AtomVariableTest, spansSeveralChunks) {
+  // chunks of 256 atoms, the last one partially filled
+  EXPECT_GT(lammps.atom->nlocal, 512);
+  EXPECT_NE(0, lammps.atom->nlocal % 256);
+}
+
+TEST_F(AtomVariableTest, product) {
+  expect_chunked_equals_tree(lammps, "x*y", "all");
+}
+
+TEST_F(AtomVariableTest, sumOfProduct) {
+  expect_chunked_equals_tree(lammps, "x+y*z", "all");
+  expect_chunked_equals_tree(lammps, "(x+y)*z-x/(1+y)", "all");
+}
+
+TEST_F(AtomVariableTest, nestedFunctions) {
+  expect_chunked_equals_tree(lammps, "sqrt(x*x+y*y)*exp(-z)+atan2(y,x+1)", "all");
+  expect_chunked_equals_tree(lammps, "floor(10*x)*atan2(y,1+z)-abs(cos(x*y)-sin(z+x*(1+cbrt(y))))", "all");
+  expect_chunked_equals_tree(lammps, "(x>0.5)*(y<=z)+(id%3)*ln(1+z)^2", "all");
+}
+
+TEST_F(AtomVariableTest, group) {
+  expect_chunked_equals_tree(lammps, "x+y*z", "lower");
+  expect_chunked_equals_tree(lammps, "sqrt(x*x+y*y)*exp(-z)", "lower");
+}
@@ -315,17 +315,23 @@ void Thermo::compute(int flag)
   for (i = 0; i < ncompute; i++)
     if (compute_which[i] == SCALAR) {
       if (!(computes[i]->invoked_flag & INVOKED_SCALAR)) {
+        if (modify->timing) computes[i]->begin_time_recording();
         computes[i]->compute_scalar();
+        if (modify->timing) computes[i]->end_time_recording();
         computes[i]->invoked_flag |= INVOKED_SCALAR;
       }
     } else if (compute_which[i] == VECTOR) {
       if (!(computes[i]->invoked_flag & INVOKED_VECTOR)) {
+        if (modify->timing) computes[i]->begin_time_recording();
         computes[i]->compute_vector();
+        if (modify->timing) computes[i]->end_time_recording();
         computes[i]->invoked_flag |= INVOKED_VECTOR;
       }
     } else if (compute_which[i] == ARRAY) {
       if (!(computes[i]->invoked_flag & INVOKED_ARRAY)) {
+        if (modify->timing) computes[i]->begin_time_recording();
         computes[i]->compute_array();
+        if (modify->timing) computes[i]->end_time_recording();
         computes[i]->invoked_flag |= INVOKED_ARRAY;
       }
     }
@@ -12,15 +12,32 @@
 ------------------------------------------------------------------------- */
 
 #include <mpi.h>
+#include <stdio.h>
+#include <string.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 #include "timer.h"
+#include "comm.h"
+#include "compute.h"
+#include "dump.h"
+#include "error.h"
+#include "fix.h"
 #include "memory.h"
 #include "modify.h"
+#include "output.h"
 
 using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-Timer::Timer(LAMMPS *lmp) : Pointers(lmp)
+Timer::Timer(LAMMPS *lmp) : Pointers(lmp),
+  trace_every(0),
+  trace_maxevents(0),
+  trace_file(NULL),
+  trace_active(false),
+  trace_full(false),
+  trace_start(0.0)
 {
   memory->create(array,TIME_N,"array");
 }
@@ -30,6 +47,7 @@ Timer::Timer(LAMMPS *lmp) : Pointers(lmp)
 Timer::~Timer()
 {
   memory->destroy(array);
+  delete [] trace_file;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -40,6 +58,8 @@ void Timer::init()
 
   if(modify->timing) {
     for (int i = 0; i < modify->nfix; i++) modify->fix[i]->reset_time_recording();
+    for (int i = 0; i < modify->ncompute; i++) modify->compute[i]->reset_time_recording();
+    for (int i = 0; i < output->ndump; i++) output->dump[i]->reset_time_recording();
   }
 }
 
@@ -87,3 +107,289 @@ double Timer::elapsed(int which)
   double current_time = MPI_Wtime();
   return (current_time - array[which]);
 }
+
+/* ----------------------------------------------------------------------
+   name of a timed fix hook
+------------------------------------------------------------------------- */
+
+const char *Timer::hook_name(int hook)
+{
+  static const char *names[TIME_HOOK_N] = {
+    "initial_integrate","post_integrate","pre_exchange","pre_neighbor",
+    "pre_force","post_force","final_integrate","end_of_step","other"};
+  return names[hook];
+}
+
+/* ----------------------------------------------------------------------
+   min, avg and max of a per-process time over all processes
+------------------------------------------------------------------------- */
+
+void Timer::stats(double time, double &tmin, double &tavg, double &tmax)
+{
+  double tsum;
+  MPI_Allreduce(&time,&tmin,1,MPI_DOUBLE,MPI_MIN,world);
+  MPI_Allreduce(&time,&tmax,1,MPI_DOUBLE,MPI_MAX,world);
+  MPI_Allreduce(&time,&tsum,1,MPI_DOUBLE,MPI_SUM,world);
+  tavg = tsum/comm->nprocs;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Timer::print_line(const char *kind, const char *id, const char *what,
+                       double tmin, double tavg, double tmax, double time_loop)
+{
+  const double pct = time_loop > 0.0 ? tavg/time_loop*100.0 : 0.0;
+  if (screen)
+    fprintf(screen,"%s %s %s time (%%) = %g (%g) min %g max %g\n",
+            kind,id,what,tavg,pct,tmin,tmax);
+  if (logfile)
+    fprintf(logfile,"%s %s %s time (%%) = %g (%g) min %g max %g\n",
+            kind,id,what,tavg,pct,tmin,tmax);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Timer::write_line(FILE *fp, const char *kind, const char *id, const char *what,
+                       double tmin, double tavg, double tmax)
+{
+  if (fp) fprintf(fp,"%s %s %s %g %g %g\n",kind,id,what,tmin,tavg,tmax);
+}
+
+/* ----------------------------------------------------------------------
+   print time spent in each fix (total and per hook), compute and dump
+   as min/avg/max over all processes. called by Finish if modify_timing
+   is on. if a timing file was given, the same data is written there
+   compute times are also contained in the times of the fix or dump
+   that invoked them
+------------------------------------------------------------------------- */
+
+void Timer::modify_breakdown(double time_loop)
+{
+  const int me = comm->me;
+  const int nprocs = comm->nprocs;
+  double tmin,tavg,tmax;
+
+  FILE *fp = NULL;
+  if (me == 0 && modify->timing_file) {
+    fp = fopen(modify->timing_file,"w");
+    if (!fp) {
+      char str[512];
+      sprintf(str,"Cannot open modify_timing file %s",modify->timing_file);
+      error->warning(FLERR,str);
+    } else
+      fprintf(fp,"# kind id hook/style tmin tavg tmax\n");
+  }
+
+  double *proc_times = NULL;
+  if (me == 0 && modify->timing > 1) proc_times = new double[nprocs];
+
+  // fixes, total and per hook
+
+  for (int i = 0; i < modify->nfix; i++) {
+    Fix *fix = modify->fix[i];
+    stats(fix->get_recorded_time(),tmin,tavg,tmax);
+    if (me == 0) {
+      print_line("Fix",fix->id,fix->style,tmin,tavg,tmax,time_loop);
+      write_line(fp,"fix",fix->id,fix->style,tmin,tavg,tmax);
+    }
+
+    for (int hook = 0; hook < TIME_HOOK_N; hook++) {
+      stats(fix->get_recorded_time(hook),tmin,tavg,tmax);
+      if (tmax == 0.0) continue;
+      if (me == 0) {
+        print_line("  Fix",fix->id,hook_name(hook),tmin,tavg,tmax,time_loop);
+        write_line(fp,"fix_hook",fix->id,hook_name(hook),tmin,tavg,tmax);
+      }
+    }
+
+    if (modify->timing > 1) {
+      double time = fix->get_recorded_time();
+      MPI_Gather(&time,1,MPI_DOUBLE,proc_times,1,MPI_DOUBLE,0,world);
+
+      if (me == 0) {
+        for (int p = 0; p < nprocs; ++p) {
+          if (screen)
+            fprintf(screen,"  [%d] Fix %s %s time %g\n",p,fix->id,fix->style,proc_times[p]);
+          if (logfile)
+            fprintf(logfile," [%d] Fix %s %s time %g\n",p,fix->id,fix->style,proc_times[p]);
+        }
+      }
+    }
+  }
+
+  // computes
+
+  for (int i = 0; i < modify->ncompute; i++) {
+    Compute *compute = modify->compute[i];
+    stats(compute->get_recorded_time(),tmin,tavg,tmax);
+    if (tmax == 0.0) continue;
+    if (me == 0) {
+      print_line("Compute",compute->id,compute->style,tmin,tavg,tmax,time_loop);
+      write_line(fp,"compute",compute->id,compute->style,tmin,tavg,tmax);
+    }
+  }
+
+  // dumps
+
+  for (int i = 0; i < output->ndump; i++) {
+    Dump *dump = output->dump[i];
+    stats(dump->get_recorded_time(),tmin,tavg,tmax);
+    if (me == 0) {
+      print_line("Dump",dump->id,dump->style,tmin,tavg,tmax,time_loop);
+      write_line(fp,"dump",dump->id,dump->style,tmin,tavg,tmax);
+    }
+  }
+
+  delete [] proc_times;
+  if (fp) fclose(fp);
+}
+
+/* ----------------------------------------------------------------------
+   start recording trace events, every = 0 switches tracing off
+------------------------------------------------------------------------- */
+
+void Timer::trace_setup(int every, int maxevents, const char *file)
+{
+  trace_every = every;
+  trace_maxevents = maxevents;
+  trace_active = false;
+  trace_full = false;
+  trace_events.clear();
+
+  delete [] trace_file;
+  trace_file = NULL;
+  if (file) {
+    trace_file = new char[strlen(file)+1];
+    strcpy(trace_file,file);
+  }
+
+  // common time origin for all processes
+
+  MPI_Barrier(world);
+  trace_start = MPI_Wtime();
+}
+
+/* ----------------------------------------------------------------------
+   record an event, recording stops once maxevents are reached
+   begin events still open at this point would never get their end
+   event and are dropped, so that all recorded sections are closed
+------------------------------------------------------------------------- */
+
+void Timer::trace_event(const char *name, char phase)
+{
+  TraceEvent event;
+  event.t = MPI_Wtime() - trace_start;
+#if defined(_OPENMP)
+  event.tid = omp_get_thread_num();
+#else
+  event.tid = 0;
+#endif
+  event.phase = phase;
+  strncpy(event.name,name,sizeof(event.name)-1);
+  event.name[sizeof(event.name)-1] = '\0';
+
+#if defined(_OPENMP)
+  #pragma omp critical
+#endif
+  {
+    if (trace_full) {
+      // recording was stopped by another thread
+    } else if ((int)trace_events.size() < trace_maxevents) {
+      trace_events.push_back(event);
+    } else {
+      trace_active = false;
+      trace_full = true;
+
+      // sections are nested per thread, scanning backwards an end event
+      // closes the next begin event of its thread
+      std::vector<int> nclosed;
+      std::vector<TraceEvent>::iterator it = trace_events.end();
+      while (it != trace_events.begin()) {
+        --it;
+        if (it->tid >= (int)nclosed.size()) nclosed.resize(it->tid+1,0);
+        if (it->phase == 'E') nclosed[it->tid]++;
+        else if (nclosed[it->tid] > 0) nclosed[it->tid]--;
+        else it = trace_events.erase(it);
+      }
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+static void trace_write_events(FILE *fp, const TraceEvent *events, int n,
+                               int pid, bool &first)
+{
+  for (int i = 0; i < n; i++) {
+    fprintf(fp,"%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d}",
+            first ? "" : ",\n",events[i].name,events[i].phase,1.0e6*events[i].t,pid,events[i].tid);
+    first = false;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   write trace events of all processes as Chrome trace event JSON,
+   which can be loaded into chrome://tracing or Perfetto
+   the process rank is used as pid, the OpenMP thread as tid
+   process 0 writes the events rank by rank, each rank sends its events
+   in chunks of TRACE_CHUNK so neither memory nor message sizes grow
+   with the total number of events
+------------------------------------------------------------------------- */
+
+#define TRACE_CHUNK 65536
+
+void Timer::trace_write()
+{
+  if (!trace_every || !trace_file) return;
+
+  const int me = comm->me;
+  const int nprocs = comm->nprocs;
+
+  FILE *fp = NULL;
+  int open_flag = 1;
+  if (me == 0) {
+    fp = fopen(trace_file,"w");
+    if (!fp) {
+      char str[512];
+      sprintf(str,"Cannot open timer_trace file %s",trace_file);
+      error->warning(FLERR,str);
+      open_flag = 0;
+    }
+  }
+  MPI_Bcast(&open_flag,1,MPI_INT,0,world);
+  if (!open_flag) return;
+
+  const int nevents = trace_events.size();
+  const TraceEvent *events = trace_events.empty() ? NULL : &trace_events[0];
+  int tmp,n;
+
+  if (me == 0) {
+    fprintf(fp,"{\"traceEvents\":[\n");
+    bool first = true;
+    trace_write_events(fp,events,nevents,0,first);
+
+    TraceEvent *buf = new TraceEvent[TRACE_CHUNK];
+    for (int p = 1; p < nprocs; p++) {
+      MPI_Send(&tmp,0,MPI_INT,p,0,world);
+      while (1) {
+        MPI_Recv(&n,1,MPI_INT,p,0,world,MPI_STATUS_IGNORE);
+        if (n == 0) break;
+        MPI_Recv(buf,n*sizeof(TraceEvent),MPI_BYTE,p,0,world,MPI_STATUS_IGNORE);
+        trace_write_events(fp,buf,n,p,first);
+      }
+    }
+    delete [] buf;
+
+    fprintf(fp,"\n]}\n");
+    fclose(fp);
+  } else {
+    MPI_Recv(&tmp,0,MPI_INT,0,0,world,MPI_STATUS_IGNORE);
+    for (int offset = 0; offset < nevents; offset += TRACE_CHUNK) {
+      n = MIN(TRACE_CHUNK,nevents-offset);
+      MPI_Send(&n,1,MPI_INT,0,0,world);
+      MPI_Send((void *) &events[offset],n*sizeof(TraceEvent),MPI_BYTE,0,0,world);
+    }
+    n = 0;
+    MPI_Send(&n,1,MPI_INT,0,0,world);
+  }
+}
@@ -15,12 +15,29 @@
 #define LMP_TIMER_H
 
 #include "pointers.h"
+#include <vector>
 
 enum{TIME_LOOP,TIME_PAIR,TIME_BOND,TIME_KSPACE,TIME_NEIGHBOR,
      TIME_COMM,TIME_OUTPUT,TIME_MODIFY,TIME_N};
 
+// fix hooks that are timed separately if modify_timing is on
+
+enum{TIME_HOOK_INITIAL_INTEGRATE,TIME_HOOK_POST_INTEGRATE,
+     TIME_HOOK_PRE_EXCHANGE,TIME_HOOK_PRE_NEIGHBOR,TIME_HOOK_PRE_FORCE,
+     TIME_HOOK_POST_FORCE,TIME_HOOK_FINAL_INTEGRATE,TIME_HOOK_END_OF_STEP,
+     TIME_HOOK_OTHER,TIME_HOOK_N};
+
 namespace LAMMPS_NS {
 
+// begin or end of a traced section, see timer_trace command
+
+struct TraceEvent {
+  double t;             // time since start of tracing
+  int tid;              // thread
+  char phase;           // 'B' or 'E'
+  char name[27];
+};
+
 class Timer : protected Pointers {
  public:
   double *array;
@@ -34,8 +51,45 @@ class Timer : protected Pointers {
   void barrier_stop(int);
   double elapsed(int);
 
+  void modify_breakdown(double);
+  static const char *hook_name(int);
+
+  void trace_setup(int, int, const char *);
+  void trace_write();
+
+  // tracing is only active on every trace_every-th step
+
+  inline void trace_step(bigint ntimestep) {
+    trace_active = trace_every > 0 && ntimestep % trace_every == 0 &&
+                   !trace_full;
+  }
+
+  inline bool tracing() const { return trace_active; }
+
+  inline void trace_begin(const char *name) {
+    if (trace_active) trace_event(name,'B');
+  }
+
+  inline void trace_end(const char *name) {
+    if (trace_active) trace_event(name,'E');
+  }
+
  private:
   double previous_time;
+
+  int trace_every;                       // 0 if tracing is off
+  int trace_maxevents;                   // max # of events per process
+  char *trace_file;
+  bool trace_active;
+  bool trace_full;                       // maxevents reached, recording stopped
+  double trace_start;
+  std::vector<TraceEvent> trace_events;
+
+  void trace_event(const char *, char);
+
+  void stats(double, double &, double &, double &);
+  void print_line(const char *, const char *, const char *, double, double, double, double);
+  void write_line(FILE *, const char *, const char *, const char *, double, double, double);
 };
 
 }
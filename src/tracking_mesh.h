@@ -51,6 +51,8 @@ namespace LAMMPS_NS{
 
         virtual void scale(double factor);
 
+        virtual void materialize();
+
         virtual int generateRandomOwnedGhost(double *pos) = 0;
         virtual int generateRandomOwnedGhostWithin(double *pos,double delta) = 0;
         virtual int generateRandomSubbox(double *pos) = 0;
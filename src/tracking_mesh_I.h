@@ -42,6 +42,7 @@
     mapArray_(0),
     verbose_(false)
   {
+      id_.setConstant();
   }
 
   /* ----------------------------------------------------------------------
@@ -345,7 +346,12 @@
   {
     //NP this handles owned and ghost elements
     MultiNodeMesh<NUM_NODES>::move(vecTotal, vecIncremental);
-    customValues_.move(vecTotal,vecIncremental);
+
+    //NP rigid frame: element properties are transformed on materialization
+    if(this->rigidFrame())
+        customValues_.moveGlobalProperties(vecTotal);
+    else
+        customValues_.move(vecTotal,vecIncremental);
   }
 
   template<int NUM_NODES>
@@ -353,7 +359,11 @@
   {
     //NP this handles owned and ghost elements
     MultiNodeMesh<NUM_NODES>::move(vecIncremental);
-    customValues_.move(vecIncremental);
+
+    if(this->rigidFrame())
+        customValues_.moveGlobalProperties(vecIncremental);
+    else
+        customValues_.move(vecIncremental);
   }
 
   template<int NUM_NODES>
@@ -372,6 +382,14 @@
 
     MultiNodeMesh<NUM_NODES>::rotate(totalQ,dQ,origin);
 
+    if(this->rigidFrame())
+    {
+        if(trans) customValues_.moveGlobalProperties(negorigin);
+        customValues_.rotateGlobalProperties(totalQ);
+        if(trans) customValues_.moveGlobalProperties(origin);
+        return;
+    }
+
     //NP this handles owned and ghost elements
     if(trans) customValues_.move(negorigin);
     customValues_.rotate(totalQ,dQ);
@@ -387,12 +405,50 @@
 
     MultiNodeMesh<NUM_NODES>::rotate(dQ,origin);
 
+    if(this->rigidFrame())
+    {
+        if(trans) customValues_.moveGlobalProperties(negorigin);
+        customValues_.rotateGlobalProperties(dQ);
+        if(trans) customValues_.moveGlobalProperties(origin);
+        return;
+    }
+
     //NP this handles owned and ghost elements
     if(trans) customValues_.move(negorigin);
     customValues_.rotate(dQ);
     if(trans) customValues_.move(origin);
   }
 
+  /* ----------------------------------------------------------------------
+   rigid frame mode: bring nodes and element properties to the current
+   position, set mesh velocity from the frame velocity
+  ------------------------------------------------------------------------- */
+
+  template<int NUM_NODES>
+  void TrackingMesh<NUM_NODES>::materialize()
+  {
+    if(!this->rigidFrame()) return;
+
+    double qRel[4],tRel[3];
+    if(this->frameRel(qRel,tRel))
+    {
+        //NP this handles owned and ghost elements
+        customValues_.rotateElementProperties(qRel);
+        customValues_.moveElementProperties(tRel);
+    }
+
+    MultiNodeMesh<NUM_NODES>::materialize();
+
+    MultiVectorContainer<double,NUM_NODES,3> *v =
+        customValues_.template getElementProperty<MultiVectorContainer<double,NUM_NODES,3> >("v");
+    if(!v) return;
+
+    const int n = this->sizeLocal() + this->sizeGhost();
+    for(int i = 0; i < n; i++)
+        for(int j = 0; j < NUM_NODES; j++)
+            this->frameVelocityAt(this->node_(i)[j],(*v)(i)[j]);
+  }
+
   template<int NUM_NODES>
   void TrackingMesh<NUM_NODES>::scale(double factor)
   {
@@ -50,6 +50,8 @@ using namespace MathConst;
 #define MAXLEVEL 4
 #define MAXLINE 256
 #define CHUNK 1024
+#define ATOMCHUNK 256       // atoms per block in chunked atom-style evaluation
+#define MAXSTACK 32         // max stack depth of a compiled formula
 
 #define MYROUND(a) (( a-floor(a) ) >= .5) ? ceil(a) : floor(a)
 
@@ -66,7 +68,37 @@ enum{DONE,ADD,SUBTRACT,MULTIPLY,DIVIDE,CARAT,MODULO,UNARY,
      SQRT,CBRT,EXP,LN,LOG,ABS,SIN,COS,TAN,ASIN,ACOS,ATAN,ATAN2,
      RANDOM,NORMAL,CEIL,FLOOR,ROUND,RAMP,STAGGER,LOGFREQ,STRIDE,
      VDISPLACE,SWIGGLE,CWIGGLE,GMASK,RMASK,GRMASK,
-     VALUE,ATOMARRAY,TYPEARRAY,INTARRAY};
+     VALUE,ATOMARRAY,TYPEARRAY,INTARRAY,
+     COMPUTESCALAR,COMPUTEVECTOR,COMPUTEARRAY,FIXSCALAR,FIXVECTOR,FIXARRAY,
+     VARIABLE,THERMOKEYWORD};
+
+// math functions available in compiled equal-style formulas
+// random() and normal() are left to evaluate(), their generator is
+//   seeded by the first call
+
+static const struct {
+  const char *name;
+  int type,narg;
+} compiled_function[] = {
+  {"sqrt",SQRT,1}, {"cbrt",CBRT,1}, {"exp",EXP,1}, {"ln",LN,1},
+  {"log",LOG,1}, {"abs",ABS,1}, {"sin",SIN,1}, {"cos",COS,1},
+  {"tan",TAN,1}, {"asin",ASIN,1}, {"acos",ACOS,1}, {"atan",ATAN,1},
+  {"atan2",ATAN2,2}, {"ceil",CEIL,1}, {"floor",FLOOR,1}, {"round",ROUND,1},
+  {"ramp",RAMP,2}, {"stagger",STAGGER,2}, {"logfreq",LOGFREQ,3},
+  {"stride",STRIDE,3}, {"vdisplace",VDISPLACE,2}, {"swiggle",SWIGGLE,3},
+  {"cwiggle",CWIGGLE,3}, {NULL,0,0}
+};
+
+// # of stack operands consumed by an instruction of a compiled formula
+
+static int noperand(int type)
+{
+  if (type == UNARY || type == NOT) return 1;
+  if (type >= ADD && type <= OR) return 2;
+  for (int i = 0; compiled_function[i].name; i++)
+    if (compiled_function[i].type == type) return compiled_function[i].narg;
+  return 0;
+}
 
 // customize by adding a special function
 
@@ -91,6 +123,10 @@ Variable::Variable(LAMMPS *lmp) : Pointers(lmp)
 
   eval_in_progress = NULL;
 
+  program = NULL;
+  compiled = NULL;
+  compile_retry = 0;
+
   randomequal = NULL;
   randomatom = NULL;
 
@@ -117,6 +153,7 @@ Variable::~Variable()
     if (style[i] == LOOP || style[i] == ULOOP) delete [] data[i][0];
     else for (int j = 0; j < num[i]; j++) delete [] data[i][j];
     delete [] data[i];
+    free_program(&program[i]);
   }
   memory->sfree(names);
   memory->destroy(style);
@@ -128,6 +165,9 @@ Variable::~Variable()
 
   memory->destroy(eval_in_progress);
 
+  memory->sfree(program);
+  memory->destroy(compiled);
+
   delete randomequal;
   delete randomatom;
 }
@@ -356,6 +396,8 @@ void Variable::set(int narg, char **arg)
         error->all(FLERR,"Cannot redefine variable as a different style");
       delete [] data[ivar][0];
       copy(1,&arg[2],data[ivar]);
+      free_program(&program[ivar]);
+      compiled[ivar] = 0;
       replaceflag = 1;
     } else {
       if (nvar == maxvar) grow();
@@ -603,8 +645,25 @@ double Variable::compute_equal(int ivar)
   // eval_in_progress used to detect circle dependencies
   // could extend this later to check v_a = c_b + v_a constructs?
 
+  // formula is compiled on first use, falls back to evaluate()
+  //   if it uses features the compiled form does not support
+
+  // only unsupported syntax marks the formula as not compilable,
+  //   unresolved references are tried again on the next evaluation
+
   eval_in_progress[ivar] = 1;
-  double value = evaluate(data[ivar][0],NULL);
+  if (compiled[ivar] == 0) {
+    compile_retry = 0;
+    if (compile(data[ivar][0],&program[ivar]) &&
+        program[ivar].maxdepth <= MAXSTACK) compiled[ivar] = 1;
+    else {
+      free_program(&program[ivar]);
+      compiled[ivar] = compile_retry ? 0 : -1;
+    }
+  }
+  double value;
+  if (compiled[ivar] > 0) value = eval_program(&program[ivar]);
+  else value = evaluate(data[ivar][0],NULL);
   eval_in_progress[ivar] = 0;
   return value;
 }
@@ -632,16 +691,51 @@ void Variable::compute_atom(int ivar, int igroup,
   Tree *tree;
   double *vstore = NULL;
 
+  // collapsed tree is flattened into postfix order if possible,
+  //   and then evaluated for blocks of ATOMCHUNK atoms at a time,
+  //   each operation looping over the block
+
+  Tree **code = NULL;
+  int ncode = 0;
+  double *stack = NULL;
+
   if (style[ivar] == ATOM) {
     evaluate(data[ivar][0],&tree); //NP modified R.B.
     collapse_tree(tree); //NP modified R.B.
+    if (chunkable_tree(tree)) {
+      flatten_tree(tree,NULL,ncode);
+      code = new Tree*[ncode];
+      ncode = 0;
+      int depth = flatten_tree(tree,code,ncode);
+      memory->create(stack,depth*ATOMCHUNK,"variable:stack");
+    }
   } else vstore = reader[ivar]->fix->vstore;
 
   int groupbit = group->bitmask[igroup];
   int *mask = atom->mask;
   int nlocal = atom->nlocal;
 
-  if (style[ivar] == ATOM) {
+  if (code) {
+    int list[ATOMCHUNK];
+    for (int ifirst = 0; ifirst < nlocal; ifirst += ATOMCHUNK) {
+      int ilast = MIN(ifirst+ATOMCHUNK,nlocal);
+      int n = 0;
+      for (int i = ifirst; i < ilast; i++)
+        if (mask[i] & groupbit) list[n++] = i;
+      if (n) eval_tree_chunk(code,ncode,list,n,stack);
+
+      int k = 0;
+      int m = ifirst*stride;
+      for (int i = ifirst; i < ilast; i++) {
+        if (mask[i] & groupbit) {
+          if (sumflag) result[m] += stack[k++];
+          else result[m] = stack[k++];
+        } else if (sumflag == 0) result[m] = 0.0;
+        m += stride;
+      }
+    }
+
+  } else if (style[ivar] == ATOM) {
     if (sumflag == 0) {
       int m = 0;
       for (int i = 0; i < nlocal; i++) {
@@ -677,6 +771,8 @@ void Variable::compute_atom(int ivar, int igroup,
   }
 
   if (style[ivar] == ATOM) free_tree(tree);
+  delete [] code;
+  memory->destroy(stack);
 }
 
 /* ----------------------------------------------------------------------
@@ -723,6 +819,7 @@ void Variable::remove(int n)
   else for (int i = 0; i < num[n]; i++) delete [] data[n][i];
   delete [] data[n];
   delete reader[n];
+  free_program(&program[n]);
 
   for (int i = n+1; i < nvar; i++) {
     names[i-1] = names[i];
@@ -732,7 +829,13 @@ void Variable::remove(int n)
     pad[i-1] = pad[i];
     reader[i-1] = reader[i];
     data[i-1] = data[i];
+    program[i-1] = program[i];
+    compiled[i-1] = compiled[i];
   }
+  program[nvar-1].n = program[nvar-1].nmax = 0;
+  program[nvar-1].depth = program[nvar-1].maxdepth = 0;
+  program[nvar-1].code = NULL;
+  compiled[nvar-1] = 0;
   nvar--;
 }
 
@@ -758,6 +861,16 @@ void Variable::grow()
 
   memory->grow(eval_in_progress,maxvar,"var:eval_in_progress");
   for (int i = 0; i < maxvar; i++) eval_in_progress[i] = 0;
+
+  program = (Program *)
+    memory->srealloc(program,maxvar*sizeof(Program),"var:program");
+  memory->grow(compiled,maxvar,"var:compiled");
+  for (int i = old; i < maxvar; i++) {
+    program[i].n = program[i].nmax = 0;
+    program[i].depth = program[i].maxdepth = 0;
+    program[i].code = NULL;
+    compiled[i] = 0;
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -2376,6 +2489,890 @@ void Variable::free_tree(Tree *tree)
   delete tree;
 }
 
+/* ----------------------------------------------------------------------
+   check if a collapsed tree can be evaluated by eval_tree_chunk()
+   not possible if tree draws random numbers, since their order per atom
+     would change, or if the right operand of && or || can raise an error
+     that eval_tree() skips by short-circuit evaluation
+------------------------------------------------------------------------- */
+
+int Variable::chunkable_tree(Tree *tree)
+{
+  if (tree->type == VALUE || tree->type == ATOMARRAY ||
+      tree->type == TYPEARRAY || tree->type == INTARRAY ||
+      tree->type == GMASK || tree->type == RMASK || tree->type == GRMASK)
+    return 1;
+  if (tree->type == RANDOM || tree->type == NORMAL) return 0;
+  if ((tree->type == AND || tree->type == OR) && raises_tree(tree->right))
+    return 0;
+
+  if (tree->left && !chunkable_tree(tree->left)) return 0;
+  if (tree->middle && !chunkable_tree(tree->middle)) return 0;
+  if (tree->right && !chunkable_tree(tree->right)) return 0;
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   return 1 if evaluation of a collapsed tree can raise an error
+------------------------------------------------------------------------- */
+
+int Variable::raises_tree(Tree *tree)
+{
+  if (tree->type == VALUE || tree->type == ATOMARRAY ||
+      tree->type == TYPEARRAY || tree->type == INTARRAY ||
+      tree->type == GMASK || tree->type == RMASK || tree->type == GRMASK)
+    return 0;
+  if (tree->type == DIVIDE || tree->type == MODULO || tree->type == CARAT ||
+      tree->type == SQRT || tree->type == LN || tree->type == LOG ||
+      tree->type == ASIN || tree->type == ACOS ||
+      tree->type == RANDOM || tree->type == NORMAL ||
+      tree->type == STAGGER || tree->type == LOGFREQ ||
+      tree->type == STRIDE || tree->type == SWIGGLE ||
+      tree->type == CWIGGLE)
+    return 1;
+
+  if (tree->left && raises_tree(tree->left)) return 1;
+  if (tree->middle && raises_tree(tree->middle)) return 1;
+  if (tree->right && raises_tree(tree->right)) return 1;
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   append nodes of a collapsed tree to code in postfix order
+   only count them if code = NULL
+   return stack depth in blocks needed to evaluate the tree
+------------------------------------------------------------------------- */
+
+int Variable::flatten_tree(Tree *tree, Tree **code, int &ncode)
+{
+  int depth = 1;
+
+  if (tree->type != VALUE && tree->type != ATOMARRAY &&
+      tree->type != TYPEARRAY && tree->type != INTARRAY &&
+      tree->type != GMASK && tree->type != RMASK && tree->type != GRMASK) {
+    Tree *child[3] = {tree->left,tree->middle,tree->right};
+    int narg = 0;
+    for (int m = 0; m < 3; m++) {
+      if (!child[m]) continue;
+      // MAX() evaluates its arguments twice, call outside of it
+      const int dchild = flatten_tree(child[m],code,ncode);
+      depth = MAX(depth,narg + dchild);
+      narg++;
+    }
+  }
+
+  if (code) code[ncode] = tree;
+  ncode++;
+  return depth;
+}
+
+/* ----------------------------------------------------------------------
+   evaluate flattened tree for the n atoms in list
+   stack holds one block of ATOMCHUNK values per level
+   result is returned in the first block of stack
+------------------------------------------------------------------------- */
+
+void Variable::eval_tree_chunk(Tree **code, int ncode, int *list, int n,
+                               double *stack)
+{
+  int k;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  double **x = atom->x;
+
+  int ntop = 0;
+
+  for (int icode = 0; icode < ncode; icode++) {
+    Tree *tree = code[icode];
+
+    // values push a new block onto the stack
+
+    if (tree->type == VALUE || tree->type == ATOMARRAY ||
+        tree->type == TYPEARRAY || tree->type == INTARRAY ||
+        tree->type == GMASK || tree->type == RMASK || tree->type == GRMASK) {
+      double *r = &stack[ATOMCHUNK*ntop++];
+
+      if (tree->type == VALUE) {
+        const double value = tree->value;
+        for (k = 0; k < n; k++) r[k] = value;
+      } else if (tree->type == ATOMARRAY) {
+        const double *array = tree->array;
+        const int nstride = tree->nstride;
+        for (k = 0; k < n; k++) r[k] = array[list[k]*nstride];
+      } else if (tree->type == TYPEARRAY) {
+        for (k = 0; k < n; k++) r[k] = tree->array[type[list[k]]];
+      } else if (tree->type == INTARRAY) {
+        const int *iarray = tree->iarray;
+        const int nstride = tree->nstride;
+        for (k = 0; k < n; k++) r[k] = (double) iarray[list[k]*nstride];
+      } else if (tree->type == GMASK) {
+        for (k = 0; k < n; k++)
+          r[k] = (mask[list[k]] & tree->ivalue1) ? 1.0 : 0.0;
+      } else if (tree->type == RMASK) {
+        Region *region = domain->regions[tree->ivalue1];
+        for (k = 0; k < n; k++) {
+          double *xk = x[list[k]];
+          r[k] = region->match(xk[0],xk[1],xk[2]) ? 1.0 : 0.0;
+        }
+      } else {
+        Region *region = domain->regions[tree->ivalue2];
+        for (k = 0; k < n; k++) {
+          double *xk = x[list[k]];
+          r[k] = ((mask[list[k]] & tree->ivalue1) &&
+                  region->match(xk[0],xk[1],xk[2])) ? 1.0 : 0.0;
+        }
+      }
+      continue;
+    }
+
+    // operations replace their operand blocks by the result
+
+    int narg = (tree->left != NULL) + (tree->middle != NULL) +
+      (tree->right != NULL);
+    ntop -= narg;
+    double *a = &stack[ATOMCHUNK*ntop];
+    double *b = narg > 1 ? a + ATOMCHUNK : NULL;
+    double *c = narg > 2 ? a + 2*ATOMCHUNK : NULL;
+    ntop++;
+
+    switch (tree->type) {
+    case ADD:
+      for (k = 0; k < n; k++) a[k] += b[k];
+      break;
+    case SUBTRACT:
+      for (k = 0; k < n; k++) a[k] -= b[k];
+      break;
+    case MULTIPLY:
+      for (k = 0; k < n; k++) a[k] *= b[k];
+      break;
+    case DIVIDE:
+      for (k = 0; k < n; k++)
+        if (b[k] == 0.0) error->one(FLERR,"Divide by 0 in variable formula");
+      for (k = 0; k < n; k++) a[k] /= b[k];
+      break;
+    case UNARY:
+      for (k = 0; k < n; k++) a[k] = -a[k];
+      break;
+    case EQ:
+      for (k = 0; k < n; k++) a[k] = (a[k] == b[k]) ? 1.0 : 0.0;
+      break;
+    case NE:
+      for (k = 0; k < n; k++) a[k] = (a[k] != b[k]) ? 1.0 : 0.0;
+      break;
+    case LT:
+      for (k = 0; k < n; k++) a[k] = (a[k] < b[k]) ? 1.0 : 0.0;
+      break;
+    case LE:
+      for (k = 0; k < n; k++) a[k] = (a[k] <= b[k]) ? 1.0 : 0.0;
+      break;
+    case GT:
+      for (k = 0; k < n; k++) a[k] = (a[k] > b[k]) ? 1.0 : 0.0;
+      break;
+    case GE:
+      for (k = 0; k < n; k++) a[k] = (a[k] >= b[k]) ? 1.0 : 0.0;
+      break;
+    case AND:
+      for (k = 0; k < n; k++) a[k] = (a[k] != 0.0 && b[k] != 0.0) ? 1.0 : 0.0;
+      break;
+    case OR:
+      for (k = 0; k < n; k++) a[k] = (a[k] != 0.0 || b[k] != 0.0) ? 1.0 : 0.0;
+      break;
+    case SQRT:
+      for (k = 0; k < n; k++)
+        if (a[k] < 0.0)
+          error->one(FLERR,"Sqrt of negative value in variable formula");
+      for (k = 0; k < n; k++) a[k] = sqrt(a[k]);
+      break;
+    case EXP:
+      for (k = 0; k < n; k++) a[k] = exp(a[k]);
+      break;
+    case ABS:
+      for (k = 0; k < n; k++) a[k] = fabs(a[k]);
+      break;
+    default:
+      for (k = 0; k < n; k++)
+        a[k] = math_op(tree->type,a[k],b ? b[k] : 0.0,c ? c[k] : 0.0,0);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   compile an equal-style formula str into postfix code appended to prog
+   accepts the same syntax as evaluate() with the same operator precedence
+   references to computes, fixes, variables and thermo keywords are kept
+     by name and resolved each time the program is evaluated
+   return 1 if successful
+   return 0 if str uses anything not supported by eval_program(), i.e.
+     group/special functions, random(), normal(), atom values or
+     per-atom data, or if it has a syntax error, evaluate() is used then
+------------------------------------------------------------------------- */
+
+int Variable::compile(char *str, Program *prog)
+{
+  int op,opprevious;
+  char onechar;
+
+  int opstack[MAXLEVEL];
+  int nopstack = 0;
+  int depth = prog->depth;
+
+  int i = 0;
+  int expect = ARG;
+
+  while (1) {
+    onechar = str[i];
+
+    // whitespace: just skip
+
+    if (isspace(onechar)) i++;
+
+    // parentheses: compile contents
+
+    else if (onechar == '(') {
+      if (expect == OP) return 0;
+      expect = OP;
+
+      char *contents;
+      i = find_matching_paren(str,i,contents);
+      i++;
+
+      int flag = compile(contents,prog);
+      delete [] contents;
+      if (!flag) return 0;
+
+    // number
+
+    } else if (isdigit(onechar) || onechar == '.') {
+      if (expect == OP) return 0;
+      expect = OP;
+
+      int istart = i;
+      while (isdigit(str[i]) || str[i] == '.') i++;
+      if (str[i] == 'e' || str[i] == 'E') {
+        i++;
+        if (str[i] == '+' || str[i] == '-') i++;
+        while (isdigit(str[i])) i++;
+      }
+      int istop = i - 1;
+
+      int n = istop - istart + 1;
+      char *number = new char[n+1];
+      strncpy(number,&str[istart],n);
+      number[n] = '\0';
+      emit(prog,VALUE,atof(number),NULL,0,0);
+      delete [] number;
+
+    // letter: compute, fix, variable, math function, constant, thermo keyword
+
+    } else if (isalpha(onechar)) {
+      if (expect == OP) return 0;
+      expect = OP;
+
+      int istart = i;
+      while (isalnum(str[i]) || str[i] == '_') i++;
+      int istop = i-1;
+
+      int n = istop - istart + 1;
+      char *word = new char[n+1];
+      strncpy(word,&str[istart],n);
+      word[n] = '\0';
+
+      int flag = compile_word(word,str,i,prog);
+      delete [] word;
+      if (!flag) return 0;
+
+    // math operator, including end-of-string
+
+    } else if (strchr("+-*/^<>=!&|%\0",onechar)) {
+      if (onechar == '+') op = ADD;
+      else if (onechar == '-') op = SUBTRACT;
+      else if (onechar == '*') op = MULTIPLY;
+      else if (onechar == '/') op = DIVIDE;
+      else if (onechar == '%') op = MODULO;
+      else if (onechar == '^') op = CARAT;
+      else if (onechar == '=') {
+        if (str[i+1] != '=') return 0;
+        op = EQ;
+        i++;
+      } else if (onechar == '!') {
+        if (str[i+1] == '=') {
+          op = NE;
+          i++;
+        } else op = NOT;
+      } else if (onechar == '<') {
+        if (str[i+1] != '=') op = LT;
+        else {
+          op = LE;
+          i++;
+        }
+      } else if (onechar == '>') {
+        if (str[i+1] != '=') op = GT;
+        else {
+          op = GE;
+          i++;
+        }
+      } else if (onechar == '&') {
+        if (str[i+1] != '&') return 0;
+        op = AND;
+        i++;
+      } else if (onechar == '|') {
+        if (str[i+1] != '|') return 0;
+        op = OR;
+        i++;
+      } else op = DONE;
+
+      i++;
+
+      if (op != DONE && nopstack == MAXLEVEL) return 0;
+
+      if (op == SUBTRACT && expect == ARG) {
+        opstack[nopstack++] = UNARY;
+        continue;
+      }
+      if (op == NOT && expect == ARG) {
+        opstack[nopstack++] = op;
+        continue;
+      }
+
+      if (expect == ARG) return 0;
+      expect = ARG;
+
+      // emit stacked operations as deep as precedence allows
+
+      while (nopstack && precedence[opstack[nopstack-1]] >= precedence[op]) {
+        opprevious = opstack[--nopstack];
+        emit(prog,opprevious,0.0,NULL,0,0);
+      }
+
+      if (op == DONE) break;
+      opstack[nopstack++] = op;
+
+    } else return 0;
+  }
+
+  if (nopstack) return 0;
+
+  // formula must leave exactly one value on the stack
+
+  if (prog->depth != depth+1) return 0;
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   compile a word of an equal-style formula
+   i points beyond the word in str, is moved beyond its brackets or args
+   return 1 if successful, 0 if not supported by compiled formulas
+------------------------------------------------------------------------- */
+
+int Variable::compile_word(char *word, char *str, int &i, Program *prog)
+{
+  char *ptr;
+
+  // compute or fix, global scalar/vector/array only
+
+  if (strncmp(word,"c_",2) == 0 || strncmp(word,"f_",2) == 0) {
+    if (domain->box_exist == 0) {
+      compile_retry = 1;
+      return 0;
+    }
+
+    int nbracket = 0;
+    int index1 = 0,index2 = 0;
+    if (str[i] == '[') {
+      nbracket = 1;
+      ptr = &str[i];
+      index1 = int_between_brackets(ptr);
+      i = ptr-str+1;
+      if (str[i] == '[') {
+        nbracket = 2;
+        ptr = &str[i];
+        index2 = int_between_brackets(ptr);
+        i = ptr-str+1;
+      }
+    }
+
+    int type = -1;
+    if (word[0] == 'c') {
+      int icompute = modify->find_compute(&word[2]);
+      if (icompute < 0) {
+        compile_retry = 1;
+        return 0;
+      }
+      Compute *compute = modify->compute[icompute];
+      if (nbracket == 0 && compute->scalar_flag) type = COMPUTESCALAR;
+      else if (nbracket == 1 && compute->vector_flag) type = COMPUTEVECTOR;
+      else if (nbracket == 2 && compute->array_flag) type = COMPUTEARRAY;
+    } else {
+      int ifix = modify->find_fix(&word[2]);
+      if (ifix < 0) {
+        compile_retry = 1;
+        return 0;
+      }
+      Fix *fix = modify->fix[ifix];
+      if (nbracket == 0 && fix->scalar_flag) type = FIXSCALAR;
+      else if (nbracket == 1 && fix->vector_flag) type = FIXVECTOR;
+      else if (nbracket == 2 && fix->array_flag) type = FIXARRAY;
+    }
+    if (type < 0) return 0;
+
+    emit(prog,type,0.0,&word[2],index1,index2);
+    return 1;
+  }
+
+  // variable, any style with a scalar value
+
+  if (strncmp(word,"v_",2) == 0) {
+    if (str[i] == '[') return 0;
+    int ivar = find(&word[2]);
+    if (ivar < 0 || eval_in_progress[ivar]) {
+      compile_retry = 1;
+      return 0;
+    }
+    if (style[ivar] == ATOM || style[ivar] == ATOMFILE) return 0;
+
+    emit(prog,VARIABLE,0.0,&word[2],0,0);
+    return 1;
+  }
+
+  // math function
+
+  if (str[i] == '(') {
+    char *contents;
+    i = find_matching_paren(str,i,contents);
+    i++;
+
+    int flag = compile_function(word,contents,prog);
+    delete [] contents;
+    return flag;
+  }
+
+  // atom value or vector
+
+  if (str[i] == '[' || is_atom_vector(word)) return 0;
+
+  // constant
+
+  if (is_constant(word)) {
+    emit(prog,VALUE,constant(word),NULL,0,0);
+    return 1;
+  }
+
+  // thermo keyword
+
+  if (domain->box_exist == 0) return 0;
+  emit(prog,THERMOKEYWORD,0.0,word,0,0);
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   compile a math function with comma separated args in contents
+   return 1 if successful, 0 if not supported by compiled formulas
+------------------------------------------------------------------------- */
+
+int Variable::compile_function(char *word, char *contents, Program *prog)
+{
+  int ifunc;
+  for (ifunc = 0; compiled_function[ifunc].name; ifunc++)
+    if (strcmp(word,compiled_function[ifunc].name) == 0) break;
+  if (compiled_function[ifunc].name == NULL) return 0;
+
+  char *args[3];
+  int narg = 0;
+  char *ptr = contents;
+  while (1) {
+    if (narg == 3) return 0;
+    args[narg++] = ptr;
+    ptr = find_next_comma(ptr);
+    if (ptr == NULL) break;
+    *ptr++ = '\0';
+  }
+  if (narg != compiled_function[ifunc].narg) return 0;
+
+  for (int iarg = 0; iarg < narg; iarg++)
+    if (!compile(args[iarg],prog)) return 0;
+
+  emit(prog,compiled_function[ifunc].type,0.0,NULL,0,0);
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   append one instruction to prog and track the stack depth
+------------------------------------------------------------------------- */
+
+void Variable::emit(Program *prog, int type, double value, char *id,
+                    int index1, int index2)
+{
+  if (prog->n == prog->nmax) {
+    prog->nmax += 16;
+    prog->code = (Instruction *)
+      memory->srealloc(prog->code,prog->nmax*sizeof(Instruction),
+                       "var:program");
+  }
+
+  Instruction *ins = &prog->code[prog->n++];
+  ins->type = type;
+  ins->value = value;
+  ins->index1 = index1;
+  ins->index2 = index2;
+  ins->icache = -1;
+  ins->id = NULL;
+  if (id) {
+    ins->id = new char[strlen(id)+1];
+    strcpy(ins->id,id);
+  }
+
+  prog->depth += 1 - noperand(type);
+  prog->maxdepth = MAX(prog->maxdepth,prog->depth);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Variable::free_program(Program *prog)
+{
+  for (int k = 0; k < prog->n; k++) delete [] prog->code[k].id;
+  memory->sfree(prog->code);
+  prog->code = NULL;
+  prog->n = prog->nmax = 0;
+  prog->depth = prog->maxdepth = 0;
+}
+
+/* ----------------------------------------------------------------------
+   evaluate a compiled equal-style formula
+   performs the same checks and raises the same errors as evaluate()
+------------------------------------------------------------------------- */
+
+double Variable::eval_program(Program *prog)
+{
+  double stack[MAXSTACK];
+  int nstack = 0;
+
+  for (int k = 0; k < prog->n; k++) {
+    Instruction *ins = &prog->code[k];
+
+    switch (ins->type) {
+    case VALUE:
+      stack[nstack++] = ins->value;
+      break;
+    case COMPUTESCALAR:
+    case COMPUTEVECTOR:
+    case COMPUTEARRAY:
+      stack[nstack++] = eval_compute(ins);
+      break;
+    case FIXSCALAR:
+    case FIXVECTOR:
+    case FIXARRAY:
+      stack[nstack++] = eval_fix(ins);
+      break;
+    case VARIABLE:
+      stack[nstack++] = eval_variable(ins);
+      break;
+    case THERMOKEYWORD:
+      if (output->thermo->evaluate_keyword(ins->id,&stack[nstack]))
+        error->all(FLERR,"Invalid thermo keyword in variable formula");
+      nstack++;
+      break;
+    default: {
+      if (update->whichflag == 0) {
+        if (ins->type == RAMP)
+          error->all(FLERR,"Cannot use ramp in variable formula between runs");
+        if (ins->type == VDISPLACE)
+          error->all(FLERR,
+                     "Cannot use vdisplace in variable formula between runs");
+        if (ins->type == SWIGGLE)
+          error->all(FLERR,
+                     "Cannot use swiggle in variable formula between runs");
+        if (ins->type == CWIGGLE)
+          error->all(FLERR,
+                     "Cannot use cwiggle in variable formula between runs");
+      }
+      int narg = noperand(ins->type);
+      nstack -= narg;
+      stack[nstack] = math_op(ins->type,stack[nstack],
+                              narg > 1 ? stack[nstack+1] : 0.0,
+                              narg > 2 ? stack[nstack+2] : 0.0,1);
+      nstack++;
+    }
+    }
+  }
+
+  return stack[0];
+}
+
+/* ----------------------------------------------------------------------
+   value of a global compute referenced by a compiled formula
+------------------------------------------------------------------------- */
+
+double Variable::eval_compute(Instruction *ins)
+{
+  int icompute = ins->icache;
+  if (icompute < 0 || icompute >= modify->ncompute ||
+      strcmp(modify->compute[icompute]->id,ins->id) != 0) {
+    icompute = modify->find_compute(ins->id);
+    if (icompute < 0)
+      error->all(FLERR,"Invalid compute ID in variable formula");
+    ins->icache = icompute;
+  }
+  Compute *compute = modify->compute[icompute];
+
+  if (ins->type == COMPUTESCALAR) {
+    if (!compute->scalar_flag)
+      error->all(FLERR,"Mismatched compute in variable formula");
+    if (update->whichflag == 0) {
+      if (compute->invoked_scalar != update->ntimestep)
+        error->all(FLERR,"Compute used in variable between runs "
+                   "is not current");
+    } else if (!(compute->invoked_flag & INVOKED_SCALAR)) {
+      compute->compute_scalar();
+      compute->invoked_flag |= INVOKED_SCALAR;
+    }
+    return compute->scalar;
+  }
+
+  if (ins->type == COMPUTEVECTOR) {
+    if (!compute->vector_flag)
+      error->all(FLERR,"Mismatched compute in variable formula");
+    if (ins->index1 > compute->size_vector)
+      error->all(FLERR,"Variable formula compute vector "
+                 "is accessed out-of-range");
+    if (update->whichflag == 0) {
+      if (compute->invoked_vector != update->ntimestep)
+        error->all(FLERR,"Compute used in variable between runs "
+                   "is not current");
+    } else if (!(compute->invoked_flag & INVOKED_VECTOR)) {
+      compute->compute_vector();
+      compute->invoked_flag |= INVOKED_VECTOR;
+    }
+    return compute->vector[ins->index1-1];
+  }
+
+  if (!compute->array_flag)
+    error->all(FLERR,"Mismatched compute in variable formula");
+  if (ins->index1 > compute->size_array_rows)
+    error->all(FLERR,"Variable formula compute array "
+               "is accessed out-of-range");
+  if (ins->index2 > compute->size_array_cols)
+    error->all(FLERR,"Variable formula compute array "
+               "is accessed out-of-range");
+  if (update->whichflag == 0) {
+    if (compute->invoked_array != update->ntimestep)
+      error->all(FLERR,"Compute used in variable between runs "
+                 "is not current");
+  } else if (!(compute->invoked_flag & INVOKED_ARRAY)) {
+    compute->compute_array();
+    compute->invoked_flag |= INVOKED_ARRAY;
+  }
+  return compute->array[ins->index1-1][ins->index2-1];
+}
+
+/* ----------------------------------------------------------------------
+   value of a global fix referenced by a compiled formula
+------------------------------------------------------------------------- */
+
+double Variable::eval_fix(Instruction *ins)
+{
+  int ifix = ins->icache;
+  if (ifix < 0 || ifix >= modify->nfix ||
+      strcmp(modify->fix[ifix]->id,ins->id) != 0) {
+    ifix = modify->find_fix(ins->id);
+    if (ifix < 0) error->all(FLERR,"Invalid fix ID in variable formula");
+    ins->icache = ifix;
+  }
+  Fix *fix = modify->fix[ifix];
+
+  if (ins->type == FIXSCALAR) {
+    if (!fix->scalar_flag)
+      error->all(FLERR,"Mismatched fix in variable formula");
+    if (update->whichflag > 0 && update->ntimestep % fix->global_freq)
+      error->all(FLERR,"Fix in variable not computed at compatible time");
+    return fix->compute_scalar();
+  }
+
+  if (ins->type == FIXVECTOR) {
+    if (!fix->vector_flag)
+      error->all(FLERR,"Mismatched fix in variable formula");
+    if (ins->index1 > fix->size_vector)
+      error->all(FLERR,"Variable formula fix vector is accessed out-of-range");
+    if (update->whichflag > 0 && update->ntimestep % fix->global_freq)
+      error->all(FLERR,"Fix in variable not computed at compatible time");
+    return fix->compute_vector(ins->index1-1);
+  }
+
+  if (!fix->array_flag)
+    error->all(FLERR,"Mismatched fix in variable formula");
+  if (ins->index1 > fix->size_array_rows)
+    error->all(FLERR,"Variable formula fix array is accessed out-of-range");
+  if (ins->index2 > fix->size_array_cols)
+    error->all(FLERR,"Variable formula fix array is accessed out-of-range");
+  if (update->whichflag > 0 && update->ntimestep % fix->global_freq)
+    error->all(FLERR,"Fix in variable not computed at compatible time");
+  return fix->compute_array(ins->index1-1,ins->index2-1);
+}
+
+/* ----------------------------------------------------------------------
+   value of a variable referenced by a compiled formula
+   via retrieve(), so values are identical to those of evaluate()
+------------------------------------------------------------------------- */
+
+double Variable::eval_variable(Instruction *ins)
+{
+  int ivar = ins->icache;
+  if (ivar < 0 || ivar >= nvar || strcmp(names[ivar],ins->id) != 0) {
+    ivar = find(ins->id);
+    if (ivar < 0)
+      error->all(FLERR,"Invalid variable name in variable formula");
+    ins->icache = ivar;
+  }
+  if (eval_in_progress[ivar])
+    error->all(FLERR,"Variable has circular dependency");
+  if (style[ivar] == ATOM || style[ivar] == ATOMFILE)
+    error->all(FLERR,"Atom-style variable in equal-style variable formula");
+
+  char *var = retrieve(ins->id);
+  if (var == NULL)
+    error->all(FLERR,"Invalid variable evaluation in variable formula");
+  return atof(var);
+}
+
+/* ----------------------------------------------------------------------
+   apply operator or math function of given type to evaluated args
+   used by eval_program() and eval_tree_chunk()
+   errors are raised via error->all() if allflag is set, else error->one()
+------------------------------------------------------------------------- */
+
+double Variable::math_op(int type, double arg1, double arg2, double arg3,
+                         int allflag)
+{
+  double delta,omega;
+  int ivalue1,ivalue2,ivalue3,lower,multiple;
+
+  switch (type) {
+  case ADD: return arg1 + arg2;
+  case SUBTRACT: return arg1 - arg2;
+  case MULTIPLY: return arg1 * arg2;
+  case DIVIDE:
+    if (arg2 == 0.0) math_error("Divide by 0 in variable formula",allflag);
+    return arg1 / arg2;
+  case MODULO:
+    if (arg2 == 0.0) math_error("Modulo 0 in variable formula",allflag);
+    return fmod(arg1,arg2);
+  case CARAT:
+    if (arg2 == 0.0) math_error("Power by 0 in variable formula",allflag);
+    return pow(arg1,arg2);
+  case UNARY: return -arg1;
+  case NOT: return (arg1 == 0.0) ? 1.0 : 0.0;
+  case EQ: return (arg1 == arg2) ? 1.0 : 0.0;
+  case NE: return (arg1 != arg2) ? 1.0 : 0.0;
+  case LT: return (arg1 < arg2) ? 1.0 : 0.0;
+  case LE: return (arg1 <= arg2) ? 1.0 : 0.0;
+  case GT: return (arg1 > arg2) ? 1.0 : 0.0;
+  case GE: return (arg1 >= arg2) ? 1.0 : 0.0;
+  case AND: return (arg1 != 0.0 && arg2 != 0.0) ? 1.0 : 0.0;
+  case OR: return (arg1 != 0.0 || arg2 != 0.0) ? 1.0 : 0.0;
+
+  case SQRT:
+    if (arg1 < 0.0)
+      math_error("Sqrt of negative value in variable formula",allflag);
+    return sqrt(arg1);
+  case CBRT: return cbrt(arg1);
+  case EXP: return exp(arg1);
+  case LN:
+    if (arg1 <= 0.0)
+      math_error("Log of zero/negative value in variable formula",allflag);
+    return log(arg1);
+  case LOG:
+    if (arg1 <= 0.0)
+      math_error("Log of zero/negative value in variable formula",allflag);
+    return log10(arg1);
+  case ABS: return fabs(arg1);
+  case SIN: return sin(arg1);
+  case COS: return cos(arg1);
+  case TAN: return tan(arg1);
+  case ASIN:
+    if (arg1 < -1.0 || arg1 > 1.0)
+      math_error("Arcsin of invalid value in variable formula",allflag);
+    return asin(arg1);
+  case ACOS:
+    if (arg1 < -1.0 || arg1 > 1.0)
+      math_error("Arccos of invalid value in variable formula",allflag);
+    return acos(arg1);
+  case ATAN: return atan(arg1);
+  case ATAN2: return atan2(arg1,arg2);
+  case CEIL: return ceil(arg1);
+  case FLOOR: return floor(arg1);
+  case ROUND: return MYROUND(arg1);
+
+  case RAMP:
+    delta = update->ntimestep - update->beginstep;
+    if (delta != 0.0) delta /= update->endstep - update->beginstep;
+    return arg1 + delta*(arg2-arg1);
+
+  case STAGGER:
+    ivalue1 = static_cast<int> (arg1);
+    ivalue2 = static_cast<int> (arg2);
+    if (ivalue1 <= 0 || ivalue2 <= 0 || ivalue1 <= ivalue2)
+      math_error("Invalid math function in variable formula",allflag);
+    lower = update->ntimestep/ivalue1 * ivalue1;
+    if (update->ntimestep - lower < ivalue2) return lower+ivalue2;
+    return lower+ivalue1;
+
+  case LOGFREQ:
+    ivalue1 = static_cast<int> (arg1);
+    ivalue2 = static_cast<int> (arg2);
+    ivalue3 = static_cast<int> (arg3);
+    if (ivalue1 <= 0 || ivalue2 <= 0 || ivalue3 <= 0 || ivalue2 >= ivalue3)
+      math_error("Invalid math function in variable formula",allflag);
+    if (update->ntimestep < ivalue1) return ivalue1;
+    lower = ivalue1;
+    while (update->ntimestep >= ivalue3*lower) lower *= ivalue3;
+    multiple = update->ntimestep/lower;
+    if (multiple < ivalue2) return (multiple+1)*lower;
+    return lower*ivalue3;
+
+  case STRIDE:
+    ivalue1 = static_cast<int> (arg1);
+    ivalue2 = static_cast<int> (arg2);
+    ivalue3 = static_cast<int> (arg3);
+    if (ivalue1 < 0 || ivalue2 < 0 || ivalue3 <= 0 || ivalue1 > ivalue2)
+      error->one(FLERR,"Invalid math function in variable formula");
+    if (update->ntimestep < ivalue1) return ivalue1;
+    if (update->ntimestep < ivalue2) {
+      int offset = update->ntimestep - ivalue1;
+      double value = ivalue1 + (offset/ivalue3)*ivalue3 + ivalue3;
+      if (value > ivalue2) value = 9.0e18;
+      return value;
+    }
+    return 9.0e18;
+
+  case VDISPLACE:
+    delta = update->ntimestep - update->beginstep;
+    return arg1 + arg2*delta*update->dt;
+
+  case SWIGGLE:
+    if (arg3 == 0.0)
+      math_error("Invalid math function in variable formula",allflag);
+    delta = update->ntimestep - update->beginstep;
+    omega = 2.0*MY_PI/arg3;
+    return arg1 + arg2*sin(omega*delta*update->dt);
+
+  case CWIGGLE:
+    if (arg3 == 0.0)
+      math_error("Invalid math function in variable formula",allflag);
+    delta = update->ntimestep - update->beginstep;
+    omega = 2.0*MY_PI/arg3;
+    return arg1 + arg2*(1.0-cos(omega*delta*update->dt));
+  }
+
+  return 0.0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Variable::math_error(const char *str, int allflag)
+{
+  if (allflag) error->all(FLERR,str);
+  else error->one(FLERR,str);
+}
+
 /* ----------------------------------------------------------------------
    find matching parenthesis in str, allocate contents = str between parens
    i = left paren
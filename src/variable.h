@@ -70,6 +70,26 @@ class Variable : protected Pointers {
     Tree *left,*middle,*right;    // ptrs further down tree
   };
 
+  struct Instruction {     // one step of a compiled equal-style formula
+    int type;              // operation, see enum{} in variable.cpp
+    double value;          // constant for VALUE
+    int index1,index2;     // vector/array indices of compute or fix
+    int icache;            // last index of compute/fix/variable, or -1
+    char *id;              // compute/fix ID, variable name, thermo keyword
+  };
+
+  struct Program {         // postfix form of an equal-style formula
+    int n,nmax;            // # of instructions, allocated length
+    int depth,maxdepth;    // stack depth at end of code, max stack depth
+    Instruction *code;
+  };
+
+  Program *program;        // compiled formula of each equal-style variable
+  int *compiled;           // 0 = not yet compiled, 1 = evaluate program,
+                           // -1 = formula not compilable, use evaluate()
+  int compile_retry;       // 1 if compile failed on a reference that may
+                           // resolve later, e.g. a compute not yet defined
+
   void remove(int);
   void grow();
   void copy(int, char **, char **);
@@ -77,6 +97,21 @@ class Variable : protected Pointers {
   double collapse_tree(Tree *);
   double eval_tree(Tree *, int);
   void free_tree(Tree *);
+  int chunkable_tree(Tree *);
+  int raises_tree(Tree *);
+  int flatten_tree(Tree *, Tree **, int &);
+  void eval_tree_chunk(Tree **, int, int *, int, double *);
+  int compile(char *, Program *);
+  int compile_word(char *, char *, int &, Program *);
+  int compile_function(char *, char *, Program *);
+  void emit(Program *, int, double, char *, int, int);
+  void free_program(Program *);
+  double eval_program(Program *);
+  double eval_compute(Instruction *);
+  double eval_fix(Instruction *);
+  double eval_variable(Instruction *);
+  double math_op(int, double, double, double, int);
+  void math_error(const char *, int);
   int find_matching_paren(char *, int, char *&);
   int math_function(char *, char *, Tree **, Tree **, int &, double *, int &);
   int group_function(char *, char *, Tree **, Tree **, int &, double *, int &);
@@ -235,6 +235,8 @@ void Verlet::run(int n)
 
     ntimestep = ++update->ntimestep;
     ev_set(ntimestep);
+    timer->trace_step(ntimestep);
+    timer->trace_begin("step");
 
     // initial time integration
 
@@ -247,7 +249,9 @@ void Verlet::run(int n)
 
     if (nflag == 0) {
       timer->stamp();
+      timer->trace_begin("forward_comm");
       comm->forward_comm();
+      timer->trace_end("forward_comm");
       timer->stamp(TIME_COMM);
     } else {
       if (n_pre_exchange) modify->pre_exchange();
@@ -260,21 +264,29 @@ void Verlet::run(int n)
         if (neighbor->style) neighbor->setup_bins();
       }
       timer->stamp();
+      timer->trace_begin("exchange");
       comm->exchange();
+      timer->trace_end("exchange");
 
       // periodically sort particle data
       // if atoms have moved, we need to enforce sorting to update partitions
       if (sortflag && (atom->dirty || ntimestep >= atom->nextsort)) {
         // don't count sorting as part of Comm time -> this will become part of Other
         timer->stamp(TIME_COMM);
+        timer->trace_begin("sort");
         atom->sort();
+        timer->trace_end("sort");
         timer->stamp();
       }
+      timer->trace_begin("borders");
       comm->borders();
+      timer->trace_end("borders");
       if (triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
       timer->stamp(TIME_COMM);
       if (n_pre_neighbor) modify->pre_neighbor();
+      timer->trace_begin("neighbor");
       neighbor->build();
+      timer->trace_end("neighbor");
       timer->stamp(TIME_NEIGHBOR);
     }
 
@@ -289,7 +301,9 @@ void Verlet::run(int n)
     timer->stamp();
 
     if (pair_compute_flag) {
+      timer->trace_begin("pair");
       force->pair->compute(eflag,vflag);
+      timer->trace_end("pair");
       timer->stamp(TIME_PAIR);
     }
 
@@ -302,13 +316,17 @@ void Verlet::run(int n)
     }
 
     if (kspace_compute_flag) {
+      timer->trace_begin("kspace");
       force->kspace->compute(eflag,vflag);
+      timer->trace_end("kspace");
       timer->stamp(TIME_KSPACE);
     }
 
     // reverse communication of forces
     if (force->newton) {
+      timer->trace_begin("reverse_comm");
       comm->reverse_comm();
+      timer->trace_end("reverse_comm");
       timer->stamp(TIME_COMM);
     }
 
@@ -320,9 +338,13 @@ void Verlet::run(int n)
     // all output
     if (ntimestep == output->next) {
       timer->stamp();
+      timer->trace_begin("output");
       output->write(ntimestep);
+      timer->trace_end("output");
       timer->stamp(TIME_OUTPUT);
     }
+
+    timer->trace_end("step");
   }
 }
 